@@ -0,0 +1,95 @@
+// BoxBvh builders: binned SAH vs. the parallel Morton-code LBVH, plus the ray
+// cost of each tree and of refit as the alternative to rebuilding.
+//
+//   cmake -S engine/wasm -B build -DGEOMETRY_BUILD_BENCHMARKS=ON -DGEOMETRY_NATIVE_ARCH=ON
+//   cmake --build build && ./build/bench_bvh
+#include <Eigen/Geometry>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench_util.h"
+#include "bvh.h"
+#include "lbvh.h"
+#include "parallel.h"
+
+namespace {
+
+// Planar min/max boxes scattered through a cube whose side grows with the count,
+// so density (and hits per ray) stays roughly constant.
+std::vector<float> random_boxes(size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  const float side = std::cbrt((float)count) * 4.0f;
+  std::uniform_real_distribution<float> pos(-side, side);
+  std::uniform_real_distribution<float> size(0.2f, 2.0f);
+  std::vector<float> boxes(count * 6);
+  for (size_t i = 0; i < count; i++) {
+    for (size_t axis = 0; axis < 3; axis++) {
+      const float center = pos(rng);
+      const float half = size(rng);
+      boxes[axis * count + i] = center - half;
+      boxes[(axis + 3) * count + i] = center + half;
+    }
+  }
+  return boxes;
+}
+
+std::vector<Eigen::ParametrizedLine<float, 3>> random_rays(size_t count, float side, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> pos(-side, side);
+  std::normal_distribution<float> dir(0.0f, 1.0f);
+  std::vector<Eigen::ParametrizedLine<float, 3>> rays;
+  rays.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    const Eigen::Vector3f d = Eigen::Vector3f(dir(rng), dir(rng), dir(rng)).normalized();
+    rays.emplace_back(Eigen::Vector3f(pos(rng), pos(rng), pos(rng)), d);
+  }
+  return rays;
+}
+
+double ray_ms(const BoxBvh& bvh, const std::vector<Eigen::ParametrizedLine<float, 3>>& rays, size_t* hits) {
+  return bench::best_ms(3, [&] {
+    *hits = 0;
+    for (const auto& ray : rays) {
+      *hits += bvh.raycast(ray, 1e30f) ? 1 : 0;
+    }
+  });
+}
+
+void bench_build(size_t count) {
+  const std::vector<float> boxes = random_boxes(count, 1);
+  const ConstBoxSoA soa = box_soa_planar(boxes.data(), count);
+  const int reps = count >= 1000000 ? 3 : 10;
+
+  BoxBvh sah;
+  BoxBvh lbvh;
+  const double sahMs = bench::best_ms(reps, [&] { sah.build(soa, count); });
+  const double lbvhMs = bench::best_ms(reps, [&] { lbvh = build_lbvh(soa, count); });
+  const double refitMs = bench::best_ms(reps, [&] { lbvh.refit(soa); });
+
+  const std::vector<Eigen::ParametrizedLine<float, 3>> rays =
+      random_rays(100000, std::cbrt((float)count) * 4.0f, 2);
+  size_t sahHits = 0;
+  size_t lbvhHits = 0;
+  const double sahRayMs = ray_ms(sah, rays, &sahHits);
+  const double lbvhRayMs = ray_ms(lbvh, rays, &lbvhHits);
+
+  std::printf("%zu boxes (%zu / %zu nodes SAH / LBVH)\n", count, sah.nodes().size(), lbvh.nodes().size());
+  bench::report("BoxBvh::build (SAH)", count, sahMs);
+  bench::report("build_lbvh", count, lbvhMs);
+  bench::report("BoxBvh::refit", count, refitMs);
+  bench::report("100k rays, SAH tree", rays.size(), sahRayMs);
+  bench::report("100k rays, LBVH tree", rays.size(), lbvhRayMs);
+  std::printf("  build speedup %.2fx, ray cost LBVH / SAH %.2fx%s\n", sahMs / lbvhMs, lbvhRayMs / sahRayMs,
+              sahHits == lbvhHits ? "" : "  (hit counts differ!)");
+}
+
+}  // namespace
+
+int main() {
+  std::printf("parallel::thread_count() = %zu\n", parallel::thread_count());
+  for (size_t count : {10000u, 100000u, 1000000u}) {
+    bench_build(count);
+  }
+  return 0;
+}
@@ -0,0 +1,163 @@
+// Batched SoA quaternion kernels vs. looping Eigen's scalar Quaternion API.
+//
+//   cmake -S engine/wasm -B build -DGEOMETRY_BUILD_BENCHMARKS=ON -DGEOMETRY_NATIVE_ARCH=ON
+//   cmake --build build && ./build/bench_quat
+#include <Eigen/Geometry>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "bench_util.h"
+#include "quat_batch.h"
+#include "simd.h"
+
+namespace {
+
+struct SoA {
+  std::vector<float> x, y, z, w;
+
+  explicit SoA(const std::vector<float>& interleaved)
+      : x(interleaved.size() / 4), y(x.size()), z(x.size()), w(x.size()) {
+    for (size_t i = 0; i < x.size(); i++) {
+      x[i] = interleaved[i * 4 + 0];
+      y[i] = interleaved[i * 4 + 1];
+      z[i] = interleaved[i * 4 + 2];
+      w[i] = interleaved[i * 4 + 3];
+    }
+  }
+
+  QuatSoA view() { return QuatSoA{x.data(), y.data(), z.data(), w.data()}; }
+};
+
+void bench_multiply(size_t count) {
+  const std::vector<float> qa = bench::random_unit_quats(count, 1);
+  const std::vector<float> qb = bench::random_unit_quats(count, 2);
+
+  // Eigen stores coefficients as x, y, z, w, so the interleaved buffers map directly.
+  std::vector<Eigen::Quaternionf> ea(count), eb(count), eo(count);
+  for (size_t i = 0; i < count; i++) {
+    ea[i] = Eigen::Quaternionf(Eigen::Map<const Eigen::Vector4f>(&qa[i * 4]));
+    eb[i] = Eigen::Quaternionf(Eigen::Map<const Eigen::Vector4f>(&qb[i * 4]));
+  }
+  SoA sa(qa), sb(qb), so(qa);
+
+  const int reps = count >= 1000000 ? 10 : 200;
+  const double eigenMs = bench::best_ms(reps, [&] {
+    for (size_t i = 0; i < count; i++) {
+      eo[i] = ea[i] * eb[i];
+    }
+    bench::consume(eo.data());
+  });
+  const double batchMs = bench::best_ms(reps, [&] {
+    quat_multiply_batch(sa.view(), sb.view(), so.view(), count);
+    bench::consume(so.x.data());
+  });
+
+  SoA si(qa);
+  const double inPlaceMs = bench::best_ms(reps, [&] {
+    quat_multiply_batch(si.view(), sb.view(), si.view(), count);
+    bench::consume(si.x.data());
+  });
+
+  float maxErr = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    const float d[4] = {so.x[i] - eo[i].x(), so.y[i] - eo[i].y(), so.z[i] - eo[i].z(), so.w[i] - eo[i].w()};
+    for (float v : d) {
+      maxErr = std::max(maxErr, std::abs(v));
+    }
+  }
+
+  std::printf("quat multiply, %zu quaternions (max |diff| %.2e)\n", count, maxErr);
+  bench::report("Eigen Quaternionf::operator*", count, eigenMs);
+  bench::report("quat_multiply_batch", count, batchMs);
+  bench::report("quat_multiply_batch (in place)", count, inPlaceMs);
+  std::printf("  speedup %.2fx\n", eigenMs / batchMs);
+}
+
+// Double-precision slerp along the shorter arc, the accuracy reference.
+void reference_slerp(const float* a, const float* b, double t, double* out) {
+  double d = 0.0;
+  for (int k = 0; k < 4; k++) {
+    d += (double)a[k] * b[k];
+  }
+  const double absD = std::abs(d);
+  double s0 = 1.0 - t, s1 = t;
+  if (absD < 1.0 - 1e-12) {
+    const double theta = std::acos(absD);
+    s0 = std::sin((1.0 - t) * theta) / std::sin(theta);
+    s1 = std::sin(t * theta) / std::sin(theta);
+  }
+  if (d < 0.0) {
+    s1 = -s1;
+  }
+  for (int k = 0; k < 4; k++) {
+    out[k] = s0 * a[k] + s1 * b[k];
+  }
+}
+
+void bench_interpolate(size_t count) {
+  const std::vector<float> qa = bench::random_unit_quats(count, 3);
+  const std::vector<float> qb = bench::random_unit_quats(count, 4);
+  std::vector<float> t(count);
+  for (size_t i = 0; i < count; i++) {
+    t[i] = (float)((i * 7919) % 1001) / 1000.0f;
+  }
+
+  std::vector<Eigen::Quaternionf> ea(count), eb(count), eo(count);
+  for (size_t i = 0; i < count; i++) {
+    ea[i] = Eigen::Quaternionf(Eigen::Map<const Eigen::Vector4f>(&qa[i * 4]));
+    eb[i] = Eigen::Quaternionf(Eigen::Map<const Eigen::Vector4f>(&qb[i * 4]));
+  }
+  SoA sa(qa), sb(qb), slerpOut(qa), nlerpOut(qa);
+
+  const int reps = count >= 1000000 ? 10 : 200;
+  const double eigenMs = bench::best_ms(reps, [&] {
+    for (size_t i = 0; i < count; i++) {
+      eo[i] = ea[i].slerp(t[i], eb[i]);
+    }
+    bench::consume(eo.data());
+  });
+  const double slerpMs = bench::best_ms(reps, [&] {
+    quat_slerp_batch(sa.view(), sb.view(), t.data(), slerpOut.view(), count);
+    bench::consume(slerpOut.x.data());
+  });
+  const double nlerpMs = bench::best_ms(reps, [&] {
+    quat_nlerp_batch(sa.view(), sb.view(), t.data(), nlerpOut.view(), count);
+    bench::consume(nlerpOut.x.data());
+  });
+
+  double slerpErr = 0.0, eigenErr = 0.0, nlerpDev = 0.0;
+  for (size_t i = 0; i < count; i++) {
+    double ref[4];
+    reference_slerp(&qa[i * 4], &qb[i * 4], t[i], ref);
+    const float batch[4] = {slerpOut.x[i], slerpOut.y[i], slerpOut.z[i], slerpOut.w[i]};
+    const float nl[4] = {nlerpOut.x[i], nlerpOut.y[i], nlerpOut.z[i], nlerpOut.w[i]};
+    for (int k = 0; k < 4; k++) {
+      slerpErr = std::max(slerpErr, std::abs(batch[k] - ref[k]));
+      eigenErr = std::max(eigenErr, std::abs(eo[i].coeffs()[k] - ref[k]));
+      nlerpDev = std::max(nlerpDev, std::abs(nl[k] - ref[k]));
+    }
+  }
+
+  std::printf("quat slerp, %zu pairs, per-pair t\n", count);
+  std::printf("  max |err| vs double: Eigen %.2e, batch slerp %.2e, nlerp deviation %.2e\n", eigenErr, slerpErr, nlerpDev);
+  bench::report("Eigen Quaternionf::slerp", count, eigenMs);
+  bench::report("quat_slerp_batch", count, slerpMs);
+  bench::report("quat_nlerp_batch", count, nlerpMs);
+  std::printf("  speedup slerp %.2fx, nlerp %.2fx\n", eigenMs / slerpMs, eigenMs / nlerpMs);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("simd::kWidth = %zu\n", simd::kWidth);
+  // L1-resident, L2-resident and DRAM-sized batches; the last one is bandwidth bound
+  // for both implementations.
+  for (size_t count : {1024u, 16384u, 1000000u}) {
+    bench_multiply(count);
+  }
+  for (size_t count : {1024u, 16384u, 1000000u}) {
+    bench_interpolate(count);
+  }
+  return 0;
+}
@@ -0,0 +1,140 @@
+// Batched AngleAxis / Quaternion / Matrix3 conversions vs. looping Eigen's
+// per-element conversions (AngleAxisf, Quaternionf, Matrix3f).
+//
+//   cmake -S engine/wasm -B build -DGEOMETRY_BUILD_BENCHMARKS=ON -DGEOMETRY_NATIVE_ARCH=ON
+//   cmake --build build && ./build/bench_rotation
+#include <Eigen/Geometry>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "bench_util.h"
+#include "rotation_batch.h"
+#include "simd.h"
+
+namespace {
+
+// One rotation set in all three representations, both as Eigen objects and as
+// planar blocks.
+struct Rotations {
+  size_t count;
+  std::vector<Eigen::Quaternionf> quat;
+  std::vector<Eigen::AngleAxisf> angleAxis;
+  std::vector<Eigen::Matrix3f> matrix;
+  std::vector<float> quatBlock, angleAxisBlock, matrixBlock;
+
+  explicit Rotations(size_t n) : count(n), quat(n), angleAxis(n), matrix(n), quatBlock(n * 4), angleAxisBlock(n * 4), matrixBlock(n * 9) {
+    const std::vector<float> q = bench::random_unit_quats(n, 5);
+    for (size_t i = 0; i < n; i++) {
+      quat[i] = Eigen::Quaternionf(Eigen::Map<const Eigen::Vector4f>(&q[i * 4]));
+      angleAxis[i] = Eigen::AngleAxisf(quat[i]);
+      matrix[i] = quat[i].toRotationMatrix();
+      for (int k = 0; k < 4; k++) {
+        quatBlock[k * n + i] = quat[i].coeffs()[k];
+      }
+      for (int k = 0; k < 3; k++) {
+        angleAxisBlock[k * n + i] = angleAxis[i].axis()[k];
+      }
+      angleAxisBlock[3 * n + i] = angleAxis[i].angle();
+      for (int k = 0; k < 9; k++) {
+        matrixBlock[k * n + i] = matrix[i].data()[k];
+      }
+    }
+  }
+};
+
+// Largest coefficient difference between an Eigen result and a planar block.
+float max_diff(const std::vector<Eigen::Quaternionf>& e, const std::vector<float>& block, size_t n) {
+  float err = 0.0f;
+  for (size_t i = 0; i < n; i++) {
+    for (int k = 0; k < 4; k++) {
+      err = std::max(err, std::abs(e[i].coeffs()[k] - block[k * n + i]));
+    }
+  }
+  return err;
+}
+
+float max_diff(const std::vector<Eigen::AngleAxisf>& e, const std::vector<float>& block, size_t n) {
+  float err = 0.0f;
+  for (size_t i = 0; i < n; i++) {
+    for (int k = 0; k < 3; k++) {
+      err = std::max(err, std::abs(e[i].axis()[k] - block[k * n + i]));
+    }
+    err = std::max(err, std::abs(e[i].angle() - block[3 * n + i]));
+  }
+  return err;
+}
+
+float max_diff(const std::vector<Eigen::Matrix3f>& e, const std::vector<float>& block, size_t n) {
+  float err = 0.0f;
+  for (size_t i = 0; i < n; i++) {
+    for (int k = 0; k < 9; k++) {
+      err = std::max(err, std::abs(e[i].data()[k] - block[k * n + i]));
+    }
+  }
+  return err;
+}
+
+// Times Eigen's per-element conversion `convert(in[i])` against
+// convert_rotation_batch for one direction.
+template <typename In, typename Out, typename Convert>
+void bench_direction(const char* name,
+                     const std::vector<In>& in,
+                     const std::vector<float>& inBlock,
+                     RotationFormat from,
+                     RotationFormat to,
+                     Convert convert) {
+  const size_t count = in.size();
+  std::vector<Out> eigenOut(count);
+  std::vector<float> batchOut(count * rotation_format_floats(to));
+
+  const int reps = count >= 1000000 ? 10 : 200;
+  const double eigenMs = bench::best_ms(reps, [&] {
+    for (size_t i = 0; i < count; i++) {
+      eigenOut[i] = convert(in[i]);
+    }
+    bench::consume(eigenOut.data());
+  });
+  const double batchMs = bench::best_ms(reps, [&] {
+    convert_rotation_batch(from, to, inBlock.data(), batchOut.data(), count);
+    bench::consume(batchOut.data());
+  });
+
+  std::printf("%s, %zu rotations (max |diff| vs Eigen %.2e)\n", name, count, max_diff(eigenOut, batchOut, count));
+  bench::report("Eigen", count, eigenMs);
+  bench::report("convert_rotation_batch", count, batchMs);
+  std::printf("  speedup %.2fx\n", eigenMs / batchMs);
+}
+
+void bench_all(size_t count) {
+  const Rotations r(count);
+  typedef RotationFormat F;
+  bench_direction<Eigen::AngleAxisf, Eigen::Quaternionf>(
+      "AngleAxis -> Quaternion", r.angleAxis, r.angleAxisBlock, F::AngleAxis, F::Quaternion,
+      [](const Eigen::AngleAxisf& a) { return Eigen::Quaternionf(a); });
+  bench_direction<Eigen::Quaternionf, Eigen::AngleAxisf>(
+      "Quaternion -> AngleAxis", r.quat, r.quatBlock, F::Quaternion, F::AngleAxis,
+      [](const Eigen::Quaternionf& q) { return Eigen::AngleAxisf(q); });
+  bench_direction<Eigen::Quaternionf, Eigen::Matrix3f>(
+      "Quaternion -> Matrix3", r.quat, r.quatBlock, F::Quaternion, F::Matrix3,
+      [](const Eigen::Quaternionf& q) { return q.toRotationMatrix(); });
+  bench_direction<Eigen::Matrix3f, Eigen::Quaternionf>(
+      "Matrix3 -> Quaternion", r.matrix, r.matrixBlock, F::Matrix3, F::Quaternion,
+      [](const Eigen::Matrix3f& m) { return Eigen::Quaternionf(m); });
+  bench_direction<Eigen::AngleAxisf, Eigen::Matrix3f>(
+      "AngleAxis -> Matrix3", r.angleAxis, r.angleAxisBlock, F::AngleAxis, F::Matrix3,
+      [](const Eigen::AngleAxisf& a) { return a.toRotationMatrix(); });
+  bench_direction<Eigen::Matrix3f, Eigen::AngleAxisf>(
+      "Matrix3 -> AngleAxis", r.matrix, r.matrixBlock, F::Matrix3, F::AngleAxis,
+      [](const Eigen::Matrix3f& m) { return Eigen::AngleAxisf(m); });
+}
+
+}  // namespace
+
+int main() {
+  std::printf("simd::kWidth = %zu\n", simd::kWidth);
+  for (size_t count : {1024u, 16384u, 1000000u}) {
+    bench_all(count);
+  }
+  return 0;
+}
@@ -0,0 +1,143 @@
+// Skinning on one mesh: skin_dqs vs. skin_lbs, plus a per-vertex loop over the
+// DualQuaternion type (Eigen::Quaternionf products) as the scalar reference.
+//
+//   cmake -S engine/wasm -B build -DGEOMETRY_BUILD_BENCHMARKS=ON -DGEOMETRY_NATIVE_ARCH=ON
+//   cmake --build build && ./build/bench_skinning
+#include <Eigen/Geometry>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench_util.h"
+#include "dual_quat.h"
+#include "simd.h"
+#include "skinning.h"
+
+namespace {
+
+constexpr size_t kBones = 64;
+
+// `vertices` random positions/normals with 4 influences each (weights summing
+// to 1, the last one often 0) over kBones random rigid bones.
+struct Mesh {
+  std::vector<float> positions, normals, weights, boneMatrices, dualQuats;
+  std::vector<uint16_t> indices;
+
+  Mesh(size_t vertices, uint32_t seed)
+      : positions(vertices * 3),
+        normals(vertices * 3),
+        weights(vertices * 4),
+        boneMatrices(kBones * 16),
+        dualQuats(kBones * kDualQuatFloats),
+        indices(vertices * 4) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const std::vector<float> q = bench::random_unit_quats(kBones, seed + 1);
+    for (size_t b = 0; b < kBones; b++) {
+      const Eigen::Affine3f bone = Eigen::Translation3f(dist(rng), dist(rng), dist(rng)) *
+                                   Eigen::Quaternionf(Eigen::Map<const Eigen::Vector4f>(&q[b * 4]));
+      Eigen::Map<Eigen::Matrix4f> m(&boneMatrices[b * 16]);
+      m = bone.matrix();
+    }
+    dual_quats_from_transforms(boneMatrices.data(), kBones, dualQuats.data());
+    for (size_t i = 0; i < vertices; i++) {
+      Eigen::Vector3f n(dist(rng), dist(rng), dist(rng));
+      n.normalize();
+      float sum = 0.0f;
+      for (int k = 0; k < 4; k++) {
+        positions[i * 3 + k % 3] = dist(rng);
+        indices[i * 4 + k] = (uint16_t)(rng() % kBones);
+        weights[i * 4 + k] = k == 3 && i % 2 == 0 ? 0.0f : unit(rng);
+        sum += weights[i * 4 + k];
+      }
+      for (int k = 0; k < 4; k++) {
+        weights[i * 4 + k] /= sum;
+      }
+      for (int c = 0; c < 3; c++) {
+        normals[i * 3 + c] = n[c];
+      }
+    }
+  }
+
+  SkinningInput input() const {
+    return SkinningInput{positions.data(), normals.data(), indices.data(), weights.data(), positions.size() / 3};
+  }
+};
+
+// Per-vertex DualQuaternion blend with the same antipodality rule as skin_dqs.
+void skin_dqs_reference(const Mesh& mesh, const std::vector<DualQuaternion>& bones, float* outP, float* outN) {
+  const size_t count = mesh.positions.size() / 3;
+  for (size_t i = 0; i < count; i++) {
+    const uint16_t* bone = &mesh.indices[i * 4];
+    const float* weight = &mesh.weights[i * 4];
+    int pivot = 0;
+    for (int k = 1; k < 4; k++) {
+      pivot = weight[k] > weight[pivot] ? k : pivot;
+    }
+    DualQuaternion blend(Eigen::Quaternionf(0.0f, 0.0f, 0.0f, 0.0f), Eigen::Quaternionf(0.0f, 0.0f, 0.0f, 0.0f));
+    for (int k = 0; k < 4; k++) {
+      const DualQuaternion& dq = bones[bone[k]];
+      const float w = dq.real.dot(bones[bone[pivot]].real) < 0.0f ? -weight[k] : weight[k];
+      blend.real.coeffs() += w * dq.real.coeffs();
+      blend.dual.coeffs() += w * dq.dual.coeffs();
+    }
+    const DualQuaternion unit = blend.normalized();
+    Eigen::Map<Eigen::Vector3f>(outP + i * 3) =
+        unit.transform_point(Eigen::Map<const Eigen::Vector3f>(&mesh.positions[i * 3]));
+    Eigen::Map<Eigen::Vector3f>(outN + i * 3) = unit.real * Eigen::Map<const Eigen::Vector3f>(&mesh.normals[i * 3]);
+  }
+}
+
+float max_diff(const std::vector<float>& a, const std::vector<float>& b) {
+  float err = 0.0f;
+  for (size_t i = 0; i < a.size(); i++) {
+    err = std::max(err, std::abs(a[i] - b[i]));
+  }
+  return err;
+}
+
+void bench_mesh(size_t vertices) {
+  const Mesh mesh(vertices, 11);
+  const SkinningInput in = mesh.input();
+  std::vector<DualQuaternion> bones(kBones);
+  for (size_t b = 0; b < kBones; b++) {
+    bones[b] = DualQuaternion(Eigen::Affine3f(Eigen::Map<const Eigen::Matrix4f>(&mesh.boneMatrices[b * 16])));
+  }
+  std::vector<float> refP(vertices * 3), refN(vertices * 3), outP(vertices * 3), outN(vertices * 3);
+  std::vector<float> dualQuats(kBones * kDualQuatFloats);
+
+  const int reps = vertices >= 1000000 ? 10 : 100;
+  const double referenceMs = bench::best_ms(reps, [&] {
+    skin_dqs_reference(mesh, bones, refP.data(), refN.data());
+    bench::consume(refP.data());
+  });
+  const double lbsMs = bench::best_ms(reps, [&] {
+    skin_lbs(in, mesh.boneMatrices.data(), outP.data(), outN.data());
+    bench::consume(outP.data());
+  });
+  // Includes the per-frame bone conversion, as the bindings do it.
+  const double dqsMs = bench::best_ms(reps, [&] {
+    dual_quats_from_transforms(mesh.boneMatrices.data(), kBones, dualQuats.data());
+    skin_dqs(in, dualQuats.data(), outP.data(), outN.data());
+    bench::consume(outP.data());
+  });
+
+  std::printf("%zu vertices, %zu bones (skin_dqs max |diff| vs DualQuaternion loop %.2e)\n", vertices, kBones,
+              std::max(max_diff(refP, outP), max_diff(refN, outN)));
+  bench::report("DualQuaternion per vertex", vertices, referenceMs);
+  bench::report("skin_lbs", vertices, lbsMs);
+  bench::report("skin_dqs (+ bone conversion)", vertices, dqsMs);
+  std::printf("  dqs vs reference %.2fx, dqs / lbs time %.2f\n", referenceMs / dqsMs, dqsMs / lbsMs);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("simd::kWidth = %zu\n", simd::kWidth);
+  for (size_t vertices : {10000u, 100000u, 1000000u}) {
+    bench_mesh(vertices);
+  }
+  return 0;
+}
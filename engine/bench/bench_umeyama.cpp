@@ -0,0 +1,111 @@
+// 3D Umeyama: Eigen's generic umeyama() (dynamic-size and 3 x n inputs) vs.
+// the fixed-size Horn path umeyama3(), on the small point sets of ICP loops.
+//
+//   cmake -S engine/wasm -B build -DGEOMETRY_BUILD_BENCHMARKS=ON -DGEOMETRY_NATIVE_ARCH=ON
+//   cmake --build build && ./build/bench_umeyama
+#include <Eigen/Geometry>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench_util.h"
+#include "umeyama.h"
+
+namespace {
+
+// `sets` problems of `points` correspondences each: dst = s * R * src + t + noise.
+struct Problems {
+  std::vector<Eigen::Matrix3Xf> src, dst;
+  std::vector<Eigen::MatrixXf> srcDynamic, dstDynamic;
+
+  Problems(size_t sets, size_t points, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (size_t s = 0; s < sets; s++) {
+      const Eigen::Quaternionf q = Eigen::Quaternionf(dist(rng), dist(rng), dist(rng), dist(rng)).normalized();
+      const Eigen::Vector3f t(dist(rng), dist(rng), dist(rng));
+      Eigen::Matrix3Xf a(3, points), b(3, points);
+      for (size_t i = 0; i < points; i++) {
+        a.col(i) = Eigen::Vector3f(dist(rng), dist(rng), dist(rng));
+        b.col(i) = 1.5f * (q * a.col(i)) + t + 1e-3f * Eigen::Vector3f(dist(rng), dist(rng), dist(rng));
+      }
+      src.push_back(a);
+      dst.push_back(b);
+      srcDynamic.push_back(a);
+      dstDynamic.push_back(b);
+    }
+  }
+};
+
+void bench_size(size_t points) {
+  const size_t sets = points <= 64 ? 20000 : 2000;
+  const Problems p(sets, points, 1);
+  std::vector<Eigen::Matrix4f> generic(sets), fixed(sets), horn(sets);
+
+  const int reps = 5;
+  const double dynamicMs = bench::best_ms(reps, [&] {
+    for (size_t s = 0; s < sets; s++) {
+      generic[s] = Eigen::umeyama(p.srcDynamic[s], p.dstDynamic[s]);
+    }
+    bench::consume(generic.data());
+  });
+  const double fixedMs = bench::best_ms(reps, [&] {
+    for (size_t s = 0; s < sets; s++) {
+      fixed[s] = Eigen::umeyama(p.src[s], p.dst[s]);
+    }
+    bench::consume(fixed.data());
+  });
+  const double hornMs = bench::best_ms(reps, [&] {
+    for (size_t s = 0; s < sets; s++) {
+      horn[s] = umeyama3(p.src[s], p.dst[s]);
+    }
+    bench::consume(horn.data());
+  });
+
+  float maxErr = 0.0f;
+  for (size_t s = 0; s < sets; s++) {
+    maxErr = std::max(maxErr, (horn[s] - generic[s]).cwiseAbs().maxCoeff());
+  }
+
+  std::printf("%zu solves of %zu points (max |diff| %.2e)\n", sets, points, maxErr);
+  bench::report("Eigen::umeyama (MatrixXf)", sets, dynamicMs);
+  bench::report("Eigen::umeyama (Matrix3Xf)", sets, fixedMs);
+  bench::report("umeyama3 (Horn)", sets, hornMs);
+  std::printf("  speedup %.2fx vs MatrixXf, %.2fx vs Matrix3Xf\n", dynamicMs / hornMs, fixedMs / hornMs);
+}
+
+// The solve step alone, from accumulated moments.
+void bench_solve() {
+  const Problems p(1, 1000, 2);
+  UmeyamaAccumulator acc;
+  acc.add(p.src[0].data(), p.dst[0].data(), 1000);
+
+  const size_t calls = 100000;
+  Eigen::Matrix4d out;
+  const double svdMs = bench::best_ms(5, [&] {
+    for (size_t i = 0; i < calls; i++) {
+      out = acc.solve(true, UmeyamaSolver::Svd);
+      bench::consume(out.data());
+    }
+  });
+  const double hornMs = bench::best_ms(5, [&] {
+    for (size_t i = 0; i < calls; i++) {
+      out = acc.solve(true, UmeyamaSolver::Horn);
+      bench::consume(out.data());
+    }
+  });
+  std::printf("UmeyamaAccumulator::solve, 3x3 moments only\n");
+  bench::report("JacobiSVD (Svd)", calls, svdMs);
+  bench::report("quaternion eigenvector (Horn)", calls, hornMs);
+  std::printf("  speedup %.2fx\n", svdMs / hornMs);
+}
+
+}  // namespace
+
+int main() {
+  for (size_t points : {4u, 16u, 64u, 256u, 4096u}) {
+    bench_size(points);
+  }
+  bench_solve();
+  return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+// Minimal timing helpers for the native kernel benchmarks (engine/bench).
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace bench {
+
+// Best wall time in milliseconds over `reps` runs of `fn`.
+template <typename Fn>
+double best_ms(int reps, Fn&& fn) {
+  double best = 1e300;
+  for (int r = 0; r < reps; r++) {
+    const auto t0 = std::chrono::steady_clock::now();
+    fn();
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    best = ms < best ? ms : best;
+  }
+  return best;
+}
+
+inline void report(const char* name, size_t items, double ms) {
+  std::printf("  %-34s %10.1f us  %8.1f M/s\n", name, ms * 1e3, (double)items / (ms * 1e3));
+}
+
+// Unit quaternions (x, y, z, w interleaved), deterministic.
+inline std::vector<float> random_unit_quats(size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> dist(0.0f, 1.0f);
+  std::vector<float> q(count * 4);
+  for (size_t i = 0; i < count; i++) {
+    float* p = &q[i * 4];
+    float len2 = 0.0f;
+    for (int k = 0; k < 4; k++) {
+      p[k] = dist(rng);
+      len2 += p[k] * p[k];
+    }
+    const float inv = 1.0f / std::sqrt(len2);
+    for (int k = 0; k < 4; k++) {
+      p[k] *= inv;
+    }
+  }
+  return q;
+}
+
+// Keeps the optimizer from discarding a result: the pointer itself is volatile,
+// so every store to it is an observable side effect.
+inline const void* volatile sink = nullptr;
+
+inline void consume(const void* p) { sink = p; }
+
+}  // namespace bench
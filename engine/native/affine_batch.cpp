@@ -0,0 +1,112 @@
+#include "affine_batch.h"
+
+#include "simd.h"
+
+namespace {
+
+using simd::vfloat;
+
+// Linear part (column-major, m[col * 3 + row]) and translation of n <= kWidth
+// consecutive 4x4 matrices, transposed so lane l holds matrix l.
+struct AffineLanes {
+  vfloat m[9];
+  vfloat t[3];
+};
+
+// Each column of kWidth matrices is one load4 (the bottom-row entry is
+// dropped). Idle tail lanes read as zero.
+inline AffineLanes load_affine(const float* matrices, size_t n) {
+  AffineLanes a;
+  vfloat bottom;
+  for (size_t col = 0; col < 3; col++) {
+    vfloat* c = a.m + col * 3;
+    if (n == simd::kWidth) {
+      simd::load4(matrices + col * 4, 16, c[0], c[1], c[2], bottom);
+    } else {
+      simd::load4_n(matrices + col * 4, 16, n, c[0], c[1], c[2], bottom);
+    }
+  }
+  if (n == simd::kWidth) {
+    simd::load4(matrices + 12, 16, a.t[0], a.t[1], a.t[2], bottom);
+  } else {
+    simd::load4_n(matrices + 12, 16, n, a.t[0], a.t[1], a.t[2], bottom);
+  }
+  return a;
+}
+
+inline void store_affine(float* matrices, size_t n, const AffineLanes& a) {
+  const vfloat zero = simd::splat(0.0f);
+  for (size_t col = 0; col < 4; col++) {
+    const vfloat* c = col < 3 ? a.m + col * 3 : a.t;
+    const vfloat bottom = col < 3 ? zero : simd::splat(1.0f);
+    if (n == simd::kWidth) {
+      simd::store4(matrices + col * 4, 16, c[0], c[1], c[2], bottom);
+    } else {
+      simd::store4_n(matrices + col * 4, 16, n, c[0], c[1], c[2], bottom);
+    }
+  }
+}
+
+// Inverse linear part L^-1 of each lane, column-major.
+template <AffineKind K>
+inline void invert_linear(const vfloat* m, vfloat* inv) {
+  using simd::fmadd;
+  if (K == AffineKind::General) {
+    // Rows of L^-1 are the cross products of column pairs over det(L).
+    const vfloat c0[3] = {m[4] * m[8] - m[5] * m[7], m[5] * m[6] - m[3] * m[8], m[3] * m[7] - m[4] * m[6]};
+    const vfloat c1[3] = {m[7] * m[2] - m[8] * m[1], m[8] * m[0] - m[6] * m[2], m[6] * m[1] - m[7] * m[0]};
+    const vfloat c2[3] = {m[1] * m[5] - m[2] * m[4], m[2] * m[3] - m[0] * m[5], m[0] * m[4] - m[1] * m[3]};
+    const vfloat invDet = simd::splat(1.0f) / fmadd(m[0], c0[0], fmadd(m[1], c0[1], m[2] * c0[2]));
+    for (int col = 0; col < 3; col++) {
+      inv[col * 3 + 0] = c0[col] * invDet;
+      inv[col * 3 + 1] = c1[col] * invDet;
+      inv[col * 3 + 2] = c2[col] * invDet;
+    }
+  } else {
+    vfloat scale = simd::splat(1.0f);
+    if (K == AffineKind::UniformScale) {
+      scale = scale / fmadd(m[0], m[0], fmadd(m[1], m[1], m[2] * m[2]));
+    }
+    for (int col = 0; col < 3; col++) {
+      for (int row = 0; row < 3; row++) {
+        inv[col * 3 + row] = K == AffineKind::Isometry ? m[row * 3 + col] : m[row * 3 + col] * scale;
+      }
+    }
+  }
+}
+
+// [L t]^-1 = [L^-1, -L^-1 t].
+template <AffineKind K>
+inline AffineLanes invert(const AffineLanes& a) {
+  using simd::fmadd;
+  AffineLanes r;
+  invert_linear<K>(a.m, r.m);
+  for (int row = 0; row < 3; row++) {
+    r.t[row] = -fmadd(r.m[row], a.t[0], fmadd(r.m[3 + row], a.t[1], r.m[6 + row] * a.t[2]));
+  }
+  return r;
+}
+
+}  // namespace
+
+template <AffineKind K>
+void invert_affine_batch(const float* matrices, float* out, size_t count) {
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = count - i < simd::kWidth ? count - i : simd::kWidth;
+    store_affine(out + i * 16, n, invert<K>(load_affine(matrices + i * 16, n)));
+  }
+}
+
+template void invert_affine_batch<AffineKind::Isometry>(const float*, float*, size_t);
+template void invert_affine_batch<AffineKind::UniformScale>(const float*, float*, size_t);
+template void invert_affine_batch<AffineKind::General>(const float*, float*, size_t);
+
+void invert_affine_batch(AffineKind kind, const float* matrices, float* out, size_t count) {
+  if (kind == AffineKind::Isometry) {
+    invert_affine_batch<AffineKind::Isometry>(matrices, out, count);
+  } else if (kind == AffineKind::UniformScale) {
+    invert_affine_batch<AffineKind::UniformScale>(matrices, out, count);
+  } else {
+    invert_affine_batch<AffineKind::General>(matrices, out, count);
+  }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+
+// Batched inverses of affine transforms stored as back-to-back column-major 4x4
+// matrices (Matrix4.elements, 16 floats each; the bottom row is ignored and
+// written as 0, 0, 0, 1). Where Transform::inverse(TransformTraits) picks its
+// path per call at runtime, the variant here is a template parameter, and each
+// kernel transposes simd::kWidth matrices into lanes (like transform_boxes) so
+// the inverse runs on full vectors. `out` may alias `matrices`.
+
+enum class AffineKind {
+  // Rotation + translation (Transform::inverse(Isometry)): the linear part is
+  // transposed.
+  Isometry,
+  // Rotation scaled by the same factor s on every axis: R^T / s^2, with s^2
+  // taken from the first column. No Eigen counterpart; avoids the determinant
+  // for the common "uniform scale" instance transforms.
+  UniformScale,
+  // Any invertible linear part (Transform::inverse(Affine)): adjugate over
+  // determinant, as Eigen's 3x3 inverse. A singular linear part gives inf/NaN
+  // like Eigen does.
+  General,
+};
+
+// out[i] = inverse of matrices[i] for `count` matrices, assuming every one is
+// of kind K (not checked).
+template <AffineKind K>
+void invert_affine_batch(const float* matrices, float* out, size_t count);
+
+void invert_affine_batch(AffineKind kind, const float* matrices, float* out, size_t count);
@@ -2,8 +2,18 @@
   "targets": [
     {
       "target_name": "geometry",
-      "sources": ["geometry_node.cc", "geometry_lib.cpp"],
-      "cflags_cc": ["-std=c++17"]
+      "sources": ["geometry_node.cc", "geometry_lib.cpp", "polyhedron.cpp", "triangulate.cpp", "edges.cpp", "wireframe.cpp", "quat_batch.cpp", "euler_batch.cpp", "rotation_batch.cpp", "affine_batch.cpp", "mesh_transform.cpp", "skinning.cpp", "dual_quat.cpp", "bounds.cpp", "bvh.cpp", "mesh_bvh.cpp", "lbvh.cpp", "parallel.cpp", "broadphase.cpp", "point_grid.cpp", "umeyama.cpp", "kd_tree.cpp", "icp.cpp", "transform_hierarchy.cpp"],
+      "include_dirs": ["<!(node -p \"process.env.EIGEN3_INCLUDE_DIR || '/usr/include/eigen3'\")"],
+      "cflags_cc": ["-std=c++17"],
+      "variables": {
+        "geometry_native_arch%": "<!(node -p \"/^(1|on|true)$/i.test(process.env.GEOMETRY_NATIVE_ARCH || '') ? 1 : 0\")"
+      },
+      "conditions": [
+        ["geometry_native_arch==1 and OS!='win'", {
+          "cflags_cc": ["-march=native"],
+          "xcode_settings": {"OTHER_CPLUSPLUSFLAGS": ["-march=native"]}
+        }]
+      ]
     }
   ]
 }
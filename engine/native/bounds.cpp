@@ -0,0 +1,180 @@
+#include "bounds.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "simd.h"
+
+namespace {
+
+using simd::vfloat;
+
+struct BoxLanes {
+  vfloat minX, minY, minZ, maxX, maxY, maxZ;
+};
+
+inline vfloat load_lanes(const float* p, size_t n) {
+  return n == simd::kWidth ? simd::load(p) : simd::load_n(p, n);
+}
+
+inline void store_lanes(float* p, vfloat v, size_t n) {
+  if (n == simd::kWidth) {
+    simd::store(p, v);
+  } else {
+    simd::store_n(p, v, n);
+  }
+}
+
+inline BoxLanes load_box(const ConstBoxSoA& b, size_t i, size_t n) {
+  return {
+      load_lanes(b.minX + i, n),
+      load_lanes(b.minY + i, n),
+      load_lanes(b.minZ + i, n),
+      load_lanes(b.maxX + i, n),
+      load_lanes(b.maxY + i, n),
+      load_lanes(b.maxZ + i, n)};
+}
+
+inline void store_box(const BoxSoA& b, size_t i, size_t n, const BoxLanes& v) {
+  store_lanes(b.minX + i, v.minX, n);
+  store_lanes(b.minY + i, v.minY, n);
+  store_lanes(b.minZ + i, v.minZ, n);
+  store_lanes(b.maxX + i, v.maxX, n);
+  store_lanes(b.maxY + i, v.maxY, n);
+  store_lanes(b.maxZ + i, v.maxZ, n);
+}
+
+// Linear part (column-major, m[col * 3 + row]) and translation of n <= kWidth
+// consecutive 4x4 matrices, transposed so lane l holds matrix l.
+struct AffineLanes {
+  vfloat m[9];
+  vfloat t[3];
+};
+
+inline AffineLanes load_affine(const float* matrices, size_t n) {
+  alignas(64) float tmp[12][simd::kWidth] = {};
+  for (size_t l = 0; l < n; l++) {
+    const float* e = matrices + l * 16;
+    for (size_t col = 0; col < 3; col++) {
+      for (size_t row = 0; row < 3; row++) {
+        tmp[col * 3 + row][l] = e[col * 4 + row];
+      }
+      tmp[9 + col][l] = e[12 + col];
+    }
+  }
+  AffineLanes a;
+  for (size_t k = 0; k < 9; k++) {
+    a.m[k] = simd::load(tmp[k]);
+  }
+  for (size_t k = 0; k < 3; k++) {
+    a.t[k] = simd::load(tmp[9 + k]);
+  }
+  return a;
+}
+
+inline BoxLanes transform_box(const BoxLanes& b, const AffineLanes& a) {
+  using simd::abs;
+  using simd::fmadd;
+  const vfloat half = simd::splat(0.5f);
+
+  // Twice the center and the full size, as in AlignedBox::transform.
+  const vfloat cx = b.minX + b.maxX, cy = b.minY + b.maxY, cz = b.minZ + b.maxZ;
+  const vfloat sx = b.maxX - b.minX, sy = b.maxY - b.minY, sz = b.maxZ - b.minZ;
+
+  BoxLanes r;
+  vfloat* mins[3] = {&r.minX, &r.minY, &r.minZ};
+  vfloat* maxs[3] = {&r.maxX, &r.maxY, &r.maxZ};
+  for (size_t row = 0; row < 3; row++) {
+    const vfloat center2 =
+        fmadd(a.m[row], cx, fmadd(a.m[3 + row], cy, fmadd(a.m[6 + row], cz, a.t[row] + a.t[row])));
+    const vfloat extent2 = fmadd(abs(a.m[row]), sx, fmadd(abs(a.m[3 + row]), sy, abs(a.m[6 + row]) * sz));
+    *mins[row] = (center2 - extent2) * half;
+    *maxs[row] = (center2 + extent2) * half;
+  }
+
+  const simd::vmask empty = (b.minX > b.maxX) | (b.minY > b.maxY) | (b.minZ > b.maxZ);
+  if (simd::any(empty)) {
+    r.minX = simd::select(empty, b.minX, r.minX);
+    r.minY = simd::select(empty, b.minY, r.minY);
+    r.minZ = simd::select(empty, b.minZ, r.minZ);
+    r.maxX = simd::select(empty, b.maxX, r.maxX);
+    r.maxY = simd::select(empty, b.maxY, r.maxY);
+    r.maxZ = simd::select(empty, b.maxZ, r.maxZ);
+  }
+  return r;
+}
+
+}  // namespace
+
+void transform_boxes(ConstBoxSoA in, const float* matrices, BoxSoA out, size_t count) {
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = count - i < simd::kWidth ? count - i : simd::kWidth;
+    const BoxLanes b = load_box(in, i, n);
+    store_box(out, i, n, transform_box(b, load_affine(matrices + i * 16, n)));
+  }
+}
+
+Frustum frustum_from_matrix(const float* matrix4) {
+  // Row r of the column-major matrix is (m[r], m[4 + r], m[8 + r], m[12 + r]).
+  const Eigen::Map<const Eigen::Matrix4f> m(matrix4);
+  const Eigen::Vector4f coeffs[6] = {
+      m.row(3) - m.row(0),  // right
+      m.row(3) + m.row(0),  // left
+      m.row(3) + m.row(1),  // bottom
+      m.row(3) - m.row(1),  // top
+      m.row(3) - m.row(2),  // far
+      m.row(3) + m.row(2),  // near
+  };
+
+  Frustum f;
+  for (size_t p = 0; p < 6; p++) {
+    const float length = coeffs[p].head<3>().norm();
+    f.planes[p].coeffs() = length > 0.0f ? Eigen::Vector4f(coeffs[p] / length) : coeffs[p];
+  }
+  return f;
+}
+
+Frustum frustum_from_transform(const Eigen::Projective3f& projView) {
+  return frustum_from_matrix(projView.matrix().data());
+}
+
+void cull_boxes(const Frustum& frustum, ConstBoxSoA boxes, size_t count, uint32_t* visible) {
+  // The p-vertex pick depends only on the plane normal's signs, which are the
+  // same for every lane: resolve it once per plane to min or max arrays.
+  struct PlaneLanes {
+    vfloat n[3];
+    vfloat d;
+    const float* corner[3];
+  };
+  PlaneLanes planes[6];
+  const float* mins[3] = {boxes.minX, boxes.minY, boxes.minZ};
+  const float* maxs[3] = {boxes.maxX, boxes.maxY, boxes.maxZ};
+  for (size_t p = 0; p < 6; p++) {
+    const Eigen::Vector4f& c = frustum.planes[p].coeffs();
+    for (size_t axis = 0; axis < 3; axis++) {
+      planes[p].n[axis] = simd::splat(c[axis]);
+      planes[p].corner[axis] = c[axis] > 0.0f ? maxs[axis] : mins[axis];
+    }
+    planes[p].d = simd::splat(c[3]);
+  }
+
+  std::memset(visible, 0, cull_mask_words(count) * sizeof(uint32_t));
+  const vfloat zero = simd::splat(0.0f);
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = count - i < simd::kWidth ? count - i : simd::kWidth;
+    uint32_t inside = (1u << n) - 1u;
+    for (size_t p = 0; p < 6 && inside != 0; p++) {
+      const PlaneLanes& plane = planes[p];
+      const vfloat distance = simd::fmadd(
+          plane.n[0],
+          load_lanes(plane.corner[0] + i, n),
+          simd::fmadd(
+              plane.n[1],
+              load_lanes(plane.corner[1] + i, n),
+              simd::fmadd(plane.n[2], load_lanes(plane.corner[2] + i, n), plane.d)));
+      inside &= simd::bits(distance >= zero);
+    }
+    // kWidth divides 32, so a block never straddles two mask words.
+    visible[i / 32] |= inside << (i % 32);
+  }
+}
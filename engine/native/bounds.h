@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <Eigen/Geometry>
+
+// Batched axis-aligned box kernels over structure-of-arrays storage: six
+// component arrays minX[], minY[], minZ[], maxX[], maxY[], maxZ[] of `count`
+// boxes each. Like quat_batch.h, every kernel runs simd::kWidth boxes per step
+// and handles the tail with partial loads. An empty box has min > max on some
+// axis (Three's Box3.makeEmpty uses +Infinity / -Infinity).
+
+struct BoxSoA {
+  float* minX;
+  float* minY;
+  float* minZ;
+  float* maxX;
+  float* maxY;
+  float* maxZ;
+};
+
+struct ConstBoxSoA {
+  const float* minX;
+  const float* minY;
+  const float* minZ;
+  const float* maxX;
+  const float* maxY;
+  const float* maxZ;
+
+  ConstBoxSoA(
+      const float* minX_,
+      const float* minY_,
+      const float* minZ_,
+      const float* maxX_,
+      const float* maxY_,
+      const float* maxZ_)
+      : minX(minX_), minY(minY_), minZ(minZ_), maxX(maxX_), maxY(maxY_), maxZ(maxZ_) {}
+  ConstBoxSoA(const BoxSoA& b) : minX(b.minX), minY(b.minY), minZ(b.minZ), maxX(b.maxX), maxY(b.maxY), maxZ(b.maxZ) {}
+};
+
+// Splits one planar block [minX..., minY..., minZ..., maxX..., maxY..., maxZ...]
+// (the layout the JS bindings use) into component pointers.
+inline BoxSoA box_soa_planar(float* block, size_t count) {
+  return BoxSoA{block, block + count, block + 2 * count, block + 3 * count, block + 4 * count, block + 5 * count};
+}
+
+inline ConstBoxSoA box_soa_planar(const float* block, size_t count) {
+  return ConstBoxSoA(block, block + count, block + 2 * count, block + 3 * count, block + 4 * count, block + 5 * count);
+}
+
+// out[i] = AABB of box i under the affine transform `matrices + 16 * i`
+// (column-major 4x4, bottom row ignored; back-to-back Matrix4.elements, i.e.
+// the InstancedMesh.instanceMatrix layout). Same method as Eigen's
+// AlignedBox::transform: new center = M * center, new half-extent =
+// |linear part| * half-extent. Empty boxes are copied through unchanged, like
+// Box3.applyMatrix4. `out` may alias `in`.
+void transform_boxes(ConstBoxSoA in, const float* matrices, BoxSoA out, size_t count);
+
+// Six inward-facing planes (signedDistance >= 0 inside), in Three's Frustum
+// order: right, left, bottom, top, far, near. Planes are normalized.
+struct Frustum {
+  Eigen::Hyperplane<float, 3> planes[6];
+};
+
+// Gribb/Hartmann extraction from a column-major projection * view matrix with
+// clip-space z in [-w, w] (OpenGL/WebGL, Three's default); same planes as
+// Frustum.setFromProjectionMatrix.
+Frustum frustum_from_matrix(const float* matrix4);
+Frustum frustum_from_transform(const Eigen::Projective3f& projView);
+
+// Words of the cull_boxes visibility mask for `count` boxes.
+inline size_t cull_mask_words(size_t count) {
+  return (count + 31) / 32;
+}
+
+// Sets bit (i % 32) of visible[i / 32] when box i is inside or intersects the
+// frustum, using the p-vertex test (the box corner furthest along each plane
+// normal must not be behind the plane) like Frustum.intersectsBox; conservative
+// near frustum corners. Writes cull_mask_words(count) words; unused high bits
+// of the last word are cleared.
+void cull_boxes(const Frustum& frustum, ConstBoxSoA boxes, size_t count, uint32_t* visible);
@@ -0,0 +1,146 @@
+#include "broadphase.h"
+
+#include <algorithm>
+
+#include "simd.h"
+
+namespace {
+
+const uint32_t kClosed = 0xffffffffu;
+
+// Endpoint order: by value, min endpoints before max endpoints at equal
+// values, so touching intervals count as overlapping.
+template <typename Endpoint>
+bool endpoint_less(const Endpoint& a, const Endpoint& b) {
+  return a.value < b.value || (a.value == b.value && (a.id & 1) < (b.id & 1));
+}
+
+// The box's extent on `axis`, swapped if empty there so every interval is
+// well-formed for the sort (the sweep skips empty boxes anyway).
+float endpoint_value(const Eigen::AlignedBox3f& b, int axis, bool isMax) {
+  return isMax ? std::max(b.min()[axis], b.max()[axis]) : std::min(b.min()[axis], b.max()[axis]);
+}
+
+}  // namespace
+
+void SweepAndPrune::update(
+    ConstBoxSoA boxes,
+    size_t count,
+    std::vector<Pair>& added,
+    std::vector<Pair>& removed) {
+  boxes_.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    const Eigen::Vector3f min(boxes.minX[i], boxes.minY[i], boxes.minZ[i]);
+    const Eigen::Vector3f max(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+    // A NaN endpoint would break the sort's strict weak ordering; store the box
+    // as empty instead, which the sweep skips.
+    boxes_[i] = min.array().isNaN().any() || max.array().isNaN().any() ? Eigen::AlignedBox3f()
+                                                                        : Eigen::AlignedBox3f(min, max);
+  }
+
+  if (endpoints_.size() == count * 2) {
+    for (Endpoint& e : endpoints_) {
+      e.value = endpoint_value(boxes_[e.id >> 1], axis_, e.id & 1);
+    }
+    sort_endpoints();
+  } else {
+    endpoints_.resize(count * 2);
+    for (size_t i = 0; i < count * 2; i++) {
+      endpoints_[i] = Endpoint{endpoint_value(boxes_[i >> 1], axis_, i & 1), (uint32_t)i};
+    }
+    std::sort(endpoints_.begin(), endpoints_.end(), endpoint_less<Endpoint>);
+  }
+
+  sweep();
+
+  // Both lists are sorted: merge them into the differences.
+  auto prev = pairs_.begin();
+  auto cur = current_.begin();
+  while (prev != pairs_.end() || cur != current_.end()) {
+    if (cur == current_.end() || (prev != pairs_.end() && *prev < *cur)) {
+      removed.push_back(*prev++);
+    } else if (prev == pairs_.end() || *cur < *prev) {
+      added.push_back(*cur++);
+    } else {
+      ++prev;
+      ++cur;
+    }
+  }
+  pairs_.swap(current_);
+}
+
+// Insertion sort from the previous update's order; each endpoint only moves
+// past the endpoints it crossed since then.
+void SweepAndPrune::sort_endpoints() {
+  for (size_t i = 1; i < endpoints_.size(); i++) {
+    const Endpoint e = endpoints_[i];
+    size_t j = i;
+    for (; j > 0 && endpoint_less(e, endpoints_[j - 1]); j--) {
+      endpoints_[j] = endpoints_[j - 1];
+    }
+    endpoints_[j] = e;
+  }
+}
+
+// A box's min endpoint pairs it with every box whose interval is open at that
+// point; its max endpoint closes it. Empty boxes are never opened.
+void SweepAndPrune::sweep() {
+  const int secondary[2] = {(axis_ + 1) % 3, (axis_ + 2) % 3};
+  current_.clear();
+  openCount_ = 0;
+  openSlot_.assign(boxes_.size(), kClosed);
+  for (const Endpoint& e : endpoints_) {
+    const uint32_t index = e.id >> 1;
+    if (e.id & 1) {
+      const uint32_t slot = openSlot_[index];
+      if (slot != kClosed) {
+        // swap-remove
+        const size_t last = --openCount_;
+        for (int k = 0; k < 2; k++) {
+          openMin_[k][slot] = openMin_[k][last];
+          openMax_[k][slot] = openMax_[k][last];
+        }
+        openIndex_[slot] = openIndex_[last];
+        openSlot_[openIndex_[slot]] = slot;
+      }
+      continue;
+    }
+
+    const Eigen::AlignedBox3f& box = boxes_[index];
+    if (box.isEmpty()) {
+      continue;
+    }
+    const simd::vfloat min0 = simd::splat(box.min()[secondary[0]]);
+    const simd::vfloat max0 = simd::splat(box.max()[secondary[0]]);
+    const simd::vfloat min1 = simd::splat(box.min()[secondary[1]]);
+    const simd::vfloat max1 = simd::splat(box.max()[secondary[1]]);
+    for (size_t i = 0; i < openCount_; i += simd::kWidth) {
+      const size_t n = openCount_ - i < simd::kWidth ? openCount_ - i : simd::kWidth;
+      const simd::vmask overlap = (simd::load(&openMin_[0][i]) <= max0) & (min0 <= simd::load(&openMax_[0][i])) &
+          (simd::load(&openMin_[1][i]) <= max1) & (min1 <= simd::load(&openMax_[1][i]));
+      uint32_t hits = simd::bits(overlap) & (uint32_t)((1ull << n) - 1);
+      for (size_t lane = i; hits != 0; lane++, hits >>= 1) {
+        if (hits & 1) {
+          const uint32_t other = openIndex_[lane];
+          current_.push_back(index < other ? Pair{index, other} : Pair{other, index});
+        }
+      }
+    }
+
+    if (openIndex_.size() < openCount_ + 1 + simd::kWidth) {
+      const size_t padded = openCount_ * 2 + simd::kWidth + 1;
+      for (int k = 0; k < 2; k++) {
+        openMin_[k].resize(padded);
+        openMax_[k].resize(padded);
+      }
+      openIndex_.resize(padded);
+    }
+    for (int k = 0; k < 2; k++) {
+      openMin_[k][openCount_] = box.min()[secondary[k]];
+      openMax_[k][openCount_] = box.max()[secondary[k]];
+    }
+    openIndex_[openCount_] = index;
+    openSlot_[index] = (uint32_t)openCount_++;
+  }
+  std::sort(current_.begin(), current_.end());
+}
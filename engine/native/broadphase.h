@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "bounds.h"
+
+// Incremental sweep-and-prune broadphase for boxes that move a little every
+// frame (simulation bodies, trigger volumes).
+//
+// Box endpoints on one primary axis stay sorted between updates; an update
+// refreshes their values and re-sorts with insertion sort, which is close to
+// O(n) under frame-to-frame coherence. A sweep over the sorted endpoints then
+// tests each box against the boxes whose primary-axis interval is still open,
+// simd::kWidth at a time on the two secondary axes, with AlignedBox::intersects
+// semantics (touching boxes overlap). Empty boxes are skipped, since
+// intersects() can accept a box that is inverted on one axis, and so are boxes
+// with a NaN coordinate. The resulting sorted pair list is diffed against the
+// previous one. Cost per update is O(n + swaps + pairs overlapping on the
+// primary axis), so pick the axis along which the boxes are most spread out.
+class SweepAndPrune {
+ public:
+  struct Pair {
+    uint32_t a, b;  // box indices, a < b
+
+    bool operator<(const Pair& other) const { return a != other.a ? a < other.a : b < other.b; }
+    bool operator==(const Pair& other) const { return a == other.a && b == other.b; }
+  };
+
+  explicit SweepAndPrune(int axis = 0) : axis_(axis < 0 || axis > 2 ? 0 : axis) {}
+
+  // Takes this frame's boxes and appends the pairs that started (`added`) and
+  // stopped (`removed`) overlapping since the previous update, each sorted.
+  // Box indices are positions in `boxes`; when `count` changes the endpoint
+  // list is rebuilt with a full sort, and pairs are still diffed by index.
+  void update(ConstBoxSoA boxes, size_t count, std::vector<Pair>& added, std::vector<Pair>& removed);
+
+  // Pairs overlapping as of the last update, sorted.
+  const std::vector<Pair>& pairs() const { return pairs_; }
+
+  size_t size() const { return boxes_.size(); }
+  int axis() const { return axis_; }
+
+ private:
+  struct Endpoint {
+    float value;
+    uint32_t id;  // box << 1 | 1 for the max endpoint
+  };
+
+  void sort_endpoints();
+  void sweep();
+
+  int axis_;
+  std::vector<Eigen::AlignedBox3f> boxes_;
+  std::vector<Endpoint> endpoints_;
+  std::vector<Pair> pairs_;
+  std::vector<Pair> current_;       // sweep output, swapped with pairs_
+
+  // Boxes whose primary interval the sweep is inside, as SoA bounds on the two
+  // secondary axes (padded by simd::kWidth so blocks can be loaded whole).
+  size_t openCount_ = 0;
+  std::vector<float> openMin_[2];
+  std::vector<float> openMax_[2];
+  std::vector<uint32_t> openIndex_;
+  std::vector<uint32_t> openSlot_;  // box -> open position
+};
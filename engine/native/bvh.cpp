@@ -0,0 +1,343 @@
+#include "bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+using Box = Eigen::AlignedBox3f;
+using Eigen::Vector3f;
+
+const float kInfinity = std::numeric_limits<float>::infinity();
+
+// Half the surface area; only ratios matter for the SAH.
+float half_area(const Box& b) {
+  if (b.isEmpty()) {
+    return 0.0f;
+  }
+  const Vector3f d = b.sizes();
+  return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+}
+
+Box load_box(const ConstBoxSoA& boxes, size_t i) {
+  return Box(
+      Vector3f(boxes.minX[i], boxes.minY[i], boxes.minZ[i]), Vector3f(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]));
+}
+
+struct Ray {
+  Vector3f origin;
+  Vector3f invDir;
+};
+
+// Slab test: entry distance into `b`, or +inf when the ray misses it within
+// [0, maxT]. A zero direction component gives +-inf slabs; the NaN from a ray
+// lying exactly in a slab plane is dropped by the min/max argument order.
+float ray_enter(const Ray& ray, const Box& b, float maxT) {
+  float tNear = 0.0f;
+  float tFar = maxT;
+  for (int axis = 0; axis < 3; axis++) {
+    const float t1 = (b.min()[axis] - ray.origin[axis]) * ray.invDir[axis];
+    const float t2 = (b.max()[axis] - ray.origin[axis]) * ray.invDir[axis];
+    tNear = std::max(tNear, std::min(t1, t2));
+    tFar = std::min(tFar, std::max(t1, t2));
+  }
+  return tNear <= tFar ? tNear : kInfinity;
+}
+
+struct Bin {
+  Box bounds;
+  uint32_t count = 0;
+};
+
+}  // namespace
+
+void BoxBvh::build(ConstBoxSoA boxes, size_t count) {
+  nodes_.clear();
+  primitives_.clear();
+  leafBoxes_.clear();
+  boxCount_ = count;
+
+  std::vector<Box> primBoxes;
+  std::vector<Vector3f> centroids;
+  primBoxes.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    const Box b = load_box(boxes, i);
+    if (!b.isEmpty()) {
+      primitives_.push_back((uint32_t)i);
+      primBoxes.push_back(b);
+    }
+  }
+  if (primitives_.empty()) {
+    return;
+  }
+  centroids.resize(primitives_.size());
+  for (size_t k = 0; k < primitives_.size(); k++) {
+    centroids[k] = primBoxes[k].center();
+  }
+
+  // Partitioning permutes `order` (slots into primBoxes/centroids); primitives_
+  // and leafBoxes_ are written from it at the end.
+  std::vector<uint32_t> order(primitives_.size());
+  for (size_t k = 0; k < order.size(); k++) {
+    order[k] = (uint32_t)k;
+  }
+
+  struct Task {
+    uint32_t parent;  // node whose right child this is, kNone for the root/left children
+    uint32_t first;
+    uint32_t count;
+    uint32_t depth;
+  };
+  std::vector<Task> stack;
+  stack.push_back(Task{kNone, 0, (uint32_t)order.size(), 0});
+  nodes_.reserve(2 * order.size());
+
+  while (!stack.empty()) {
+    const Task task = stack.back();
+    stack.pop_back();
+
+    const uint32_t nodeIndex = (uint32_t)nodes_.size();
+    if (task.parent != kNone) {
+      nodes_[task.parent].rightOrFirst = nodeIndex;
+    }
+    nodes_.push_back(Node{Box(), 0, 0});
+
+    Box bounds;
+    Box centroidBounds;
+    for (uint32_t k = task.first; k < task.first + task.count; k++) {
+      bounds.extend(primBoxes[order[k]]);
+      centroidBounds.extend(centroids[order[k]]);
+    }
+    nodes_[nodeIndex].bounds = bounds;
+
+    const auto make_leaf = [&]() {
+      nodes_[nodeIndex].rightOrFirst = task.first;
+      nodes_[nodeIndex].count = task.count;
+    };
+
+    int axis = 0;
+    centroidBounds.sizes().maxCoeff(&axis);
+    const float cMin = centroidBounds.min()[axis];
+    const float extent = centroidBounds.max()[axis] - cMin;
+    if (task.count <= 2 || task.depth + 1 >= kMaxDepth || !(extent > 0.0f)) {
+      // Coincident centroids cannot be separated by binning.
+      make_leaf();
+      continue;
+    }
+
+    Bin bins[kBins];
+    const float scale = kBins / extent;
+    const auto bin_of = [&](uint32_t slot) {
+      const size_t b = (size_t)((centroids[slot][axis] - cMin) * scale);
+      return std::min(b, kBins - 1);
+    };
+    for (uint32_t k = task.first; k < task.first + task.count; k++) {
+      Bin& bin = bins[bin_of(order[k])];
+      bin.bounds.extend(primBoxes[order[k]]);
+      bin.count++;
+    }
+
+    // Sweep from the right for suffix areas, then from the left for the cost of
+    // splitting after each bin.
+    float rightArea[kBins];
+    uint32_t rightCount[kBins];
+    Box acc;
+    uint32_t n = 0;
+    for (size_t b = kBins - 1; b > 0; b--) {
+      acc.extend(bins[b].bounds);
+      n += bins[b].count;
+      rightArea[b] = half_area(acc);
+      rightCount[b] = n;
+    }
+    float bestCost = kInfinity;
+    size_t bestSplit = 0;
+    acc.setEmpty();
+    n = 0;
+    for (size_t b = 0; b + 1 < kBins; b++) {
+      acc.extend(bins[b].bounds);
+      n += bins[b].count;
+      if (n == 0 || rightCount[b + 1] == 0) {
+        continue;
+      }
+      const float cost = half_area(acc) * n + rightArea[b + 1] * rightCount[b + 1];
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestSplit = b + 1;
+      }
+    }
+
+    // Leaf cost is count (one box test per primitive); a split costs one node
+    // visit plus the area-weighted primitive tests on each side.
+    const float nodeArea = half_area(bounds);
+    const float splitCost = 1.0f + (nodeArea > 0.0f ? bestCost / nodeArea : (float)task.count);
+    if (bestSplit == 0 || (task.count <= kMaxLeafSize && splitCost >= (float)task.count)) {
+      make_leaf();
+      continue;
+    }
+
+    uint32_t* mid = std::partition(
+        order.data() + task.first, order.data() + task.first + task.count, [&](uint32_t slot) {
+          return bin_of(slot) < bestSplit;
+        });
+    const uint32_t leftCount = (uint32_t)(mid - (order.data() + task.first));
+
+    // Right is pushed first so the left child is built next and lands at nodeIndex + 1.
+    stack.push_back(Task{nodeIndex, task.first + leftCount, task.count - leftCount, task.depth + 1});
+    stack.push_back(Task{kNone, task.first, leftCount, task.depth + 1});
+  }
+
+  std::vector<uint32_t> sorted(order.size());
+  leafBoxes_.resize(order.size());
+  for (size_t k = 0; k < order.size(); k++) {
+    sorted[k] = primitives_[order[k]];
+    leafBoxes_[k] = primBoxes[order[k]];
+  }
+  primitives_.swap(sorted);
+}
+
+void BoxBvh::refit(ConstBoxSoA boxes) {
+  for (size_t k = 0; k < primitives_.size(); k++) {
+    leafBoxes_[k] = load_box(boxes, primitives_[k]);
+  }
+  // Children always come after their parent, so a reverse sweep sees both
+  // children before the node itself.
+  for (size_t i = nodes_.size(); i-- > 0;) {
+    Node& node = nodes_[i];
+    if (node.is_leaf()) {
+      node.bounds.setEmpty();
+      for (uint32_t k = node.rightOrFirst; k < node.rightOrFirst + node.count; k++) {
+        node.bounds.extend(leafBoxes_[k]);
+      }
+    } else {
+      node.bounds = nodes_[i + 1].bounds.merged(nodes_[node.rightOrFirst].bounds);
+    }
+  }
+}
+
+BoxBvh::Hit BoxBvh::raycast(const Eigen::ParametrizedLine<float, 3>& line, float maxT) const {
+  Hit hit;
+  if (nodes_.empty()) {
+    return hit;
+  }
+  const Ray ray{line.origin(), line.direction().cwiseInverse()};
+
+  float best = maxT;
+  uint32_t stack[kMaxDepth];
+  size_t top = 0;
+  uint32_t node = 0;
+  if (ray_enter(ray, nodes_[0].bounds, best) == kInfinity) {
+    return hit;
+  }
+  for (;;) {
+    const Node& n = nodes_[node];
+    if (n.is_leaf()) {
+      for (uint32_t k = n.rightOrFirst; k < n.rightOrFirst + n.count; k++) {
+        const float t = ray_enter(ray, leafBoxes_[k], best);
+        if (t != kInfinity && (t < best || hit.index == kNone)) {
+          best = t;
+          hit.index = primitives_[k];
+          hit.distance = t;
+        }
+      }
+    } else {
+      // Visit the nearer child first; the farther one waits on the stack.
+      uint32_t a = node + 1;
+      uint32_t b = n.rightOrFirst;
+      float ta = ray_enter(ray, nodes_[a].bounds, best);
+      float tb = ray_enter(ray, nodes_[b].bounds, best);
+      if (tb < ta) {
+        std::swap(a, b);
+        std::swap(ta, tb);
+      }
+      if (ta != kInfinity) {
+        if (tb != kInfinity) {
+          stack[top++] = b;
+        }
+        node = a;
+        continue;
+      }
+    }
+    // Pop, skipping subtrees that now start beyond the best hit.
+    for (;;) {
+      if (top == 0) {
+        return hit;
+      }
+      node = stack[--top];
+      if (ray_enter(ray, nodes_[node].bounds, best) != kInfinity) {
+        break;
+      }
+    }
+  }
+}
+
+void BoxBvh::overlap(const Eigen::AlignedBox3f& box, std::vector<uint32_t>& out) const {
+  if (nodes_.empty() || box.isEmpty()) {
+    return;
+  }
+  uint32_t stack[kMaxDepth];
+  size_t top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    const uint32_t node = stack[--top];
+    const Node& n = nodes_[node];
+    if (!n.bounds.intersects(box)) {
+      continue;
+    }
+    if (n.is_leaf()) {
+      for (uint32_t k = n.rightOrFirst; k < n.rightOrFirst + n.count; k++) {
+        if (leafBoxes_[k].intersects(box)) {
+          out.push_back(primitives_[k]);
+        }
+      }
+    } else {
+      stack[top++] = n.rightOrFirst;
+      stack[top++] = node + 1;
+    }
+  }
+}
+
+BoxBvh::Hit BoxBvh::nearest(const Eigen::Vector3f& point, float maxDistance) const {
+  Hit hit;
+  if (nodes_.empty()) {
+    return hit;
+  }
+  // Squared distances throughout; one sqrt for the result.
+  float best = maxDistance < kInfinity ? maxDistance * maxDistance : kInfinity;
+  struct Entry {
+    uint32_t node;
+    float distance2;
+  };
+  Entry stack[kMaxDepth];
+  size_t top = 0;
+  stack[top++] = Entry{0, nodes_[0].bounds.squaredExteriorDistance(point)};
+  while (top > 0) {
+    const Entry e = stack[--top];
+    if (e.distance2 > best) {
+      continue;
+    }
+    const Node& n = nodes_[e.node];
+    if (n.is_leaf()) {
+      for (uint32_t k = n.rightOrFirst; k < n.rightOrFirst + n.count; k++) {
+        const float d2 = leafBoxes_[k].squaredExteriorDistance(point);
+        if (d2 < best || (d2 <= best && hit.index == kNone)) {
+          best = d2;
+          hit.index = primitives_[k];
+        }
+      }
+      continue;
+    }
+    Entry a{e.node + 1, nodes_[e.node + 1].bounds.squaredExteriorDistance(point)};
+    Entry b{n.rightOrFirst, nodes_[n.rightOrFirst].bounds.squaredExteriorDistance(point)};
+    if (b.distance2 < a.distance2) {
+      std::swap(a, b);
+    }
+    // Nearer child on top of the stack.
+    stack[top++] = b;
+    stack[top++] = a;
+  }
+  if (hit) {
+    hit.distance = std::sqrt(best);
+  }
+  return hit;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "bounds.h"
+
+// Bounding volume hierarchy over axis-aligned boxes (typically one per scene
+// object) for ray picking, box overlap and nearest-object queries.
+//
+// Built top-down with binned SAH: each node sorts its primitives' centroids into
+// kBins bins along the widest centroid axis and splits at the bin boundary with
+// the lowest surface-area cost, or becomes a leaf when splitting would not pay.
+// Nodes are stored flat in depth-first order, so an interior node's left child
+// is the next node and descending walks forward through memory; each node is
+// 32 bytes, two per cache line. Leaf primitives are stored contiguously with
+// their boxes in leaf order.
+class BoxBvh {
+ public:
+  static constexpr uint32_t kNone = 0xffffffffu;
+  static constexpr size_t kBins = 16;
+  static constexpr size_t kMaxLeafSize = 8;
+  static constexpr size_t kMaxDepth = 64;
+
+  struct Node {
+    Eigen::AlignedBox3f bounds;
+    uint32_t rightOrFirst;  // interior: right child node; leaf: first slot in primitives()
+    uint32_t count;         // leaf primitive count, 0 for interior nodes
+
+    bool is_leaf() const { return count != 0; }
+  };
+
+  struct Hit {
+    uint32_t index = kNone;  // box index passed to build(), kNone when nothing was found
+    float distance = 0.0f;   // ray parameter t, or point-to-box distance
+
+    explicit operator bool() const { return index != kNone; }
+  };
+
+  BoxBvh() = default;
+  BoxBvh(ConstBoxSoA boxes, size_t count) { build(boxes, count); }
+
+  // Adopts a tree built elsewhere (see build_lbvh in lbvh.h) in the layout
+  // above: depth-first nodes, leaves indexing `primitives`/`leafBoxes` slots,
+  // depth below kMaxDepth.
+  BoxBvh(
+      std::vector<Node> nodes,
+      std::vector<uint32_t> primitives,
+      std::vector<Eigen::AlignedBox3f> leafBoxes,
+      size_t boxCount)
+      : nodes_(std::move(nodes)),
+        primitives_(std::move(primitives)),
+        leafBoxes_(std::move(leafBoxes)),
+        boxCount_(boxCount) {}
+
+  // Boxes that are empty (min > max on some axis) at build time are left out
+  // and never reported; rebuild if they become valid later.
+  void build(ConstBoxSoA boxes, size_t count);
+
+  // Updates every node's bounds for moved boxes (same count and order as the
+  // last build) while keeping the tree topology. O(n); query cost creeps up as
+  // objects drift from their build-time layout, so rebuild now and then.
+  void refit(ConstBoxSoA boxes);
+
+  // First box the ray enters with t in [0, maxT]; t is in units of
+  // ray.direction(), and a ray starting inside a box hits it at t = 0.
+  Hit raycast(const Eigen::ParametrizedLine<float, 3>& ray, float maxT) const;
+
+  // Appends the index of every box that intersects `box` (touching counts).
+  void overlap(const Eigen::AlignedBox3f& box, std::vector<uint32_t>& out) const;
+
+  // Box closest to `point` (distance 0 when inside) within maxDistance.
+  Hit nearest(const Eigen::Vector3f& point, float maxDistance) const;
+
+  size_t size() const { return boxCount_; }
+  const std::vector<Node>& nodes() const { return nodes_; }
+  const std::vector<uint32_t>& primitives() const { return primitives_; }
+
+ private:
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> primitives_;              // box index per leaf slot
+  std::vector<Eigen::AlignedBox3f> leafBoxes_;    // box per leaf slot
+  size_t boxCount_ = 0;
+};
@@ -0,0 +1,11 @@
+#include "dual_quat.h"
+
+void dual_quats_from_transforms(const float* matrices, size_t count, float* out) {
+  for (size_t i = 0; i < count; i++) {
+    const Eigen::Map<const Eigen::Matrix4f> m(matrices + i * 16);
+    const DualQuaternion dq(Eigen::Quaternionf(Eigen::Matrix3f(m.topLeftCorner<3, 3>())),
+                            Eigen::Vector3f(m.topRightCorner<3, 1>()));
+    Eigen::Map<Eigen::Vector4f>(out + i * kDualQuatFloats) = dq.real.coeffs();
+    Eigen::Map<Eigen::Vector4f>(out + i * kDualQuatFloats + 4) = dq.dual.coeffs();
+  }
+}
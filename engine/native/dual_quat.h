@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+
+#include <Eigen/Geometry>
+
+// Unit dual quaternion real + eps * dual for a rigid transform: `real` is the
+// rotation and dual = 0.5 * (0, t) * real. Built on Eigen::Quaternionf, so the
+// products go through Eigen's quaternion product (vectorized in
+// arch/Geometry_SIMD.h where the target has SSE / NEON).
+struct DualQuaternion {
+  Eigen::Quaternionf real;
+  Eigen::Quaternionf dual;
+
+  DualQuaternion() : real(Eigen::Quaternionf::Identity()), dual(0.0f, 0.0f, 0.0f, 0.0f) {}
+  DualQuaternion(const Eigen::Quaternionf& r, const Eigen::Quaternionf& d) : real(r), dual(d) {}
+  // Rotation q (unit) followed by translation t.
+  DualQuaternion(const Eigen::Quaternionf& q, const Eigen::Vector3f& t)
+      : real(q), dual(Eigen::Quaternionf(0.0f, t.x(), t.y(), t.z()) * q) {
+    dual.coeffs() *= 0.5f;
+  }
+  // The rigid part of an affine transform whose linear part is a rotation
+  // (any scale or shear is not representable and gets folded into the
+  // Quaternion(Matrix3) conversion).
+  explicit DualQuaternion(const Eigen::Affine3f& m)
+      : DualQuaternion(Eigen::Quaternionf(m.linear()), Eigen::Vector3f(m.translation())) {}
+
+  // this * other applies `other` first, like Transform and Quaternion products.
+  DualQuaternion operator*(const DualQuaternion& other) const {
+    Eigen::Quaternionf d = real * other.dual;
+    d.coeffs() += (dual * other.real).coeffs();
+    return DualQuaternion(real * other.real, d);
+  }
+
+  Eigen::Vector3f translation() const { return 2.0f * (dual * real.conjugate()).vec(); }
+
+  // Divides both parts by |real|, which makes a blended dual quaternion a
+  // rigid transform again (the DLB step of dual-quaternion skinning).
+  DualQuaternion normalized() const {
+    const float inv = 1.0f / real.norm();
+    return DualQuaternion(Eigen::Quaternionf(real.coeffs() * inv), Eigen::Quaternionf(dual.coeffs() * inv));
+  }
+
+  Eigen::Vector3f transform_point(const Eigen::Vector3f& p) const { return real * p + translation(); }
+
+  Eigen::Affine3f to_transform() const {
+    Eigen::Affine3f m = Eigen::Affine3f::Identity();
+    m.linear() = real.toRotationMatrix();
+    m.translation() = translation();
+    return m;
+  }
+};
+
+// Floats per dual quaternion in the packed layout: real xyzw, then dual xyzw
+// (Quaternion::coeffs() order).
+constexpr size_t kDualQuatFloats = 8;
+
+// out[8 * i ...] = DualQuaternion(bone i) for `count` column-major 4x4
+// matrices (16 floats each, e.g. Skeleton.boneMatrices). Rotations that are
+// antipodal to the previous bone's are not flipped here; the skinning kernel
+// resolves the sign per vertex.
+void dual_quats_from_transforms(const float* matrices, size_t count, float* out);
+
+inline void dual_quats_from_transforms(const Eigen::Affine3f* bones, size_t count, DualQuaternion* out) {
+  static_assert(sizeof(Eigen::Affine3f) == 16 * sizeof(float), "Affine3f is a bare 4x4 matrix");
+  static_assert(sizeof(DualQuaternion) == kDualQuatFloats * sizeof(float), "DualQuaternion is real then dual");
+  dual_quats_from_transforms(bones->data(), count, out->real.coeffs().data());
+}
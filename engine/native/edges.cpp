@@ -0,0 +1,164 @@
+#include "edges.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "vertex_weld.h"
+
+namespace {
+
+using weld::kEmpty;
+using weld::mix64;
+using weld::table_capacity;
+using weld::VertexWelder;
+
+// Directed edge key (welded id pair) -> edge record index (linear probing).
+class EdgeTable {
+ public:
+  explicit EdgeTable(size_t expected)
+      : mask_(table_capacity(expected) - 1), keys_(mask_ + 1), vals_(mask_ + 1, kEmpty) {}
+
+  // Returns the slot value for `key`, or kEmpty if absent.
+  uint32_t find(uint64_t key) const {
+    for (size_t slot = mix64(key) & mask_;; slot = (slot + 1) & mask_) {
+      if (vals_[slot] == kEmpty) return kEmpty;
+      if (keys_[slot] == key) return vals_[slot];
+    }
+  }
+
+  void insert(uint64_t key, uint32_t value) {
+    size_t slot = mix64(key) & mask_;
+    while (vals_[slot] != kEmpty) {
+      slot = (slot + 1) & mask_;
+    }
+    keys_[slot] = key;
+    vals_[slot] = value;
+  }
+
+ private:
+  size_t mask_;
+  std::vector<uint64_t> keys_;
+  std::vector<uint32_t> vals_;
+};
+
+struct EdgeRecord {
+  uint32_t index0;
+  uint32_t index1;
+  float nx, ny, nz;
+  bool live;  // false once the sibling edge was seen (Three sets edgeData[hash] = null)
+};
+
+int64_t quantize(float v) {
+  // Math.round(v * 10^precisionPoints)
+  return (int64_t)std::floor((double)v * 1e4 + 0.5);
+}
+
+void push_point(std::vector<float>& out, const float* p) {
+  out.push_back(p[0]);
+  out.push_back(p[1]);
+  out.push_back(p[2]);
+}
+
+}  // namespace
+
+std::vector<float> edges_geometry(
+    const float* positions,
+    size_t vertexCount,
+    const uint32_t* indices,
+    size_t indexCount,
+    float thresholdAngleDeg) {
+  std::vector<float> out;
+
+  const bool indexed = indices != nullptr && indexCount > 0;
+  const size_t count = indexed ? indexCount : vertexCount;
+  const size_t triangleCount = count / 3;
+  if (triangleCount == 0) {
+    return out;
+  }
+
+  const double pi = 3.14159265358979323846;
+  const float thresholdDot = (float)std::cos(pi / 180.0 * thresholdAngleDeg);
+
+  VertexWelder welder(indexed ? std::min(vertexCount, indexCount) : vertexCount);
+  EdgeTable table(triangleCount * 3);
+  std::vector<EdgeRecord> edges;
+  edges.reserve(triangleCount * 3 / 2 + 1);
+
+  for (size_t t = 0; t < triangleCount; t++) {
+    uint32_t idx[3];
+    bool valid = true;
+    for (int k = 0; k < 3; k++) {
+      idx[k] = indexed ? indices[t * 3 + k] : (uint32_t)(t * 3 + k);
+      valid = valid && idx[k] < vertexCount;
+    }
+    if (!valid) {
+      continue;
+    }
+
+    const float* a = positions + (size_t)idx[0] * 3;
+    const float* b = positions + (size_t)idx[1] * 3;
+    const float* c = positions + (size_t)idx[2] * 3;
+    const float* v[3] = {a, b, c};
+
+    // Triangle.getNormal: (c - b) x (a - b), normalized
+    const float cbx = c[0] - b[0], cby = c[1] - b[1], cbz = c[2] - b[2];
+    const float abx = a[0] - b[0], aby = a[1] - b[1], abz = a[2] - b[2];
+    float nx = cby * abz - cbz * aby;
+    float ny = cbz * abx - cbx * abz;
+    float nz = cbx * aby - cby * abx;
+    const float len2 = nx * nx + ny * ny + nz * nz;
+    if (len2 > 0.0f) {
+      const float inv = 1.0f / std::sqrt(len2);
+      nx *= inv;
+      ny *= inv;
+      nz *= inv;
+    } else {
+      nx = ny = nz = 0.0f;
+    }
+
+    uint32_t ids[3];
+    for (int k = 0; k < 3; k++) {
+      ids[k] = welder.id_of(quantize(v[k][0]), quantize(v[k][1]), quantize(v[k][2]));
+    }
+
+    // skip degenerate triangles
+    if (ids[0] == ids[1] || ids[1] == ids[2] || ids[2] == ids[0]) {
+      continue;
+    }
+
+    for (int j = 0; j < 3; j++) {
+      const int jNext = (j + 1) % 3;
+      const uint64_t key = ((uint64_t)ids[j] << 32) | ids[jNext];
+      const uint64_t reverseKey = ((uint64_t)ids[jNext] << 32) | ids[j];
+
+      const uint32_t sibling = table.find(reverseKey);
+      if (sibling != kEmpty && edges[sibling].live) {
+        // Found the sibling edge: keep it if the faces meet at a sharp enough angle.
+        const EdgeRecord& e = edges[sibling];
+        if (nx * e.nx + ny * e.ny + nz * e.nz <= thresholdDot) {
+          push_point(out, v[j]);
+          push_point(out, v[jNext]);
+        }
+        edges[sibling].live = false;
+      } else if (table.find(key) == kEmpty) {
+        table.insert(key, (uint32_t)edges.size());
+        edges.push_back(EdgeRecord{idx[j], idx[jNext], nx, ny, nz, true});
+      }
+    }
+  }
+
+  // Remaining unmatched (boundary) edges, in insertion order.
+  for (const EdgeRecord& e : edges) {
+    if (e.live) {
+      push_point(out, positions + (size_t)e.index0 * 3);
+      push_point(out, positions + (size_t)e.index1 * 3);
+    }
+  }
+
+  return out;
+}
+
+std::vector<float> edges_geometry(const MeshDataCpp& mesh, float thresholdAngleDeg) {
+  return edges_geometry(
+      mesh.vertices.data(), mesh.vertices.size() / 3, mesh.indices.data(), mesh.indices.size(), thresholdAngleDeg);
+}
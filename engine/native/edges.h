@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "geometry_lib.h"
+
+// Three-style EdgesGeometry: emits every edge whose two adjacent faces meet at
+// more than `thresholdAngleDeg` degrees, plus every boundary edge, as line
+// segment positions (xyz xyz per edge).
+//
+// Vertices are welded by position quantized to 1e-4 (Three's precisionPoints = 4),
+// and both the welded vertex ids and the directed edges live in open-addressing
+// hash tables, so no per-edge allocation happens. `indices` may be null/empty,
+// in which case `positions` is treated as a non-indexed triangle soup.
+std::vector<float> edges_geometry(
+    const float* positions,
+    size_t vertexCount,
+    const uint32_t* indices,
+    size_t indexCount,
+    float thresholdAngleDeg);
+
+std::vector<float> edges_geometry(const MeshDataCpp& mesh, float thresholdAngleDeg);
@@ -0,0 +1,198 @@
+#include "euler_batch.h"
+
+#include "simd.h"
+#include "simd_math.h"
+
+namespace {
+
+using simd::vfloat;
+
+inline vfloat load_lanes(const float* p, size_t i, size_t n) {
+  return n == simd::kWidth ? simd::load(p + i) : simd::load_n(p + i, n);
+}
+
+inline void store_lanes(float* p, size_t i, size_t n, vfloat v) {
+  if (n == simd::kWidth) {
+    simd::store(p + i, v);
+  } else {
+    simd::store_n(p + i, v, n);
+  }
+}
+
+// Rotation matrix coefficients of a unit quaternion, computed on demand:
+// eulerAngles() reads only 5 to 7 of the 9.
+struct QuatMatrix {
+  vfloat x, y, z, w;
+
+  template <int R, int C>
+  vfloat coeff() const {
+    using simd::fmadd;
+    const vfloat one = simd::splat(1.0f);
+    const vfloat two = simd::splat(2.0f);
+    const vfloat q[3] = {x, y, z};
+    if (R == C) {
+      // 1 - 2 (q_a^2 + q_b^2) over the other two axes
+      const vfloat a = q[(R + 1) % 3], b = q[(R + 2) % 3];
+      return one - two * fmadd(a, a, b * b);
+    }
+    // Off-diagonal: 2 (q_r q_c -+ w q_k), k the remaining axis; + when (R, C)
+    // is an odd (anticyclic) pair.
+    const vfloat qq = q[R] * q[C];
+    const vfloat wq = w * q[3 - R - C];
+    return two * ((C == (R + 1) % 3) ? qq - wq : qq + wq);
+  }
+};
+
+template <int A0, int A1, int A2>
+struct EulerAxes {
+  static_assert(A0 >= 0 && A0 < 3 && A1 >= 0 && A1 < 3 && A2 >= 0 && A2 < 3, "axes are 0, 1 or 2");
+  static_assert(A1 != A0 && A1 != A2, "the middle axis must differ from both others");
+
+  // Index bookkeeping of MatrixBase::eulerAngles.
+  static constexpr bool kOdd = (A0 + 1) % 3 != A1;
+  static constexpr int I = A0;
+  static constexpr int J = (A0 + 1 + (kOdd ? 1 : 0)) % 3;
+  static constexpr int K = (A0 + 2 - (kOdd ? 1 : 0)) % 3;
+};
+
+template <int A0, int A1, int A2>
+inline void to_euler(const QuatMatrix& m, vfloat& e0, vfloat& e1, vfloat& e2) {
+  using namespace simd;
+  typedef EulerAxes<A0, A1, A2> Axes;
+  constexpr int I = Axes::I, J = Axes::J, K = Axes::K;
+  const vfloat zero = splat(0.0f);
+  const vfloat pi = splat(3.14159265358979f);
+
+  // res[0] = atan2(Y, X). Its sine and cosine come straight from (Y, X)
+  // rather than sin/cos of the angle; the pi shift negates both.
+  const vfloat Y = A0 == A2 ? m.coeff<J, I>() : m.coeff<J, K>();
+  const vfloat X = A0 == A2 ? m.coeff<K, I>() : m.coeff<K, K>();
+  vfloat a0 = simd::atan2(Y, X);
+  const vmask flip = Axes::kOdd ? a0 < zero : a0 > zero;
+  a0 = select(flip, select(a0 > zero, a0 - pi, a0 + pi), a0);
+
+  const vfloat r = sqrt(fmadd(X, X, Y * Y));
+  const vmask degenerate = r <= splat(0.0f);
+  const vfloat invR = splat(1.0f) / select(degenerate, splat(1.0f), r);
+  const vfloat sign = select(flip, splat(-1.0f), splat(1.0f));
+  // With Y = X = 0 the angle is 0 or +-pi depending on the zeros' signs.
+  const vfloat c1Degenerate = select(abs(a0) > splat(1.5707963f), splat(-1.0f), splat(1.0f));
+  const vfloat s1 = select(degenerate, zero, Y * invR * sign);
+  const vfloat c1 = select(degenerate, c1Degenerate, X * invR * sign);
+
+  vfloat a1, a2;
+  if (A0 == A2) {
+    const vfloat s2 = r;  // |(m(j,i), m(k,i))|
+    a1 = simd::atan2(s2, m.coeff<I, I>());
+    a1 = select(flip, -a1, a1);
+    a2 = simd::atan2(c1 * m.coeff<J, K>() - s1 * m.coeff<K, K>(), c1 * m.coeff<J, J>() - s1 * m.coeff<K, J>());
+  } else {
+    const vfloat mii = m.coeff<I, I>(), mij = m.coeff<I, J>();
+    const vfloat c2 = sqrt(fmadd(mii, mii, mij * mij));
+    a1 = simd::atan2(-m.coeff<I, K>(), select(flip, -c2, c2));
+    a2 = simd::atan2(s1 * m.coeff<K, I>() - c1 * m.coeff<J, I>(), c1 * m.coeff<J, J>() - s1 * m.coeff<K, J>());
+  }
+
+  if (!Axes::kOdd) {
+    a0 = -a0;
+    a1 = -a1;
+    a2 = -a2;
+  }
+  e0 = a0;
+  e1 = a1;
+  e2 = a2;
+}
+
+struct QuatLanes {
+  vfloat v[3];  // x, y, z
+  vfloat w;
+};
+
+// q * (c + s * unit(A)), the Hamilton product with an axis rotation:
+// w' = w c - s q_A, v' = c v + s w unit(A) + s (v x unit(A)).
+template <int A>
+inline QuatLanes rotate_about(const QuatLanes& q, vfloat s, vfloat c) {
+  using simd::fmadd;
+  constexpr int B = (A + 1) % 3, C = (A + 2) % 3;
+  QuatLanes r;
+  r.w = fmadd(q.w, c, -(q.v[A] * s));
+  r.v[A] = fmadd(q.v[A], c, q.w * s);
+  // (v x e_A)_B = v_C, (v x e_A)_C = -v_B
+  r.v[B] = fmadd(q.v[B], c, q.v[C] * s);
+  r.v[C] = fmadd(q.v[C], c, -(q.v[B] * s));
+  return r;
+}
+
+}  // namespace
+
+template <int A0, int A1, int A2>
+void quat_to_euler_batch(ConstQuatSoA q, EulerSoA out, size_t count) {
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = count - i < simd::kWidth ? count - i : simd::kWidth;
+    const QuatMatrix m{load_lanes(q.x, i, n), load_lanes(q.y, i, n), load_lanes(q.z, i, n), load_lanes(q.w, i, n)};
+    vfloat e0, e1, e2;
+    to_euler<A0, A1, A2>(m, e0, e1, e2);
+    store_lanes(out.e0, i, n, e0);
+    store_lanes(out.e1, i, n, e1);
+    store_lanes(out.e2, i, n, e2);
+  }
+}
+
+template <int A0, int A1, int A2>
+void euler_to_quat_batch(ConstEulerSoA e, QuatSoA out, size_t count) {
+  static_assert(A1 != A0 && A1 != A2, "the middle axis must differ from both others");
+  const vfloat half = simd::splat(0.5f);
+  const vfloat zero = simd::splat(0.0f);
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = count - i < simd::kWidth ? count - i : simd::kWidth;
+    vfloat s0, c0, s1, c1, s2, c2;
+    simd::sincos(load_lanes(e.e0, i, n) * half, s0, c0);
+    simd::sincos(load_lanes(e.e1, i, n) * half, s1, c1);
+    simd::sincos(load_lanes(e.e2, i, n) * half, s2, c2);
+
+    QuatLanes q;
+    q.w = c0;
+    q.v[0] = q.v[1] = q.v[2] = zero;
+    q.v[A0] = s0;
+    q = rotate_about<A1>(q, s1, c1);
+    q = rotate_about<A2>(q, s2, c2);
+
+    store_lanes(out.x, i, n, q.v[0]);
+    store_lanes(out.y, i, n, q.v[1]);
+    store_lanes(out.z, i, n, q.v[2]);
+    store_lanes(out.w, i, n, q.w);
+  }
+}
+
+// The 12 conventions eulerAngles() accepts: 6 Tait-Bryan, 6 proper Euler.
+#define GEOMETRY_EULER_CONVENTIONS(X) \
+  X(0, 1, 2) X(0, 2, 1) X(1, 0, 2) X(1, 2, 0) X(2, 0, 1) X(2, 1, 0) \
+  X(0, 1, 0) X(0, 2, 0) X(1, 0, 1) X(1, 2, 1) X(2, 0, 2) X(2, 1, 2)
+
+#define GEOMETRY_EULER_INSTANTIATE(A0, A1, A2)                                                   \
+  template void quat_to_euler_batch<A0, A1, A2>(ConstQuatSoA, EulerSoA, size_t);                 \
+  template void euler_to_quat_batch<A0, A1, A2>(ConstEulerSoA, QuatSoA, size_t);
+GEOMETRY_EULER_CONVENTIONS(GEOMETRY_EULER_INSTANTIATE)
+#undef GEOMETRY_EULER_INSTANTIATE
+
+bool quat_to_euler_batch(int a0, int a1, int a2, ConstQuatSoA q, EulerSoA out, size_t count) {
+#define GEOMETRY_EULER_DISPATCH(A0, A1, A2)        \
+  if (a0 == A0 && a1 == A1 && a2 == A2) {          \
+    quat_to_euler_batch<A0, A1, A2>(q, out, count); \
+    return true;                                   \
+  }
+  GEOMETRY_EULER_CONVENTIONS(GEOMETRY_EULER_DISPATCH)
+#undef GEOMETRY_EULER_DISPATCH
+  return false;
+}
+
+bool euler_to_quat_batch(int a0, int a1, int a2, ConstEulerSoA e, QuatSoA out, size_t count) {
+#define GEOMETRY_EULER_DISPATCH(A0, A1, A2)        \
+  if (a0 == A0 && a1 == A1 && a2 == A2) {          \
+    euler_to_quat_batch<A0, A1, A2>(e, out, count); \
+    return true;                                   \
+  }
+  GEOMETRY_EULER_CONVENTIONS(GEOMETRY_EULER_DISPATCH)
+#undef GEOMETRY_EULER_DISPATCH
+  return false;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+
+#include "quat_batch.h"
+
+// Batched Euler-angle conversions for whole animation tracks, over SoA
+// quaternions (see quat_batch.h) and SoA angle triples.
+//
+// A convention (A0, A1, A2) is three axis indices in {0, 1, 2} with A1 != A0
+// and A1 != A2, exactly as MatrixBase::eulerAngles(a0, a1, a2) takes them: the
+// angles e satisfy
+//   R == AngleAxis(e0, unit(A0)) * AngleAxis(e1, unit(A1)) * AngleAxis(e2, unit(A2)).
+// The kernels are templated on the convention so all the index arithmetic of
+// eulerAngles() folds away at compile time; the int overloads dispatch to the
+// 12 instantiations and return false for an invalid triple.
+
+struct EulerSoA {
+  float* e0;
+  float* e1;
+  float* e2;
+};
+
+struct ConstEulerSoA {
+  const float* e0;
+  const float* e1;
+  const float* e2;
+
+  ConstEulerSoA(const float* e0_, const float* e1_, const float* e2_) : e0(e0_), e1(e1_), e2(e2_) {}
+  ConstEulerSoA(const EulerSoA& e) : e0(e.e0), e1(e.e1), e2(e.e2) {}
+};
+
+// Planar block [e0..., e1..., e2...] as used by the JS bindings.
+inline EulerSoA euler_soa_planar(float* block, size_t count) {
+  return EulerSoA{block, block + count, block + 2 * count};
+}
+
+inline ConstEulerSoA euler_soa_planar(const float* block, size_t count) {
+  return ConstEulerSoA(block, block + count, block + 2 * count);
+}
+
+// out[i] = q[i].toRotationMatrix().eulerAngles(A0, A1, A2), including its
+// choice of solution (e0 in [0, pi]) and its gimbal-lock handling, with
+// simd::atan2 in place of std::atan2; unit quaternions are assumed. Over
+// random rotations the angles stay within ~3e-5 rad of Eigen's float result
+// (the worst cases sit next to gimbal lock, where the first and last angles
+// are ill-conditioned) and rebuild the rotation to ~1e-6. Exactly at gimbal
+// lock either result may come out; both describe the same rotation.
+template <int A0, int A1, int A2>
+void quat_to_euler_batch(ConstQuatSoA q, EulerSoA out, size_t count);
+
+// out[i] = AngleAxis(e0, A0) * AngleAxis(e1, A1) * AngleAxis(e2, A2) as a
+// quaternion (no sign canonicalization), using simd::sincos on the half angles.
+template <int A0, int A1, int A2>
+void euler_to_quat_batch(ConstEulerSoA e, QuatSoA out, size_t count);
+
+bool quat_to_euler_batch(int a0, int a1, int a2, ConstQuatSoA q, EulerSoA out, size_t count);
+bool euler_to_quat_batch(int a0, int a1, int a2, ConstEulerSoA e, QuatSoA out, size_t count);
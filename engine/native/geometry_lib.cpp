@@ -1,6 +1,73 @@
 #include "geometry_lib.h"
 
-static void build_plane(
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+// Vertex ids must fit in uint32 and every array in size_t (32-bit on wasm).
+bool mesh_size_ok(uint64_t vertexCount, uint64_t indexCount) {
+  const uint64_t maxElements = (uint64_t)(SIZE_MAX / sizeof(float));
+  return vertexCount <= (uint64_t)0xffffffffu + 1 && vertexCount * 3 <= maxElements && indexCount <= maxElements;
+}
+
+// Quad grid indices over `cols` x `rows` cells whose (cols + 1) x (rows + 1)
+// vertices start at `base`, row-major; Three's (a, b, d), (b, c, d) split.
+void write_grid_indices(MeshDataCpp& out, MeshCursor& cursor, uint32_t base, uint32_t cols, uint32_t rows) {
+  const uint32_t stride = cols + 1;
+  uint32_t* idx = out.indices.data() + cursor.index;
+  for (uint32_t iy = 0; iy < rows; iy++) {
+    for (uint32_t ix = 0; ix < cols; ix++) {
+      const uint32_t a = base + ix + stride * iy;
+      const uint32_t b = base + ix + stride * (iy + 1);
+      const uint32_t c = base + (ix + 1) + stride * (iy + 1);
+      const uint32_t d = base + (ix + 1) + stride * iy;
+
+      idx[0] = a;
+      idx[1] = b;
+      idx[2] = d;
+      idx[3] = b;
+      idx[4] = c;
+      idx[5] = d;
+      idx += 6;
+    }
+  }
+  cursor.index += (size_t)rows * cols * 6;
+}
+
+void write_vertex(MeshDataCpp& out, MeshCursor& cursor, float x, float y, float z, float s, float t) {
+  float* p = out.vertices.data() + (size_t)cursor.vertex * 3;
+  float* n = out.normals.data() + (size_t)cursor.vertex * 3;
+  float* uv = out.uvs.data() + (size_t)cursor.vertex * 2;
+  p[0] = x;
+  p[1] = y;
+  p[2] = z;
+  n[0] = 0.0f;
+  n[1] = 0.0f;
+  n[2] = 1.0f;
+  uv[0] = s;
+  uv[1] = t;
+  cursor.vertex++;
+}
+
+}  // namespace
+
+void resize_mesh(MeshDataCpp& mesh, size_t vertexCount, size_t indexCount) {
+  mesh.vertices.resize(vertexCount * 3);
+  mesh.normals.resize(vertexCount * 3);
+  mesh.uvs.resize(vertexCount * 2);
+  mesh.indices.resize(indexCount);
+}
+
+uint64_t plane_vertex_count(uint32_t gridX, uint32_t gridY) {
+  return ((uint64_t)gridX + 1) * ((uint64_t)gridY + 1);
+}
+
+uint64_t plane_index_count(uint32_t gridX, uint32_t gridY) {
+  return (uint64_t)gridX * (uint64_t)gridY * 6;
+}
+
+void build_plane(
     int u,
     int v,
     int w,
@@ -9,12 +76,11 @@ static void build_plane(
     float width,
     float height,
     float depth,
-    int gridX,
-    int gridY,
-    uint32_t materialIndex,
+    float normalDir,
+    uint32_t gridX,
+    uint32_t gridY,
     MeshDataCpp& out,
-    uint32_t& numberOfVertices,
-    uint32_t& groupStart) {
+    MeshCursor& cursor) {
   const float segmentWidth = width / (float)gridX;
   const float segmentHeight = height / (float)gridY;
 
@@ -22,94 +88,197 @@ static void build_plane(
   const float heightHalf = height / 2.0f;
   const float depthHalf = depth / 2.0f;
 
-  const uint32_t gridX1 = (uint32_t)(gridX + 1);
-  const uint32_t gridY1 = (uint32_t)(gridY + 1);
+  const uint32_t gridX1 = gridX + 1;
+  const uint32_t gridY1 = gridY + 1;
+  const uint32_t base = (uint32_t)cursor.vertex;
 
-  uint32_t vertexCounter = 0;
-  uint32_t groupCount = 0;
+  float* p = out.vertices.data() + (size_t)base * 3;
+  float* n = out.normals.data() + (size_t)base * 3;
+  float* uv = out.uvs.data() + (size_t)base * 2;
 
-  float vec[3] = {0, 0, 0};
+  float normal[3] = {0, 0, 0};
+  normal[w] = normalDir;
 
   // vertices, normals, uvs
+  float vec[3] = {0, 0, 0};
+  vec[w] = depthHalf;
   for (uint32_t iy = 0; iy < gridY1; iy++) {
     const float y = (float)iy * segmentHeight - heightHalf;
+    const float t = 1.0f - ((float)iy / (float)gridY);
+    vec[v] = y * vdir;
     for (uint32_t ix = 0; ix < gridX1; ix++) {
       const float x = (float)ix * segmentWidth - widthHalf;
-
       vec[u] = x * udir;
-      vec[v] = y * vdir;
-      vec[w] = depthHalf;
-      out.vertices.push_back(vec[0]);
-      out.vertices.push_back(vec[1]);
-      out.vertices.push_back(vec[2]);
-
-      vec[u] = 0;
-      vec[v] = 0;
-      vec[w] = depth > 0 ? 1.0f : -1.0f;
-      out.normals.push_back(vec[0]);
-      out.normals.push_back(vec[1]);
-      out.normals.push_back(vec[2]);
-
-      out.uvs.push_back((float)ix / (float)gridX);
-      out.uvs.push_back(1.0f - ((float)iy / (float)gridY));
-
-      vertexCounter += 1;
-    }
-  }
 
-  // indices
-  for (uint32_t iy = 0; iy < (uint32_t)gridY; iy++) {
-    for (uint32_t ix = 0; ix < (uint32_t)gridX; ix++) {
-      const uint32_t a = numberOfVertices + ix + gridX1 * iy;
-      const uint32_t b = numberOfVertices + ix + gridX1 * (iy + 1);
-      const uint32_t c = numberOfVertices + (ix + 1) + gridX1 * (iy + 1);
-      const uint32_t d = numberOfVertices + (ix + 1) + gridX1 * iy;
-
-      out.indices.push_back(a);
-      out.indices.push_back(b);
-      out.indices.push_back(d);
-      out.indices.push_back(b);
-      out.indices.push_back(c);
-      out.indices.push_back(d);
-
-      groupCount += 6;
+      p[0] = vec[0];
+      p[1] = vec[1];
+      p[2] = vec[2];
+      n[0] = normal[0];
+      n[1] = normal[1];
+      n[2] = normal[2];
+      uv[0] = (float)ix / (float)gridX;
+      uv[1] = t;
+      p += 3;
+      n += 3;
+      uv += 2;
     }
   }
+  cursor.vertex += (size_t)gridX1 * gridY1;
 
-  MeshDataCpp::Group g;
-  g.start = groupStart;
-  g.count = groupCount;
-  g.materialIndex = materialIndex;
-  out.groups.push_back(g);
-
-  groupStart += groupCount;
-  numberOfVertices += vertexCounter;
+  // indices
+  write_grid_indices(out, cursor, base, gridX, gridY);
 }
 
 MeshDataCpp make_box(float w, float h, float d) {
   MeshDataCpp out;
 
   // True parity target for the non-segmented box: 24 vertices, 36 indices, per-face normals/uvs/groups.
-  const int widthSegments = 1;
-  const int heightSegments = 1;
-  const int depthSegments = 1;
+  const uint32_t widthSegments = 1;
+  const uint32_t heightSegments = 1;
+  const uint32_t depthSegments = 1;
 
-  uint32_t numberOfVertices = 0;
-  uint32_t groupStart = 0;
+  resize_mesh(
+      out,
+      (size_t)2 * (plane_vertex_count(depthSegments, heightSegments) + plane_vertex_count(widthSegments, depthSegments) +
+           plane_vertex_count(widthSegments, heightSegments)),
+      (size_t)2 * (plane_index_count(depthSegments, heightSegments) + plane_index_count(widthSegments, depthSegments) +
+           plane_index_count(widthSegments, heightSegments)));
+
+  MeshCursor cursor;
+  auto face = [&](int u, int v, int axis, float udir, float vdir, float width, float height, float depth,
+                  uint32_t gridX, uint32_t gridY, uint32_t materialIndex) {
+    const size_t start = cursor.index;
+    build_plane(u, v, axis, udir, vdir, width, height, depth, depth > 0 ? 1.0f : -1.0f, gridX, gridY, out, cursor);
+    out.groups.push_back(MeshDataCpp::Group{(uint32_t)start, (uint32_t)(cursor.index - start), materialIndex});
+  };
 
   // Mirror Three's build order.
   // px
-  build_plane(2, 1, 0, -1.0f, -1.0f, d, h, w, depthSegments, heightSegments, 0, out, numberOfVertices, groupStart);
+  face(2, 1, 0, -1.0f, -1.0f, d, h, w, depthSegments, heightSegments, 0);
   // nx
-  build_plane(2, 1, 0,  1.0f, -1.0f, d, h, -w, depthSegments, heightSegments, 1, out, numberOfVertices, groupStart);
+  face(2, 1, 0,  1.0f, -1.0f, d, h, -w, depthSegments, heightSegments, 1);
   // py
-  build_plane(0, 2, 1,  1.0f,  1.0f, w, d, h, widthSegments, depthSegments, 2, out, numberOfVertices, groupStart);
+  face(0, 2, 1,  1.0f,  1.0f, w, d, h, widthSegments, depthSegments, 2);
   // ny
-  build_plane(0, 2, 1,  1.0f, -1.0f, w, d, -h, widthSegments, depthSegments, 3, out, numberOfVertices, groupStart);
+  face(0, 2, 1,  1.0f, -1.0f, w, d, -h, widthSegments, depthSegments, 3);
   // pz
-  build_plane(0, 1, 2,  1.0f, -1.0f, w, h, d, widthSegments, heightSegments, 4, out, numberOfVertices, groupStart);
+  face(0, 1, 2,  1.0f, -1.0f, w, h, d, widthSegments, heightSegments, 4);
   // nz
-  build_plane(0, 1, 2, -1.0f, -1.0f, w, h, -d, widthSegments, heightSegments, 5, out, numberOfVertices, groupStart);
+  face(0, 1, 2, -1.0f, -1.0f, w, h, -d, widthSegments, heightSegments, 5);
+
+  return out;
+}
+
+MeshDataCpp make_plane(float width, float height, uint32_t widthSegments, uint32_t heightSegments) {
+  MeshDataCpp out;
+  const uint32_t gridX = widthSegments > 0 ? widthSegments : 1;
+  const uint32_t gridY = heightSegments > 0 ? heightSegments : 1;
+  if (!mesh_size_ok(plane_vertex_count(gridX, gridY), plane_index_count(gridX, gridY))) {
+    return out;
+  }
+
+  resize_mesh(out, (size_t)plane_vertex_count(gridX, gridY), (size_t)plane_index_count(gridX, gridY));
+  MeshCursor cursor;
+  // PlaneGeometry's grid is buildPlane's pz face at depth 0: (x, -y, 0), facing +Z.
+  build_plane(0, 1, 2, 1.0f, -1.0f, width, height, 0.0f, 1.0f, gridX, gridY, out, cursor);
+  return out;
+}
+
+MeshDataCpp make_circle(float radius, uint32_t segments, float thetaStart, float thetaLength) {
+  MeshDataCpp out;
+  segments = segments > 3 ? segments : 3;
+  if (!mesh_size_ok((uint64_t)segments + 2, (uint64_t)segments * 3)) {
+    return out;
+  }
+
+  resize_mesh(out, (size_t)segments + 2, (size_t)segments * 3);
+  MeshCursor cursor;
+
+  // center point
+  write_vertex(out, cursor, 0.0f, 0.0f, 0.0f, 0.5f, 0.5f);
+
+  for (uint32_t s = 0; s <= segments; s++) {
+    const float segment = thetaStart + (float)s / (float)segments * thetaLength;
+    const float x = radius * std::cos(segment);
+    const float y = radius * std::sin(segment);
+    write_vertex(out, cursor, x, y, 0.0f, (x / radius + 1.0f) / 2.0f, (y / radius + 1.0f) / 2.0f);
+  }
+
+  uint32_t* idx = out.indices.data();
+  for (uint32_t i = 1; i <= segments; i++) {
+    idx[0] = i;
+    idx[1] = i + 1;
+    idx[2] = 0;
+    idx += 3;
+  }
 
   return out;
 }
+
+MeshDataCpp make_ring(
+    float innerRadius,
+    float outerRadius,
+    uint32_t thetaSegments,
+    uint32_t phiSegments,
+    float thetaStart,
+    float thetaLength) {
+  MeshDataCpp out;
+  thetaSegments = thetaSegments > 3 ? thetaSegments : 3;
+  phiSegments = phiSegments > 1 ? phiSegments : 1;
+  if (!mesh_size_ok(plane_vertex_count(thetaSegments, phiSegments), plane_index_count(thetaSegments, phiSegments))) {
+    return out;
+  }
+
+  resize_mesh(
+      out, (size_t)plane_vertex_count(thetaSegments, phiSegments), (size_t)plane_index_count(thetaSegments, phiSegments));
+  MeshCursor cursor;
+
+  // The angle of each theta column is shared by every ring, so evaluate it once.
+  std::vector<float> cosTheta(thetaSegments + 1);
+  std::vector<float> sinTheta(thetaSegments + 1);
+  for (uint32_t i = 0; i <= thetaSegments; i++) {
+    const float segment = thetaStart + (float)i / (float)thetaSegments * thetaLength;
+    cosTheta[i] = std::cos(segment);
+    sinTheta[i] = std::sin(segment);
+  }
+
+  // a polar grid: rings from the inner to the outer radius
+  float radius = innerRadius;
+  const float radiusStep = (outerRadius - innerRadius) / (float)phiSegments;
+  for (uint32_t j = 0; j <= phiSegments; j++) {
+    for (uint32_t i = 0; i <= thetaSegments; i++) {
+      const float x = radius * cosTheta[i];
+      const float y = radius * sinTheta[i];
+      write_vertex(out, cursor, x, y, 0.0f, (x / outerRadius + 1.0f) / 2.0f, (y / outerRadius + 1.0f) / 2.0f);
+    }
+    radius += radiusStep;
+  }
+
+  write_grid_indices(out, cursor, 0, thetaSegments, phiSegments);
+  return out;
+}
+
+void compute_flat_normals(MeshDataCpp& mesh) {
+  mesh.normals.resize(mesh.vertices.size());
+  const float* p = mesh.vertices.data();
+  float* n = mesh.normals.data();
+  for (size_t i = 0; i + 8 < mesh.vertices.size(); i += 9) {
+    // cb x ab, like Three
+    const float cbx = p[i + 6] - p[i + 3], cby = p[i + 7] - p[i + 4], cbz = p[i + 8] - p[i + 5];
+    const float abx = p[i + 0] - p[i + 3], aby = p[i + 1] - p[i + 4], abz = p[i + 2] - p[i + 5];
+    float nx = cby * abz - cbz * aby;
+    float ny = cbz * abx - cbx * abz;
+    float nz = cbx * aby - cby * abx;
+    const float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+    if (len > 0.0f) {
+      nx /= len;
+      ny /= len;
+      nz /= len;
+    }
+    for (size_t k = 0; k < 9; k += 3) {
+      n[i + k + 0] = nx;
+      n[i + k + 1] = ny;
+      n[i + k + 2] = nz;
+    }
+  }
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -15,4 +16,55 @@ struct MeshDataCpp {
   std::vector<Group> groups;
 };
 
+// Write position in a MeshDataCpp whose arrays were already sized for the
+// whole mesh (see resize_mesh): generators append through it with plain stores
+// instead of push_back, so a high-resolution grid is one allocation per array.
+struct MeshCursor {
+  size_t vertex = 0;  // next vertex to write
+  size_t index = 0;   // next index slot to write
+};
+
+// Sizes every array for `vertexCount` vertices and `indexCount` indices.
+void resize_mesh(MeshDataCpp& mesh, size_t vertexCount, size_t indexCount);
+
+// 64-bit so overflow checks also hold on wasm32.
+uint64_t plane_vertex_count(uint32_t gridX, uint32_t gridY);
+uint64_t plane_index_count(uint32_t gridX, uint32_t gridY);
+
+// Three's BoxGeometry.buildPlane: a gridX x gridY grid spanning width x height
+// along axes u/v (flipped by udir/vdir), offset depth/2 along axis w, facing
+// `normalDir` (+1/-1) along w. Writes plane_vertex_count/plane_index_count
+// entries at `cursor` and advances it; no group is added.
+void build_plane(
+    int u,
+    int v,
+    int w,
+    float udir,
+    float vdir,
+    float width,
+    float height,
+    float depth,
+    float normalDir,
+    uint32_t gridX,
+    uint32_t gridY,
+    MeshDataCpp& out,
+    MeshCursor& cursor);
+
 MeshDataCpp make_box(float w, float h, float d);
+
+// Three's PlaneGeometry / CircleGeometry / RingGeometry: flat in XY, facing +Z,
+// indexed, no groups. Segment counts are clamped to Three's minimums; a mesh whose
+// vertex ids would not fit in uint32 comes back empty.
+MeshDataCpp make_plane(float width, float height, uint32_t widthSegments, uint32_t heightSegments);
+MeshDataCpp make_circle(float radius, uint32_t segments, float thetaStart, float thetaLength);
+MeshDataCpp make_ring(
+    float innerRadius,
+    float outerRadius,
+    uint32_t thetaSegments,
+    uint32_t phiSegments,
+    float thetaStart,
+    float thetaLength);
+
+// Per-triangle normals for a non-indexed triangle soup (Three's
+// computeVertexNormals() on a geometry without an index). Resizes `normals`.
+void compute_flat_normals(MeshDataCpp& mesh);
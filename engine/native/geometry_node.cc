@@ -1,7 +1,30 @@
 #include <node_api.h>
+#include <cmath>
 #include <cstring>
+#include <string>
+#include <vector>
 
+#include "affine_batch.h"
+#include "bounds.h"
+#include "broadphase.h"
+#include "bvh.h"
+#include "dual_quat.h"
+#include "edges.h"
+#include "euler_batch.h"
 #include "geometry_lib.h"
+#include "icp.h"
+#include "lbvh.h"
+#include "mesh_bvh.h"
+#include "mesh_transform.h"
+#include "point_grid.h"
+#include "polyhedron.h"
+#include "quat_batch.h"
+#include "rotation_batch.h"
+#include "skinning.h"
+#include "transform_hierarchy.h"
+#include "triangulate.h"
+#include "umeyama.h"
+#include "wireframe.h"
 
 static bool GetNumberArg(napi_env env, napi_value value, double* out) {
   napi_valuetype t;
@@ -11,6 +34,225 @@ static bool GetNumberArg(napi_env env, napi_value value, double* out) {
   return napi_get_value_double(env, value, out) == napi_ok;
 }
 
+// Like GetNumberArg, but a missing/undefined argument yields `fallback`.
+static bool GetOptionalNumberArg(napi_env env, size_t argc, napi_value* argv, size_t i, double fallback, double* out) {
+  if (i >= argc) {
+    *out = fallback;
+    return true;
+  }
+  napi_valuetype t;
+  if (napi_typeof(env, argv[i], &t) != napi_ok) {
+    return false;
+  }
+  if (t == napi_undefined) {
+    *out = fallback;
+    return true;
+  }
+  return GetNumberArg(env, argv[i], out);
+}
+
+// Like GetOptionalNumberArg, for booleans.
+static bool GetOptionalBoolArg(napi_env env, size_t argc, napi_value* argv, size_t i, bool fallback, bool* out) {
+  napi_valuetype t;
+  if (i >= argc || (napi_typeof(env, argv[i], &t) == napi_ok && t == napi_undefined)) {
+    *out = fallback;
+    return true;
+  }
+  return napi_typeof(env, argv[i], &t) == napi_ok && t == napi_boolean &&
+         napi_get_value_bool(env, argv[i], out) == napi_ok;
+}
+
+// Reads obj[name] as a number; missing/undefined keeps `*out` unchanged.
+static bool GetOptionalNamedNumber(napi_env env, napi_value obj, const char* name, double* out) {
+  napi_value value;
+  napi_valuetype t;
+  if (napi_get_named_property(env, obj, name, &value) != napi_ok || napi_typeof(env, value, &t) != napi_ok) {
+    return false;
+  }
+  if (t == napi_undefined) {
+    return true;
+  }
+  return GetNumberArg(env, value, out);
+}
+
+static bool GetOptionalNamedBool(napi_env env, napi_value obj, const char* name, bool* out) {
+  napi_value value;
+  napi_valuetype t;
+  if (napi_get_named_property(env, obj, name, &value) != napi_ok || napi_typeof(env, value, &t) != napi_ok) {
+    return false;
+  }
+  if (t == napi_undefined) {
+    return true;
+  }
+  return t == napi_boolean && napi_get_value_bool(env, value, out) == napi_ok;
+}
+
+// True if argv[i] is absent, undefined or null.
+static bool IsMissingArg(napi_env env, size_t argc, napi_value* argv, size_t i) {
+  if (i >= argc) {
+    return true;
+  }
+  napi_valuetype t;
+  return napi_typeof(env, argv[i], &t) == napi_ok && (t == napi_undefined || t == napi_null);
+}
+
+// Borrows the backing store of a typed array of the expected element type.
+// No copy is made; the pointer is valid for the duration of the call.
+template <typename T>
+static bool GetTypedArrayArg(napi_env env, napi_value value, napi_typedarray_type expected, T** data, size_t* length) {
+  bool isTypedArray = false;
+  if (napi_is_typedarray(env, value, &isTypedArray) != napi_ok || !isTypedArray) {
+    return false;
+  }
+  napi_typedarray_type type;
+  void* raw = nullptr;
+  if (napi_get_typedarray_info(env, value, &type, length, &raw, nullptr, nullptr) != napi_ok || type != expected) {
+    return false;
+  }
+  *data = static_cast<T*>(raw);
+  return true;
+}
+
+// Allocates a zero-filled typed array of `length` elements and returns its backing store in `data`.
+static napi_value NewTypedArray(
+    napi_env env,
+    napi_typedarray_type type,
+    size_t length,
+    size_t elementSize,
+    void** data,
+    const char* what) {
+  napi_value ab;
+  if (napi_create_arraybuffer(env, length * elementSize, data, &ab) != napi_ok) {
+    napi_throw_error(env, nullptr, (std::string("Failed to allocate ") + what + " ArrayBuffer").c_str());
+    return nullptr;
+  }
+
+  napi_value ta;
+  if (napi_create_typedarray(env, type, length, ab, 0, &ta) != napi_ok) {
+    napi_throw_error(env, nullptr, (std::string("Failed to create ") + what + " typed array").c_str());
+    return nullptr;
+  }
+  return ta;
+}
+
+// Copies `length` elements into a fresh typed array; throws and returns nullptr on failure.
+static napi_value CreateTypedArray(
+    napi_env env,
+    napi_typedarray_type type,
+    const void* data,
+    size_t length,
+    size_t elementSize,
+    const char* what) {
+  void* ab_data = nullptr;
+  napi_value ta = NewTypedArray(env, type, length, elementSize, &ab_data, what);
+  if (ta != nullptr && length > 0) {
+    std::memcpy(ab_data, data, length * elementSize);
+  }
+  return ta;
+}
+
+static napi_value CreateFloat32Array(napi_env env, const std::vector<float>& v, const char* what) {
+  return CreateTypedArray(env, napi_float32_array, v.data(), v.size(), sizeof(float), what);
+}
+
+static napi_value CreateUint32Array(napi_env env, const std::vector<uint32_t>& v, const char* what) {
+  return CreateTypedArray(env, napi_uint32_array, v.data(), v.size(), sizeof(uint32_t), what);
+}
+
+// Optional caller-provided output array for the batch kernels: argument i must be
+// a typed array of `type` with exactly `length` elements (results are written in
+// place, and it may be one of the inputs), or missing/null, in which case a new
+// one is allocated.
+template <typename T>
+static bool GetOutputTypedArray(
+    napi_env env,
+    size_t argc,
+    napi_value* argv,
+    size_t i,
+    napi_typedarray_type type,
+    size_t length,
+    T** data,
+    napi_value* result,
+    const char* usage) {
+  if (IsMissingArg(env, argc, argv, i)) {
+    void* raw = nullptr;
+    *result = NewTypedArray(env, type, length, sizeof(T), &raw, "output");
+    *data = static_cast<T*>(raw);
+    return *result != nullptr;
+  }
+  size_t outLength = 0;
+  if (!GetTypedArrayArg(env, argv[i], type, data, &outLength) || outLength != length) {
+    napi_throw_type_error(env, nullptr, usage);
+    return false;
+  }
+  *result = argv[i];
+  return true;
+}
+
+static bool GetOutputFloat32Array(
+    napi_env env,
+    size_t argc,
+    napi_value* argv,
+    size_t i,
+    size_t length,
+    float** data,
+    napi_value* result) {
+  return GetOutputTypedArray(
+      env,
+      argc,
+      argv,
+      i,
+      napi_float32_array,
+      length,
+      data,
+      result,
+      "output must be a Float32Array matching the input length");
+}
+
+static napi_value MeshToJs(napi_env env, const MeshDataCpp& mesh) {
+  napi_value v_ta = CreateFloat32Array(env, mesh.vertices, "vertices");
+  if (v_ta == nullptr) return nullptr;
+  napi_value n_ta = CreateFloat32Array(env, mesh.normals, "normals");
+  if (n_ta == nullptr) return nullptr;
+  napi_value uv_ta = CreateFloat32Array(env, mesh.uvs, "uvs");
+  if (uv_ta == nullptr) return nullptr;
+  napi_value i_ta = CreateUint32Array(env, mesh.indices, "indices");
+  if (i_ta == nullptr) return nullptr;
+
+  napi_value out;
+  napi_create_object(env, &out);
+
+  napi_set_named_property(env, out, "vertices", v_ta);
+  napi_set_named_property(env, out, "normals", n_ta);
+  napi_set_named_property(env, out, "uvs", uv_ta);
+  napi_set_named_property(env, out, "indices", i_ta);
+
+  // groups
+  napi_value groups;
+  if (napi_create_array_with_length(env, mesh.groups.size(), &groups) == napi_ok) {
+    for (size_t gi = 0; gi < mesh.groups.size(); gi++) {
+      napi_value g;
+      napi_create_object(env, &g);
+
+      napi_value start;
+      napi_value count;
+      napi_value materialIndex;
+      napi_create_uint32(env, mesh.groups[gi].start, &start);
+      napi_create_uint32(env, mesh.groups[gi].count, &count);
+      napi_create_uint32(env, mesh.groups[gi].materialIndex, &materialIndex);
+
+      napi_set_named_property(env, g, "start", start);
+      napi_set_named_property(env, g, "count", count);
+      napi_set_named_property(env, g, "materialIndex", materialIndex);
+
+      napi_set_element(env, groups, gi, g);
+    }
+    napi_set_named_property(env, out, "groups", groups);
+  }
+
+  return out;
+}
+
 static napi_value MakeBox(napi_env env, napi_callback_info info) {
   size_t argc = 3;
   napi_value argv[3];
@@ -28,110 +270,1797 @@ static napi_value MakeBox(napi_env env, napi_callback_info info) {
     return nullptr;
   }
 
-  MeshDataCpp mesh = make_box((float)w, (float)h, (float)d);
+  return MeshToJs(env, make_box((float)w, (float)h, (float)d));
+}
+
+static const double kTwoPi = 6.283185307179586;
+
+// Three floors segment counts; the generators clamp them to their minimums.
+static bool GetSegmentsArg(napi_env env, size_t argc, napi_value* argv, size_t i, double fallback, uint32_t* out) {
+  double segments;
+  if (!GetOptionalNumberArg(env, argc, argv, i, fallback, &segments) || !(segments >= 0.0) ||
+      segments > 4294967295.0) {
+    return false;
+  }
+  *out = (uint32_t)std::floor(segments);
+  return true;
+}
+
+static napi_value MakePlane(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value argv[4];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  double width, height;
+  uint32_t widthSegments, heightSegments;
+  if (!GetOptionalNumberArg(env, argc, argv, 0, 1.0, &width) ||
+      !GetOptionalNumberArg(env, argc, argv, 1, 1.0, &height) ||
+      !GetSegmentsArg(env, argc, argv, 2, 1.0, &widthSegments) ||
+      !GetSegmentsArg(env, argc, argv, 3, 1.0, &heightSegments)) {
+    napi_throw_type_error(env, nullptr, "makePlane(width?, height?, widthSegments?, heightSegments?) expects numbers");
+    return nullptr;
+  }
+
+  return MeshToJs(env, make_plane((float)width, (float)height, widthSegments, heightSegments));
+}
+
+static napi_value MakeCircle(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value argv[4];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
 
-  // vertices
-  napi_value v_ab;
-  void* v_data = nullptr;
-  const size_t v_bytes = mesh.vertices.size() * sizeof(float);
-  if (napi_create_arraybuffer(env, v_bytes, &v_data, &v_ab) != napi_ok) {
-    napi_throw_error(env, nullptr, "Failed to allocate vertices ArrayBuffer");
+  double radius, thetaStart, thetaLength;
+  uint32_t segments;
+  if (!GetOptionalNumberArg(env, argc, argv, 0, 1.0, &radius) ||
+      !GetSegmentsArg(env, argc, argv, 1, 32.0, &segments) ||
+      !GetOptionalNumberArg(env, argc, argv, 2, 0.0, &thetaStart) ||
+      !GetOptionalNumberArg(env, argc, argv, 3, kTwoPi, &thetaLength)) {
+    napi_throw_type_error(env, nullptr, "makeCircle(radius?, segments?, thetaStart?, thetaLength?) expects numbers");
     return nullptr;
   }
-  std::memcpy(v_data, mesh.vertices.data(), v_bytes);
 
-  napi_value v_ta;
-  if (napi_create_typedarray(env, napi_float32_array, mesh.vertices.size(), v_ab, 0, &v_ta) != napi_ok) {
-    napi_throw_error(env, nullptr, "Failed to create Float32Array");
+  return MeshToJs(env, make_circle((float)radius, segments, (float)thetaStart, (float)thetaLength));
+}
+
+static napi_value MakeRing(napi_env env, napi_callback_info info) {
+  size_t argc = 6;
+  napi_value argv[6];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  double innerRadius, outerRadius, thetaStart, thetaLength;
+  uint32_t thetaSegments, phiSegments;
+  if (!GetOptionalNumberArg(env, argc, argv, 0, 0.5, &innerRadius) ||
+      !GetOptionalNumberArg(env, argc, argv, 1, 1.0, &outerRadius) ||
+      !GetSegmentsArg(env, argc, argv, 2, 32.0, &thetaSegments) ||
+      !GetSegmentsArg(env, argc, argv, 3, 1.0, &phiSegments) ||
+      !GetOptionalNumberArg(env, argc, argv, 4, 0.0, &thetaStart) ||
+      !GetOptionalNumberArg(env, argc, argv, 5, kTwoPi, &thetaLength)) {
+    napi_throw_type_error(
+        env,
+        nullptr,
+        "makeRing(innerRadius?, outerRadius?, thetaSegments?, phiSegments?, thetaStart?, thetaLength?) expects numbers");
     return nullptr;
   }
 
-  // indices
-  napi_value i_ab;
-  void* i_data = nullptr;
-  const size_t i_bytes = mesh.indices.size() * sizeof(uint32_t);
-  if (napi_create_arraybuffer(env, i_bytes, &i_data, &i_ab) != napi_ok) {
-    napi_throw_error(env, nullptr, "Failed to allocate indices ArrayBuffer");
+  return MeshToJs(
+      env,
+      make_ring(
+          (float)innerRadius, (float)outerRadius, thetaSegments, phiSegments, (float)thetaStart, (float)thetaLength));
+}
+
+// Any uint32 detail parses; whether the mesh fits is CheckPolyhedronSize's call.
+static bool GetDetailArg(napi_env env, size_t argc, napi_value* argv, size_t i, uint32_t* out) {
+  double detail;
+  if (!GetOptionalNumberArg(env, argc, argv, i, 0.0, &detail) || !(detail >= 0.0) || detail > 4294967295.0) {
+    return false;
+  }
+  *out = (uint32_t)std::floor(detail);
+  return true;
+}
+
+// Throws a RangeError (same message as the WASM binding) if the output would
+// exceed kMaxPolyhedronVertices.
+static bool CheckPolyhedronSize(napi_env env, const char* name, size_t faceCount, uint32_t detail) {
+  uint64_t count;
+  if (!polyhedron_vertex_count(faceCount, detail, &count)) {
+    napi_throw_range_error(
+        env, nullptr, (std::string(name) + ": detail " + std::to_string(detail) + " exceeds the vertex budget").c_str());
+    return false;
+  }
+  return true;
+}
+
+static napi_value MakePolyhedron(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value argv[4];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  const char* usage = "makePolyhedron(vertices: Float32Array, indices: Uint32Array, radius?, detail?)";
+  float* vertices = nullptr;
+  uint32_t* indices = nullptr;
+  size_t vertexFloats = 0;
+  size_t indexCount = 0;
+  double radius;
+  uint32_t detail;
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &vertices, &vertexFloats) ||
+      !GetTypedArrayArg(env, argv[1], napi_uint32_array, &indices, &indexCount) ||
+      !GetOptionalNumberArg(env, argc, argv, 2, 1.0, &radius) || !GetDetailArg(env, argc, argv, 3, &detail)) {
+    napi_throw_type_error(env, nullptr, usage);
     return nullptr;
   }
-  std::memcpy(i_data, mesh.indices.data(), i_bytes);
 
-  napi_value i_ta;
-  if (napi_create_typedarray(env, napi_uint32_array, mesh.indices.size(), i_ab, 0, &i_ta) != napi_ok) {
-    napi_throw_error(env, nullptr, "Failed to create Uint32Array");
+  const size_t vertexCount = vertexFloats / 3;
+  for (size_t i = 0; i < indexCount; i++) {
+    if (indices[i] >= vertexCount) {
+      napi_throw_range_error(env, nullptr, "makePolyhedron: index out of range");
+      return nullptr;
+    }
+  }
+  if (!CheckPolyhedronSize(env, "makePolyhedron", indexCount / 3, detail)) {
     return nullptr;
   }
 
-  napi_value out;
-  napi_create_object(env, &out);
+  return MeshToJs(env, make_polyhedron(vertices, vertexCount, indices, indexCount, (float)radius, detail));
+}
 
-  napi_set_named_property(env, out, "vertices", v_ta);
-  // normals
-  napi_value n_ab;
-  void* n_data = nullptr;
-  const size_t n_bytes = mesh.normals.size() * sizeof(float);
-  if (napi_create_arraybuffer(env, n_bytes, &n_data, &n_ab) != napi_ok) {
-    napi_throw_error(env, nullptr, "Failed to allocate normals ArrayBuffer");
+typedef MeshDataCpp (*SolidFn)(float radius, uint32_t detail);
+
+struct SolidEntry {
+  const char* name;
+  SolidFn fn;
+  size_t faceCount;
+};
+
+static const SolidEntry kSolids[] = {
+    {"makeTetrahedron", make_tetrahedron, kTetrahedronFaces},
+    {"makeOctahedron", make_octahedron, kOctahedronFaces},
+    {"makeIcosahedron", make_icosahedron, kIcosahedronFaces},
+    {"makeDodecahedron", make_dodecahedron, kDodecahedronFaces},
+};
+
+// Shared callback for the platonic solids; `data` points at the SolidEntry.
+static napi_value MakeSolid(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  void* data = nullptr;
+  napi_get_cb_info(env, info, &argc, argv, nullptr, &data);
+  const SolidEntry* entry = static_cast<const SolidEntry*>(data);
+
+  double radius;
+  uint32_t detail;
+  if (!GetOptionalNumberArg(env, argc, argv, 0, 1.0, &radius) || !GetDetailArg(env, argc, argv, 1, &detail)) {
+    napi_throw_type_error(env, nullptr, (std::string(entry->name) + "(radius?, detail?) expects numbers").c_str());
+    return nullptr;
+  }
+  if (!CheckPolyhedronSize(env, entry->name, entry->faceCount, detail)) {
     return nullptr;
   }
-  std::memcpy(n_data, mesh.normals.data(), n_bytes);
 
-  napi_value n_ta;
-  if (napi_create_typedarray(env, napi_float32_array, mesh.normals.size(), n_ab, 0, &n_ta) != napi_ok) {
-    napi_throw_error(env, nullptr, "Failed to create normals Float32Array");
+  return MeshToJs(env, entry->fn((float)radius, detail));
+}
+
+// Shared argument parsing for the polygon entry points:
+// (points: Float32Array /* xy */, holeStarts?: Uint32Array /* point indices */).
+struct PolygonArgs {
+  float* points = nullptr;
+  size_t pointCount = 0;
+  uint32_t* holeStarts = nullptr;
+  size_t holeCount = 0;
+};
+
+static bool GetPolygonArgs(napi_env env, size_t argc, napi_value* argv, PolygonArgs* out) {
+  size_t floats = 0;
+  if (argc < 1 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &out->points, &floats)) {
+    return false;
+  }
+  out->pointCount = floats / 2;
+  if (!IsMissingArg(env, argc, argv, 1) &&
+      !GetTypedArrayArg(env, argv[1], napi_uint32_array, &out->holeStarts, &out->holeCount)) {
+    return false;
+  }
+  for (size_t i = 0; i < out->holeCount; i++) {
+    if (out->holeStarts[i] > out->pointCount || (i > 0 && out->holeStarts[i] < out->holeStarts[i - 1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static napi_value Triangulate(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  PolygonArgs poly;
+  if (!GetPolygonArgs(env, argc, argv, &poly)) {
+    napi_throw_type_error(env, nullptr, "triangulate(points: Float32Array, holeStarts?: Uint32Array) expects xy points and ascending hole starts");
     return nullptr;
   }
-  napi_set_named_property(env, out, "normals", n_ta);
 
-  // uvs
-  napi_value uv_ab;
-  void* uv_data = nullptr;
-  const size_t uv_bytes = mesh.uvs.size() * sizeof(float);
-  if (napi_create_arraybuffer(env, uv_bytes, &uv_data, &uv_ab) != napi_ok) {
-    napi_throw_error(env, nullptr, "Failed to allocate uvs ArrayBuffer");
+  return CreateUint32Array(env, triangulate_polygon(poly.points, poly.pointCount, poly.holeStarts, poly.holeCount), "triangles");
+}
+
+static napi_value MakeShape(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  PolygonArgs poly;
+  if (!GetPolygonArgs(env, argc, argv, &poly)) {
+    napi_throw_type_error(env, nullptr, "makeShape(points: Float32Array, holeStarts?: Uint32Array) expects xy points and ascending hole starts");
     return nullptr;
   }
-  std::memcpy(uv_data, mesh.uvs.data(), uv_bytes);
 
-  napi_value uv_ta;
-  if (napi_create_typedarray(env, napi_float32_array, mesh.uvs.size(), uv_ab, 0, &uv_ta) != napi_ok) {
-    napi_throw_error(env, nullptr, "Failed to create uvs Float32Array");
+  return MeshToJs(env, make_shape(poly.points, poly.pointCount, poly.holeStarts, poly.holeCount));
+}
+
+static napi_value MakeExtrude(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  const char* usage = "makeExtrude(points: Float32Array, holeStarts?: Uint32Array, options?: ExtrudeOptions)";
+  PolygonArgs poly;
+  if (!GetPolygonArgs(env, argc, argv, &poly)) {
+    napi_throw_type_error(env, nullptr, usage);
     return nullptr;
   }
-  napi_set_named_property(env, out, "uvs", uv_ta);
 
-  napi_set_named_property(env, out, "indices", i_ta);
+  ExtrudeOptions options;
+  if (!IsMissingArg(env, argc, argv, 2)) {
+    double steps = options.steps;
+    double depth = options.depth;
+    double bevelThickness = options.bevelThickness;
+    double bevelSize = NAN;
+    double bevelOffset = options.bevelOffset;
+    double bevelSegments = options.bevelSegments;
+    if (!GetOptionalNamedNumber(env, argv[2], "steps", &steps) ||
+        !GetOptionalNamedNumber(env, argv[2], "depth", &depth) ||
+        !GetOptionalNamedBool(env, argv[2], "bevelEnabled", &options.bevelEnabled) ||
+        !GetOptionalNamedNumber(env, argv[2], "bevelThickness", &bevelThickness) ||
+        !GetOptionalNamedNumber(env, argv[2], "bevelSize", &bevelSize) ||
+        !GetOptionalNamedNumber(env, argv[2], "bevelOffset", &bevelOffset) ||
+        !GetOptionalNamedNumber(env, argv[2], "bevelSegments", &bevelSegments) || !(steps >= 1.0) ||
+        !(bevelSegments >= 0.0)) {
+      napi_throw_type_error(env, nullptr, usage);
+      return nullptr;
+    }
+    // Same bound and message as the WASM binding.
+    if (steps > kMaxExtrudeSegments || bevelSegments > kMaxExtrudeSegments) {
+      napi_throw_range_error(
+          env, nullptr,
+          ("makeExtrude: steps and bevelSegments must be at most " + std::to_string(kMaxExtrudeSegments)).c_str());
+      return nullptr;
+    }
+    options.steps = (uint32_t)steps;
+    options.depth = (float)depth;
+    options.bevelThickness = (float)bevelThickness;
+    // Three defaults bevelSize to bevelThickness - 0.1.
+    options.bevelSize = (float)(std::isnan(bevelSize) ? bevelThickness - 0.1 : bevelSize);
+    options.bevelOffset = (float)bevelOffset;
+    options.bevelSegments = (uint32_t)bevelSegments;
+  }
 
-  // groups
-  napi_value groups;
-  if (napi_create_array_with_length(env, mesh.groups.size(), &groups) == napi_ok) {
-    for (size_t gi = 0; gi < mesh.groups.size(); gi++) {
-      napi_value g;
-      napi_create_object(env, &g);
+  return MeshToJs(env, make_extrude(poly.points, poly.pointCount, poly.holeStarts, poly.holeCount, options));
+}
 
-      napi_value start;
-      napi_value count;
-      napi_value materialIndex;
-      napi_create_uint32(env, mesh.groups[gi].start, &start);
-      napi_create_uint32(env, mesh.groups[gi].count, &count);
-      napi_create_uint32(env, mesh.groups[gi].materialIndex, &materialIndex);
+static napi_value EdgesGeometry(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
 
-      napi_set_named_property(env, g, "start", start);
-      napi_set_named_property(env, g, "count", count);
-      napi_set_named_property(env, g, "materialIndex", materialIndex);
+  float* positions = nullptr;
+  size_t positionFloats = 0;
+  uint32_t* indices = nullptr;
+  size_t indexCount = 0;
+  double thresholdAngle;
+  if (argc < 1 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &positions, &positionFloats) ||
+      (!IsMissingArg(env, argc, argv, 1) &&
+       !GetTypedArrayArg(env, argv[1], napi_uint32_array, &indices, &indexCount)) ||
+      !GetOptionalNumberArg(env, argc, argv, 2, 1.0, &thresholdAngle)) {
+    napi_throw_type_error(env, nullptr, "edgesGeometry(positions: Float32Array, indices?: Uint32Array | null, thresholdAngle?: number)");
+    return nullptr;
+  }
 
-      napi_set_element(env, groups, gi, g);
+  return CreateFloat32Array(
+      env, edges_geometry(positions, positionFloats / 3, indices, indexCount, (float)thresholdAngle), "edges");
+}
+
+static napi_value WireframeIndices(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* positions = nullptr;
+  size_t positionFloats = 0;
+  uint32_t* indices = nullptr;
+  size_t indexCount = 0;
+  if (argc < 1 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &positions, &positionFloats) ||
+      (!IsMissingArg(env, argc, argv, 1) &&
+       !GetTypedArrayArg(env, argv[1], napi_uint32_array, &indices, &indexCount))) {
+    napi_throw_type_error(env, nullptr, "wireframeIndices(positions: Float32Array, indices?: Uint32Array | null)");
+    return nullptr;
+  }
+
+  return CreateUint32Array(
+      env, wireframe_indices(positions, positionFloats / 3, indices, indexCount), "line indices");
+}
+
+static napi_value QuatMultiplyBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* a = nullptr;
+  float* b = nullptr;
+  size_t aLength = 0, bLength = 0;
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &a, &aLength) ||
+      !GetTypedArrayArg(env, argv[1], napi_float32_array, &b, &bLength) || aLength != bLength || aLength % 4 != 0) {
+    napi_throw_type_error(env, nullptr, "quatMultiplyBatch(a, b, out?) expects equal-length planar xyzw Float32Arrays");
+    return nullptr;
+  }
+
+  float* out = nullptr;
+  napi_value result;
+  if (!GetOutputFloat32Array(env, argc, argv, 2, aLength, &out, &result)) {
+    return nullptr;
+  }
+
+  const size_t count = aLength / 4;
+  quat_multiply_batch(quat_soa_planar(a, count), quat_soa_planar(b, count), quat_soa_planar(out, count), count);
+  return result;
+}
+
+// Shared argument handling for quatSlerpBatch/quatNlerpBatch(a, b, t, out?), where
+// `t` is a number (whole batch) or a Float32Array with one weight per quaternion.
+template <typename UniformFn, typename PerElementFn>
+static napi_value QuatInterpolateBatch(
+    napi_env env,
+    napi_callback_info info,
+    const char* usage,
+    UniformFn uniform,
+    PerElementFn perElement) {
+  size_t argc = 4;
+  napi_value argv[4];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* a = nullptr;
+  float* b = nullptr;
+  size_t aLength = 0, bLength = 0;
+  if (argc < 3 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &a, &aLength) ||
+      !GetTypedArrayArg(env, argv[1], napi_float32_array, &b, &bLength) || aLength != bLength || aLength % 4 != 0) {
+    napi_throw_type_error(env, nullptr, usage);
+    return nullptr;
+  }
+  const size_t count = aLength / 4;
+
+  double tUniform = 0.0;
+  float* t = nullptr;
+  size_t tLength = 0;
+  if (!GetNumberArg(env, argv[2], &tUniform) &&
+      (!GetTypedArrayArg(env, argv[2], napi_float32_array, &t, &tLength) || tLength != count)) {
+    napi_throw_type_error(env, nullptr, usage);
+    return nullptr;
+  }
+
+  float* out = nullptr;
+  napi_value result;
+  if (!GetOutputFloat32Array(env, argc, argv, 3, aLength, &out, &result)) {
+    return nullptr;
+  }
+
+  if (t != nullptr) {
+    perElement(quat_soa_planar(a, count), quat_soa_planar(b, count), t, quat_soa_planar(out, count), count);
+  } else {
+    uniform(quat_soa_planar(a, count), quat_soa_planar(b, count), (float)tUniform, quat_soa_planar(out, count), count);
+  }
+  return result;
+}
+
+static napi_value QuatSlerpBatch(napi_env env, napi_callback_info info) {
+  return QuatInterpolateBatch(
+      env,
+      info,
+      "quatSlerpBatch(a, b, t: number | Float32Array, out?) expects equal-length planar xyzw Float32Arrays",
+      [](ConstQuatSoA a, ConstQuatSoA b, float t, QuatSoA out, size_t n) { quat_slerp_batch(a, b, t, out, n); },
+      [](ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t n) { quat_slerp_batch(a, b, t, out, n); });
+}
+
+static napi_value QuatNlerpBatch(napi_env env, napi_callback_info info) {
+  return QuatInterpolateBatch(
+      env,
+      info,
+      "quatNlerpBatch(a, b, t: number | Float32Array, out?) expects equal-length planar xyzw Float32Arrays",
+      [](ConstQuatSoA a, ConstQuatSoA b, float t, QuatSoA out, size_t n) { quat_nlerp_batch(a, b, t, out, n); },
+      [](ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t n) { quat_nlerp_batch(a, b, t, out, n); });
+}
+
+// Exactly `count` numbers, as a Float32Array or a plain array.
+static bool GetFloatsArg(napi_env env, napi_value value, uint32_t count, float* out) {
+  float* data = nullptr;
+  size_t length = 0;
+  if (GetTypedArrayArg(env, value, napi_float32_array, &data, &length)) {
+    if (length != count) {
+      return false;
     }
-    napi_set_named_property(env, out, "groups", groups);
+    std::memcpy(out, data, count * sizeof(float));
+    return true;
   }
 
-  return out;
+  bool isArray = false;
+  uint32_t arrayLength = 0;
+  if (napi_is_array(env, value, &isArray) != napi_ok || !isArray ||
+      napi_get_array_length(env, value, &arrayLength) != napi_ok || arrayLength != count) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    napi_value element;
+    double v;
+    if (napi_get_element(env, value, i, &element) != napi_ok || !GetNumberArg(env, element, &v)) {
+      return false;
+    }
+    out[i] = (float)v;
+  }
+  return true;
 }
 
-static napi_value Init(napi_env env, napi_value exports) {
-  napi_value fn;
-  napi_create_function(env, "makeBox", NAPI_AUTO_LENGTH, MakeBox, nullptr, &fn);
-  napi_set_named_property(env, exports, "makeBox", fn);
+// 16 numbers, column-major (Three's Matrix4.elements).
+static bool GetMatrix4Arg(napi_env env, napi_value value, float* out) {
+  return GetFloatsArg(env, value, 16, out);
+}
+
+static bool GetVector3Arg(napi_env env, napi_value value, Eigen::Vector3f* out) {
+  return GetFloatsArg(env, value, 3, out->data());
+}
+
+// Euler axis triple [a0, a1, a2] as MatrixBase::eulerAngles takes it.
+static bool GetEulerAxesArg(napi_env env, napi_value value, int* axes) {
+  float a[3];
+  if (!GetFloatsArg(env, value, 3, a)) {
+    return false;
+  }
+  for (int k = 0; k < 3; k++) {
+    if (a[k] != 0.0f && a[k] != 1.0f && a[k] != 2.0f) {
+      return false;
+    }
+    axes[k] = (int)a[k];
+  }
+  return axes[1] != axes[0] && axes[1] != axes[2];
+}
+
+// quatToEulerBatch(quats: planar xyzw, axes: [a0, a1, a2], out?) -> planar [e0..., e1..., e2...]
+static napi_value QuatToEulerBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* q = nullptr;
+  size_t length = 0;
+  int axes[3];
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &q, &length) || length % 4 != 0 ||
+      !GetEulerAxesArg(env, argv[1], axes)) {
+    napi_throw_type_error(
+        env, nullptr, "quatToEulerBatch(quats, axes, out?) expects planar xyzw Float32Array and axes like [2, 0, 2]");
+    return nullptr;
+  }
+
+  const size_t count = length / 4;
+  float* out = nullptr;
+  napi_value result;
+  if (!GetOutputFloat32Array(env, argc, argv, 2, count * 3, &out, &result)) {
+    return nullptr;
+  }
+  quat_to_euler_batch(axes[0], axes[1], axes[2], quat_soa_planar(q, count), euler_soa_planar(out, count), count);
+  return result;
+}
+
+// eulerToQuatBatch(angles: planar [e0..., e1..., e2...], axes: [a0, a1, a2], out?) -> planar xyzw
+static napi_value EulerToQuatBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* e = nullptr;
+  size_t length = 0;
+  int axes[3];
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &e, &length) || length % 3 != 0 ||
+      !GetEulerAxesArg(env, argv[1], axes)) {
+    napi_throw_type_error(
+        env, nullptr, "eulerToQuatBatch(angles, axes, out?) expects planar Float32Array angles and axes like [2, 0, 2]");
+    return nullptr;
+  }
+
+  const size_t count = length / 3;
+  float* out = nullptr;
+  napi_value result;
+  if (!GetOutputFloat32Array(env, argc, argv, 2, count * 4, &out, &result)) {
+    return nullptr;
+  }
+  euler_to_quat_batch(axes[0], axes[1], axes[2], euler_soa_planar(e, count), quat_soa_planar(out, count), count);
+  return result;
+}
+
+// 'quaternion' | 'angleAxis' | 'matrix3'
+static bool GetRotationFormatArg(napi_env env, napi_value value, RotationFormat* format) {
+  char name[16];
+  size_t length = 0;
+  if (napi_get_value_string_utf8(env, value, name, sizeof(name), &length) != napi_ok) {
+    return false;
+  }
+  if (std::strcmp(name, "quaternion") == 0) {
+    *format = RotationFormat::Quaternion;
+  } else if (std::strcmp(name, "angleAxis") == 0) {
+    *format = RotationFormat::AngleAxis;
+  } else if (std::strcmp(name, "matrix3") == 0) {
+    *format = RotationFormat::Matrix3;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// convertRotationBatch(input: planar block, from, to, out?) -> planar block in `to`
+static napi_value ConvertRotationBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value argv[4];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* in = nullptr;
+  size_t length = 0;
+  RotationFormat from, to;
+  if (argc < 3 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &in, &length) ||
+      !GetRotationFormatArg(env, argv[1], &from) || !GetRotationFormatArg(env, argv[2], &to) ||
+      length % rotation_format_floats(from) != 0) {
+    napi_throw_type_error(env, nullptr,
+                          "convertRotationBatch(input, from, to, out?) expects a planar Float32Array and formats "
+                          "'quaternion' | 'angleAxis' | 'matrix3'");
+    return nullptr;
+  }
+
+  const size_t count = length / rotation_format_floats(from);
+  float* out = nullptr;
+  napi_value result;
+  if (!GetOutputFloat32Array(env, argc, argv, 3, count * rotation_format_floats(to), &out, &result)) {
+    return nullptr;
+  }
+  convert_rotation_batch(from, to, in, out, count);
+  return result;
+}
+
+// 'isometry' | 'uniformScale' | 'general'
+static bool GetAffineKindArg(napi_env env, napi_value value, AffineKind* kind) {
+  char name[16];
+  size_t length = 0;
+  if (napi_get_value_string_utf8(env, value, name, sizeof(name), &length) != napi_ok) {
+    return false;
+  }
+  if (std::strcmp(name, "isometry") == 0) {
+    *kind = AffineKind::Isometry;
+  } else if (std::strcmp(name, "uniformScale") == 0) {
+    *kind = AffineKind::UniformScale;
+  } else if (std::strcmp(name, "general") == 0) {
+    *kind = AffineKind::General;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// invertAffineBatch(matrices: 16 floats each, kind, out?) -> inverses, same layout
+static napi_value InvertAffineBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* matrices = nullptr;
+  size_t length = 0;
+  AffineKind kind;
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &matrices, &length) || length % 16 != 0 ||
+      !GetAffineKindArg(env, argv[1], &kind)) {
+    napi_throw_type_error(env, nullptr,
+                          "invertAffineBatch(matrices, kind, out?) expects 16-float column-major matrices and kind "
+                          "'isometry' | 'uniformScale' | 'general'");
+    return nullptr;
+  }
+
+  float* out = nullptr;
+  napi_value result;
+  if (!GetOutputFloat32Array(env, argc, argv, 2, length, &out, &result)) {
+    return nullptr;
+  }
+  invert_affine_batch(kind, matrices, out, length / 16);
+  return result;
+}
+
+static napi_value TransformMesh(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* vertices = nullptr;
+  float* normals = nullptr;
+  size_t vertexFloats = 0, normalFloats = 0;
+  float matrix[16];
+  if (argc < 3 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &vertices, &vertexFloats) ||
+      (!IsMissingArg(env, argc, argv, 1) &&
+       !GetTypedArrayArg(env, argv[1], napi_float32_array, &normals, &normalFloats)) ||
+      !GetMatrix4Arg(env, argv[2], matrix)) {
+    napi_throw_type_error(
+        env, nullptr, "transformMesh(vertices: Float32Array, normals: Float32Array | null, matrix: 16 numbers)");
+    return nullptr;
+  }
+
+  // Works directly on the typed arrays' backing stores: no copies either way.
+  transform_points(vertices, vertexFloats / 3, matrix);
+  if (normals != nullptr) {
+    float normalMatrix[9];
+    normal_matrix(matrix, normalMatrix);
+    transform_normals(normals, normalFloats / 3, normalMatrix);
+  }
+  return nullptr;
+}
+
+// Shared argument handling for skinLbs/skinDqs(positions, normals | null, skinIndex: Uint16Array,
+// skinWeight, boneMatrices, outPositions, outNormals | null), which write the skinned vertices
+// into the caller's arrays. skin(in, boneMatrices, boneCount, outPositions, outNormals) runs
+// the kernel.
+template <typename Skin>
+static napi_value SkinVertices(napi_env env, napi_callback_info info, const char* name, Skin skin) {
+  const std::string usage =
+      std::string(name) +
+      "(positions, normals, skinIndex, skinWeight, boneMatrices, outPositions, outNormals) expects xyz "
+      "Float32Arrays (normals may be null), 4 Uint16 indices and 4 Float32 weights per vertex, 16 floats per bone "
+      "and outputs the size of the inputs";
+  size_t argc = 7;
+  napi_value argv[7];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* positions = nullptr;
+  float* normals = nullptr;
+  uint16_t* boneIndices = nullptr;
+  float* boneWeights = nullptr;
+  float* boneMatrices = nullptr;
+  float* outPositions = nullptr;
+  float* outNormals = nullptr;
+  size_t positionFloats = 0, normalFloats = 0, indexCount = 0, weightCount = 0, matrixFloats = 0;
+  size_t outPositionFloats = 0, outNormalFloats = 0;
+  const bool withNormals = !IsMissingArg(env, argc, argv, 1);
+  if (argc < 6 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &positions, &positionFloats) ||
+      (withNormals && !GetTypedArrayArg(env, argv[1], napi_float32_array, &normals, &normalFloats)) ||
+      !GetTypedArrayArg(env, argv[2], napi_uint16_array, &boneIndices, &indexCount) ||
+      !GetTypedArrayArg(env, argv[3], napi_float32_array, &boneWeights, &weightCount) ||
+      !GetTypedArrayArg(env, argv[4], napi_float32_array, &boneMatrices, &matrixFloats) ||
+      !GetTypedArrayArg(env, argv[5], napi_float32_array, &outPositions, &outPositionFloats) ||
+      (withNormals && !GetTypedArrayArg(env, argv[6], napi_float32_array, &outNormals, &outNormalFloats))) {
+    napi_throw_type_error(env, nullptr, usage.c_str());
+    return nullptr;
+  }
+  const size_t vertexCount = positionFloats / 3;
+  if (positionFloats % 3 != 0 || indexCount != vertexCount * 4 || weightCount != vertexCount * 4 ||
+      matrixFloats % 16 != 0 || outPositionFloats != positionFloats ||
+      (withNormals && (normalFloats != positionFloats || outNormalFloats != positionFloats))) {
+    napi_throw_type_error(env, nullptr, usage.c_str());
+    return nullptr;
+  }
+  if (!skin_indices_valid(boneIndices, vertexCount, matrixFloats / 16)) {
+    napi_throw_range_error(env, nullptr, (std::string(name) + ": bone index out of range").c_str());
+    return nullptr;
+  }
+
+  // Straight from and into the typed arrays' backing stores: no copies.
+  const SkinningInput in{positions, normals, boneIndices, boneWeights, vertexCount};
+  skin(in, boneMatrices, matrixFloats / 16, outPositions, outNormals);
+  return nullptr;
+}
+
+static napi_value SkinLbs(napi_env env, napi_callback_info info) {
+  return SkinVertices(env, info, "skinLbs",
+                      [](const SkinningInput& in, const float* bones, size_t, float* outP, float* outN) {
+                        skin_lbs(in, bones, outP, outN);
+                      });
+}
+
+// Same arguments as skinLbs; the bone matrices (rigid) are converted to dual quaternions first.
+static napi_value SkinDqs(napi_env env, napi_callback_info info) {
+  return SkinVertices(env, info, "skinDqs",
+                      [](const SkinningInput& in, const float* bones, size_t boneCount, float* outP, float* outN) {
+                        std::vector<float> dualQuats(boneCount * kDualQuatFloats);
+                        dual_quats_from_transforms(bones, boneCount, dualQuats.data());
+                        skin_dqs(in, dualQuats.data(), outP, outN);
+                      });
+}
+
+static napi_value TransformBoxes(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* boxes = nullptr;
+  float* matrices = nullptr;
+  size_t boxFloats = 0, matrixFloats = 0;
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &boxes, &boxFloats) ||
+      !GetTypedArrayArg(env, argv[1], napi_float32_array, &matrices, &matrixFloats) || boxFloats % 6 != 0 ||
+      matrixFloats != boxFloats / 6 * 16) {
+    napi_throw_type_error(
+        env,
+        nullptr,
+        "transformBoxes(boxes, matrices, out?) expects planar min/max boxes and one 16-float matrix per box");
+    return nullptr;
+  }
+
+  float* out = nullptr;
+  napi_value result;
+  if (!GetOutputFloat32Array(env, argc, argv, 2, boxFloats, &out, &result)) {
+    return nullptr;
+  }
+
+  const size_t count = boxFloats / 6;
+  transform_boxes(box_soa_planar(boxes, count), matrices, box_soa_planar(out, count), count);
+  return result;
+}
+
+static napi_value FrustumPlanes(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float matrix[16];
+  if (argc < 1 || !GetMatrix4Arg(env, argv[0], matrix)) {
+    napi_throw_type_error(env, nullptr, "frustumPlanes(projectionView: 16 numbers)");
+    return nullptr;
+  }
+
+  const Frustum frustum = frustum_from_matrix(matrix);
+  float* planes = nullptr;
+  napi_value result = NewTypedArray(env, napi_float32_array, 24, sizeof(float), (void**)&planes, "planes");
+  if (result == nullptr) {
+    return nullptr;
+  }
+  for (size_t p = 0; p < 6; p++) {
+    Eigen::Map<Eigen::Vector4f>(planes + p * 4) = frustum.planes[p].coeffs();
+  }
+  return result;
+}
+
+static napi_value CullBoxes(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+
+  float* planes = nullptr;
+  float* boxes = nullptr;
+  size_t planeFloats = 0, boxFloats = 0;
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &planes, &planeFloats) || planeFloats != 24 ||
+      !GetTypedArrayArg(env, argv[1], napi_float32_array, &boxes, &boxFloats) || boxFloats % 6 != 0) {
+    napi_throw_type_error(env, nullptr, "cullBoxes(planes: Float32Array(24), boxes, out?) expects planar min/max boxes");
+    return nullptr;
+  }
+
+  const size_t count = boxFloats / 6;
+  uint32_t* visible = nullptr;
+  napi_value result;
+  if (!GetOutputTypedArray(
+          env,
+          argc,
+          argv,
+          2,
+          napi_uint32_array,
+          cull_mask_words(count),
+          &visible,
+          &result,
+          "output must be a Uint32Array of ceil(count / 32) words")) {
+    return nullptr;
+  }
+
+  Frustum frustum;
+  for (size_t p = 0; p < 6; p++) {
+    frustum.planes[p].coeffs() = Eigen::Map<const Eigen::Vector4f>(planes + p * 4);
+  }
+  cull_boxes(frustum, box_soa_planar(boxes, count), count, visible);
+  return result;
+}
+
+// ---- Native object handles ----
+// Stateful native objects (BVHs) live behind a JS class instance via napi_wrap.
+// They are freed when the instance is garbage collected, or eagerly by dispose().
+
+template <typename T>
+static void DeleteWrapped(napi_env, void* data, void*) {
+  delete static_cast<T*>(data);
+}
+
+// Reads `this` and the arguments of a method call and returns the wrapped
+// object; throws and returns nullptr after dispose().
+template <typename T>
+static T* UnwrapThis(napi_env env, napi_callback_info info, size_t* argc, napi_value* argv, napi_value* self = nullptr) {
+  napi_value thisArg;
+  napi_get_cb_info(env, info, argc, argv, &thisArg, nullptr);
+  void* data = nullptr;
+  if (napi_unwrap(env, thisArg, &data) != napi_ok || data == nullptr) {
+    napi_throw_error(env, nullptr, "native object was disposed");
+    return nullptr;
+  }
+  if (self != nullptr) {
+    *self = thisArg;
+  }
+  return static_cast<T*>(data);
+}
+
+template <typename T>
+static napi_value DisposeWrapped(napi_env env, napi_callback_info info) {
+  napi_value thisArg;
+  napi_get_cb_info(env, info, nullptr, nullptr, &thisArg, nullptr);
+  void* data = nullptr;
+  if (napi_remove_wrap(env, thisArg, &data) == napi_ok) {
+    delete static_cast<T*>(data);
+  }
+  return nullptr;
+}
+
+// { index, distance } or null.
+static napi_value HitToJs(napi_env env, uint32_t index, float distance, bool found) {
+  napi_value result;
+  if (!found) {
+    napi_get_null(env, &result);
+    return result;
+  }
+  napi_value i, d;
+  napi_create_object(env, &result);
+  napi_create_uint32(env, index, &i);
+  napi_create_double(env, distance, &d);
+  napi_set_named_property(env, result, "index", i);
+  napi_set_named_property(env, result, "distance", d);
+  return result;
+}
+
+static const char kBoxesUsage[] = "expected planar min/max boxes: Float32Array of 6 * count floats";
+
+static bool GetBoxesArg(napi_env env, napi_value value, float** boxes, size_t* count) {
+  size_t floats = 0;
+  if (!GetTypedArrayArg(env, value, napi_float32_array, boxes, &floats) || floats % 6 != 0) {
+    return false;
+  }
+  *count = floats / 6;
+  return true;
+}
+
+// Optional builder name: 'sah' (default) or 'lbvh'.
+static bool GetBuilderArg(napi_env env, size_t argc, napi_value* argv, size_t i, bool* lbvh) {
+  *lbvh = false;
+  if (IsMissingArg(env, argc, argv, i)) {
+    return true;
+  }
+  char name[8];
+  size_t length = 0;
+  if (napi_get_value_string_utf8(env, argv[i], name, sizeof(name), &length) != napi_ok) {
+    return false;
+  }
+  *lbvh = std::strcmp(name, "lbvh") == 0;
+  return *lbvh || std::strcmp(name, "sah") == 0;
+}
+
+// new BoxBvh(boxes, builder?: 'sah' | 'lbvh')
+static napi_value BoxBvhNew(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  napi_value self;
+  napi_get_cb_info(env, info, &argc, argv, &self, nullptr);
+
+  float* boxes = nullptr;
+  size_t count = 0;
+  if (argc < 1 || !GetBoxesArg(env, argv[0], &boxes, &count)) {
+    napi_throw_type_error(env, nullptr, kBoxesUsage);
+    return nullptr;
+  }
+  bool lbvh = false;
+  if (!GetBuilderArg(env, argc, argv, 1, &lbvh)) {
+    napi_throw_type_error(env, nullptr, "BoxBvh builder must be 'sah' or 'lbvh'");
+    return nullptr;
+  }
+
+  BoxBvh* bvh = lbvh ? new BoxBvh(build_lbvh(box_soa_planar(boxes, count), count))
+                     : new BoxBvh(box_soa_planar(boxes, count), count);
+  if (napi_wrap(env, self, bvh, DeleteWrapped<BoxBvh>, nullptr, nullptr) != napi_ok) {
+    delete bvh;
+    napi_throw_error(env, nullptr, "Failed to wrap BoxBvh");
+    return nullptr;
+  }
+  return self;
+}
+
+static napi_value BoxBvhSize(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  const BoxBvh* bvh = UnwrapThis<BoxBvh>(env, info, &argc, nullptr);
+  if (bvh == nullptr) {
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_uint32(env, (uint32_t)bvh->size(), &result);
+  return result;
+}
+
+static napi_value BoxBvhRefit(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  BoxBvh* bvh = UnwrapThis<BoxBvh>(env, info, &argc, argv);
+  if (bvh == nullptr) {
+    return nullptr;
+  }
+
+  float* boxes = nullptr;
+  size_t count = 0;
+  if (argc < 1 || !GetBoxesArg(env, argv[0], &boxes, &count) || count != bvh->size()) {
+    napi_throw_type_error(env, nullptr, "refit(boxes) expects as many planar min/max boxes as the BVH was built with");
+    return nullptr;
+  }
+  bvh->refit(box_soa_planar(boxes, count));
+  return nullptr;
+}
+
+// raycast(origin, direction, maxDistance = Infinity) -> { index, distance } | null
+static napi_value BoxBvhRaycast(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  const BoxBvh* bvh = UnwrapThis<BoxBvh>(env, info, &argc, argv);
+  if (bvh == nullptr) {
+    return nullptr;
+  }
+
+  Eigen::Vector3f origin, direction;
+  double maxDistance = INFINITY;
+  if (argc < 2 || !GetVector3Arg(env, argv[0], &origin) || !GetVector3Arg(env, argv[1], &direction) ||
+      !GetOptionalNumberArg(env, argc, argv, 2, INFINITY, &maxDistance)) {
+    napi_throw_type_error(env, nullptr, "raycast(origin: 3 numbers, direction: 3 numbers, maxDistance?: number)");
+    return nullptr;
+  }
+
+  const BoxBvh::Hit hit = bvh->raycast(Eigen::ParametrizedLine<float, 3>(origin, direction), (float)maxDistance);
+  return HitToJs(env, hit.index, hit.distance, (bool)hit);
+}
+
+// overlap(min, max) -> Uint32Array of box indices
+static napi_value BoxBvhOverlap(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  const BoxBvh* bvh = UnwrapThis<BoxBvh>(env, info, &argc, argv);
+  if (bvh == nullptr) {
+    return nullptr;
+  }
+
+  Eigen::Vector3f min, max;
+  if (argc < 2 || !GetVector3Arg(env, argv[0], &min) || !GetVector3Arg(env, argv[1], &max)) {
+    napi_throw_type_error(env, nullptr, "overlap(min: 3 numbers, max: 3 numbers)");
+    return nullptr;
+  }
+
+  std::vector<uint32_t> hits;
+  bvh->overlap(Eigen::AlignedBox3f(min, max), hits);
+  return CreateUint32Array(env, hits, "overlap");
+}
+
+// nearest(point, maxDistance = Infinity) -> { index, distance } | null
+static napi_value BoxBvhNearest(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  const BoxBvh* bvh = UnwrapThis<BoxBvh>(env, info, &argc, argv);
+  if (bvh == nullptr) {
+    return nullptr;
+  }
+
+  Eigen::Vector3f point;
+  double maxDistance = INFINITY;
+  if (argc < 1 || !GetVector3Arg(env, argv[0], &point) ||
+      !GetOptionalNumberArg(env, argc, argv, 1, INFINITY, &maxDistance)) {
+    napi_throw_type_error(env, nullptr, "nearest(point: 3 numbers, maxDistance?: number)");
+    return nullptr;
+  }
+
+  const BoxBvh::Hit hit = bvh->nearest(point, (float)maxDistance);
+  return HitToJs(env, hit.index, hit.distance, (bool)hit);
+}
+
+static void ExportBoxBvh(napi_env env, napi_value exports) {
+  const napi_property_descriptor props[] = {
+      {"size", nullptr, nullptr, BoxBvhSize, nullptr, nullptr, napi_default, nullptr},
+      {"refit", nullptr, BoxBvhRefit, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"raycast", nullptr, BoxBvhRaycast, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"overlap", nullptr, BoxBvhOverlap, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"nearest", nullptr, BoxBvhNearest, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"dispose", nullptr, DisposeWrapped<BoxBvh>, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  napi_value cls;
+  napi_define_class(
+      env, "BoxBvh", NAPI_AUTO_LENGTH, BoxBvhNew, nullptr, sizeof(props) / sizeof(props[0]), props, &cls);
+  napi_set_named_property(env, exports, "BoxBvh", cls);
+}
+
+// { triangle, distance, u, v, materialIndex } or null.
+static napi_value MeshHitToJs(napi_env env, const MeshBvh::Hit& hit) {
+  napi_value result;
+  if (!hit) {
+    napi_get_null(env, &result);
+    return result;
+  }
+  napi_value triangle, distance, u, v, material;
+  napi_create_object(env, &result);
+  napi_create_uint32(env, hit.triangle, &triangle);
+  napi_create_double(env, hit.distance, &distance);
+  napi_create_double(env, hit.u, &u);
+  napi_create_double(env, hit.v, &v);
+  napi_create_uint32(env, hit.materialIndex, &material);
+  napi_set_named_property(env, result, "triangle", triangle);
+  napi_set_named_property(env, result, "distance", distance);
+  napi_set_named_property(env, result, "u", u);
+  napi_set_named_property(env, result, "v", v);
+  napi_set_named_property(env, result, "materialIndex", material);
+  return result;
+}
+
+// Reads a MeshData-like object: vertices (required), indices and groups (optional).
+static bool GetMeshArg(
+    napi_env env,
+    napi_value mesh,
+    float** vertices,
+    size_t* vertexFloats,
+    uint32_t** indices,
+    size_t* indexCount,
+    std::vector<MeshDataCpp::Group>* groups) {
+  napi_value value;
+  if (napi_get_named_property(env, mesh, "vertices", &value) != napi_ok ||
+      !GetTypedArrayArg(env, value, napi_float32_array, vertices, vertexFloats)) {
+    return false;
+  }
+  if (napi_get_named_property(env, mesh, "indices", &value) != napi_ok ||
+      (!IsMissingArg(env, 1, &value, 0) && !GetTypedArrayArg(env, value, napi_uint32_array, indices, indexCount))) {
+    return false;
+  }
+  if (napi_get_named_property(env, mesh, "groups", &value) != napi_ok || IsMissingArg(env, 1, &value, 0)) {
+    return true;
+  }
+  uint32_t groupCount = 0;
+  if (napi_get_array_length(env, value, &groupCount) != napi_ok) {
+    return false;
+  }
+  for (uint32_t g = 0; g < groupCount; g++) {
+    napi_value group;
+    double start = -1.0, count = -1.0, materialIndex = 0.0;
+    if (napi_get_element(env, value, g, &group) != napi_ok || !GetOptionalNamedNumber(env, group, "start", &start) ||
+        !GetOptionalNamedNumber(env, group, "count", &count) ||
+        !GetOptionalNamedNumber(env, group, "materialIndex", &materialIndex) || !(start >= 0.0) || !(count >= 0.0)) {
+      return false;
+    }
+    groups->push_back(MeshDataCpp::Group{(uint32_t)start, (uint32_t)count, (uint32_t)materialIndex});
+  }
+  return true;
+}
+
+// new MeshBvh(mesh)
+static napi_value MeshBvhNew(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  napi_value self;
+  napi_get_cb_info(env, info, &argc, argv, &self, nullptr);
+
+  float* vertices = nullptr;
+  uint32_t* indices = nullptr;
+  size_t vertexFloats = 0, indexCount = 0;
+  std::vector<MeshDataCpp::Group> groups;
+  if (argc < 1 || !GetMeshArg(env, argv[0], &vertices, &vertexFloats, &indices, &indexCount, &groups)) {
+    napi_throw_type_error(
+        env, nullptr, "MeshBvh(mesh) expects { vertices: Float32Array, indices?: Uint32Array, groups?: [...] }");
+    return nullptr;
+  }
+
+  MeshBvh* bvh = new MeshBvh(vertices, vertexFloats / 3, indices, indexCount, groups.data(), groups.size());
+  if (napi_wrap(env, self, bvh, DeleteWrapped<MeshBvh>, nullptr, nullptr) != napi_ok) {
+    delete bvh;
+    napi_throw_error(env, nullptr, "Failed to wrap MeshBvh");
+    return nullptr;
+  }
+  return self;
+}
+
+static napi_value MeshBvhTriangleCount(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  const MeshBvh* bvh = UnwrapThis<MeshBvh>(env, info, &argc, nullptr);
+  if (bvh == nullptr) {
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_uint32(env, (uint32_t)bvh->triangle_count(), &result);
+  return result;
+}
+
+// raycast(origin, direction, maxDistance = Infinity) -> hit | null
+static napi_value MeshBvhRaycast(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  const MeshBvh* bvh = UnwrapThis<MeshBvh>(env, info, &argc, argv);
+  if (bvh == nullptr) {
+    return nullptr;
+  }
+
+  Eigen::Vector3f origin, direction;
+  double maxDistance = INFINITY;
+  if (argc < 2 || !GetVector3Arg(env, argv[0], &origin) || !GetVector3Arg(env, argv[1], &direction) ||
+      !GetOptionalNumberArg(env, argc, argv, 2, INFINITY, &maxDistance)) {
+    napi_throw_type_error(env, nullptr, "raycast(origin: 3 numbers, direction: 3 numbers, maxDistance?: number)");
+    return nullptr;
+  }
+
+  return MeshHitToJs(env, bvh->raycast(Eigen::ParametrizedLine<float, 3>(origin, direction), (float)maxDistance));
+}
+
+// raycastBatch(rays, maxDistance = Infinity) -> { triangle, distance, u, v, materialIndex } arrays,
+// triangle = 0xffffffff for a miss.
+static napi_value MeshBvhRaycastBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  const MeshBvh* bvh = UnwrapThis<MeshBvh>(env, info, &argc, argv);
+  if (bvh == nullptr) {
+    return nullptr;
+  }
+
+  float* rays = nullptr;
+  size_t rayFloats = 0;
+  double maxDistance = INFINITY;
+  if (argc < 1 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &rays, &rayFloats) || rayFloats % 6 != 0 ||
+      !GetOptionalNumberArg(env, argc, argv, 1, INFINITY, &maxDistance)) {
+    napi_throw_type_error(
+        env, nullptr, "raycastBatch(rays: planar [ox, oy, oz, dx, dy, dz] Float32Array, maxDistance?: number)");
+    return nullptr;
+  }
+
+  const size_t count = rayFloats / 6;
+  std::vector<MeshBvh::Hit> hits(count);
+  bvh->raycast_batch(ray_soa_planar(rays, count), count, (float)maxDistance, hits.data());
+
+  uint32_t* triangle = nullptr;
+  uint32_t* material = nullptr;
+  float* distance = nullptr;
+  float* u = nullptr;
+  float* v = nullptr;
+  napi_value arrays[5] = {
+      NewTypedArray(env, napi_uint32_array, count, sizeof(uint32_t), (void**)&triangle, "triangle"),
+      NewTypedArray(env, napi_float32_array, count, sizeof(float), (void**)&distance, "distance"),
+      NewTypedArray(env, napi_float32_array, count, sizeof(float), (void**)&u, "u"),
+      NewTypedArray(env, napi_float32_array, count, sizeof(float), (void**)&v, "v"),
+      NewTypedArray(env, napi_uint32_array, count, sizeof(uint32_t), (void**)&material, "materialIndex"),
+  };
+  for (napi_value a : arrays) {
+    if (a == nullptr) {
+      return nullptr;
+    }
+  }
+  for (size_t i = 0; i < count; i++) {
+    triangle[i] = hits[i].triangle;
+    distance[i] = hits[i].distance;
+    u[i] = hits[i].u;
+    v[i] = hits[i].v;
+    material[i] = hits[i].materialIndex;
+  }
+
+  napi_value result;
+  napi_create_object(env, &result);
+  const char* names[5] = {"triangle", "distance", "u", "v", "materialIndex"};
+  for (size_t k = 0; k < 5; k++) {
+    napi_set_named_property(env, result, names[k], arrays[k]);
+  }
+  return result;
+}
+
+static void ExportMeshBvh(napi_env env, napi_value exports) {
+  const napi_property_descriptor props[] = {
+      {"triangleCount", nullptr, nullptr, MeshBvhTriangleCount, nullptr, nullptr, napi_default, nullptr},
+      {"raycast", nullptr, MeshBvhRaycast, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"raycastBatch", nullptr, MeshBvhRaycastBatch, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"dispose", nullptr, DisposeWrapped<MeshBvh>, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  napi_value cls;
+  napi_define_class(
+      env, "MeshBvh", NAPI_AUTO_LENGTH, MeshBvhNew, nullptr, sizeof(props) / sizeof(props[0]), props, &cls);
+  napi_set_named_property(env, exports, "MeshBvh", cls);
+}
+
+// new SweepAndPrune(axis = 0)
+static napi_value SweepAndPruneNew(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  napi_value self;
+  napi_get_cb_info(env, info, &argc, argv, &self, nullptr);
+
+  double axis = 0.0;
+  if (!GetOptionalNumberArg(env, argc, argv, 0, 0.0, &axis) || !(axis == 0.0 || axis == 1.0 || axis == 2.0)) {
+    napi_throw_type_error(env, nullptr, "SweepAndPrune(axis?: 0 | 1 | 2)");
+    return nullptr;
+  }
+
+  SweepAndPrune* sap = new SweepAndPrune((int)axis);
+  if (napi_wrap(env, self, sap, DeleteWrapped<SweepAndPrune>, nullptr, nullptr) != napi_ok) {
+    delete sap;
+    napi_throw_error(env, nullptr, "Failed to wrap SweepAndPrune");
+    return nullptr;
+  }
+  return self;
+}
+
+static napi_value SweepAndPruneSize(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  const SweepAndPrune* sap = UnwrapThis<SweepAndPrune>(env, info, &argc, nullptr);
+  if (sap == nullptr) {
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_uint32(env, (uint32_t)sap->size(), &result);
+  return result;
+}
+
+// update(boxes) -> Uint32Array [addedCount, removedCount, added a/b pairs..., removed a/b pairs...]
+static napi_value SweepAndPruneUpdate(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  SweepAndPrune* sap = UnwrapThis<SweepAndPrune>(env, info, &argc, argv);
+  if (sap == nullptr) {
+    return nullptr;
+  }
+
+  float* boxes = nullptr;
+  size_t count = 0;
+  if (argc < 1 || !GetBoxesArg(env, argv[0], &boxes, &count)) {
+    napi_throw_type_error(env, nullptr, kBoxesUsage);
+    return nullptr;
+  }
+
+  std::vector<SweepAndPrune::Pair> added, removed;
+  sap->update(box_soa_planar(boxes, count), count, added, removed);
+
+  uint32_t* out = nullptr;
+  napi_value result = NewTypedArray(
+      env, napi_uint32_array, 2 + 2 * (added.size() + removed.size()), sizeof(uint32_t), (void**)&out, "pairs");
+  if (result == nullptr) {
+    return nullptr;
+  }
+  out[0] = (uint32_t)added.size();
+  out[1] = (uint32_t)removed.size();
+  std::memcpy(out + 2, added.data(), added.size() * sizeof(SweepAndPrune::Pair));
+  std::memcpy(out + 2 + 2 * added.size(), removed.data(), removed.size() * sizeof(SweepAndPrune::Pair));
+  return result;
+}
+
+// pairs() -> Uint32Array [a0, b0, a1, b1, ...]
+static napi_value SweepAndPrunePairs(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  const SweepAndPrune* sap = UnwrapThis<SweepAndPrune>(env, info, &argc, nullptr);
+  if (sap == nullptr) {
+    return nullptr;
+  }
+  const std::vector<SweepAndPrune::Pair>& pairs = sap->pairs();
+  return CreateTypedArray(env, napi_uint32_array, pairs.data(), pairs.size() * 2, sizeof(uint32_t), "pairs");
+}
+
+static void ExportSweepAndPrune(napi_env env, napi_value exports) {
+  const napi_property_descriptor props[] = {
+      {"size", nullptr, nullptr, SweepAndPruneSize, nullptr, nullptr, napi_default, nullptr},
+      {"update", nullptr, SweepAndPruneUpdate, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"pairs", nullptr, SweepAndPrunePairs, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"dispose", nullptr, DisposeWrapped<SweepAndPrune>, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  napi_value cls;
+  napi_define_class(
+      env, "SweepAndPrune", NAPI_AUTO_LENGTH, SweepAndPruneNew, nullptr, sizeof(props) / sizeof(props[0]), props, &cls);
+  napi_set_named_property(env, exports, "SweepAndPrune", cls);
+}
+
+// new PointGrid(points: Float32Array xyz, cellSize)
+static napi_value PointGridNew(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  napi_value self;
+  napi_get_cb_info(env, info, &argc, argv, &self, nullptr);
+
+  float* points = nullptr;
+  size_t floats = 0;
+  double cellSize = 0.0;
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &points, &floats) || floats % 3 != 0 ||
+      !GetNumberArg(env, argv[1], &cellSize) || !(cellSize > 0.0)) {
+    napi_throw_type_error(env, nullptr, "PointGrid(points: Float32Array of xyz, cellSize: number > 0)");
+    return nullptr;
+  }
+
+  PointGrid* grid = new PointGrid(points, floats / 3, (float)cellSize);
+  if (napi_wrap(env, self, grid, DeleteWrapped<PointGrid>, nullptr, nullptr) != napi_ok) {
+    delete grid;
+    napi_throw_error(env, nullptr, "Failed to wrap PointGrid");
+    return nullptr;
+  }
+  return self;
+}
+
+static napi_value PointGridSize(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  const PointGrid* grid = UnwrapThis<PointGrid>(env, info, &argc, nullptr);
+  if (grid == nullptr) {
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_uint32(env, (uint32_t)grid->size(), &result);
+  return result;
+}
+
+// radius(center, radius) -> Uint32Array of point indices
+static napi_value PointGridRadius(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  const PointGrid* grid = UnwrapThis<PointGrid>(env, info, &argc, argv);
+  if (grid == nullptr) {
+    return nullptr;
+  }
+
+  Eigen::Vector3f center;
+  double radius = 0.0;
+  if (argc < 2 || !GetVector3Arg(env, argv[0], &center) || !GetNumberArg(env, argv[1], &radius)) {
+    napi_throw_type_error(env, nullptr, "radius(center: 3 numbers, radius: number)");
+    return nullptr;
+  }
+
+  std::vector<uint32_t> hits;
+  grid->radius(center, (float)radius, hits);
+  return CreateUint32Array(env, hits, "radius");
+}
+
+// nearest(center, k, maxDistance = Infinity) -> { index: Uint32Array, distance: Float32Array }
+static napi_value PointGridNearest(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3];
+  const PointGrid* grid = UnwrapThis<PointGrid>(env, info, &argc, argv);
+  if (grid == nullptr) {
+    return nullptr;
+  }
+
+  Eigen::Vector3f center;
+  double k = 0.0;
+  double maxDistance = INFINITY;
+  if (argc < 2 || !GetVector3Arg(env, argv[0], &center) || !GetNumberArg(env, argv[1], &k) || !(k >= 0.0) ||
+      !GetOptionalNumberArg(env, argc, argv, 2, INFINITY, &maxDistance)) {
+    napi_throw_type_error(env, nullptr, "nearest(center: 3 numbers, k: number, maxDistance?: number)");
+    return nullptr;
+  }
+
+  std::vector<PointGrid::Neighbor> neighbors;
+  grid->nearest(center, (size_t)std::min(k, (double)grid->size()), (float)maxDistance, neighbors);
+
+  uint32_t* index = nullptr;
+  float* distance = nullptr;
+  napi_value indexArray =
+      NewTypedArray(env, napi_uint32_array, neighbors.size(), sizeof(uint32_t), (void**)&index, "index");
+  napi_value distanceArray =
+      NewTypedArray(env, napi_float32_array, neighbors.size(), sizeof(float), (void**)&distance, "distance");
+  if (indexArray == nullptr || distanceArray == nullptr) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < neighbors.size(); i++) {
+    index[i] = neighbors[i].index;
+    distance[i] = neighbors[i].distance;
+  }
+
+  napi_value result;
+  napi_create_object(env, &result);
+  napi_set_named_property(env, result, "index", indexArray);
+  napi_set_named_property(env, result, "distance", distanceArray);
+  return result;
+}
+
+static void ExportPointGrid(napi_env env, napi_value exports) {
+  const napi_property_descriptor props[] = {
+      {"size", nullptr, nullptr, PointGridSize, nullptr, nullptr, napi_default, nullptr},
+      {"radius", nullptr, PointGridRadius, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"nearest", nullptr, PointGridNearest, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"dispose", nullptr, DisposeWrapped<PointGrid>, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  napi_value cls;
+  napi_define_class(
+      env, "PointGrid", NAPI_AUTO_LENGTH, PointGridNew, nullptr, sizeof(props) / sizeof(props[0]), props, &cls);
+  napi_set_named_property(env, exports, "PointGrid", cls);
+}
+
+// new UmeyamaAccumulator()
+static napi_value UmeyamaNew(napi_env env, napi_callback_info info) {
+  napi_value self;
+  napi_get_cb_info(env, info, nullptr, nullptr, &self, nullptr);
+
+  UmeyamaAccumulator* acc = new UmeyamaAccumulator();
+  if (napi_wrap(env, self, acc, DeleteWrapped<UmeyamaAccumulator>, nullptr, nullptr) != napi_ok) {
+    delete acc;
+    napi_throw_error(env, nullptr, "Failed to wrap UmeyamaAccumulator");
+    return nullptr;
+  }
+  return self;
+}
+
+static napi_value UmeyamaCount(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  const UmeyamaAccumulator* acc = UnwrapThis<UmeyamaAccumulator>(env, info, &argc, nullptr);
+  if (acc == nullptr) {
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_double(env, (double)acc->count(), &result);
+  return result;
+}
+
+// add(src: Float32Array, dst: Float32Array): one chunk of xyz correspondences.
+static napi_value UmeyamaAdd(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  UmeyamaAccumulator* acc = UnwrapThis<UmeyamaAccumulator>(env, info, &argc, argv);
+  if (acc == nullptr) {
+    return nullptr;
+  }
+
+  float* src = nullptr;
+  float* dst = nullptr;
+  size_t srcFloats = 0, dstFloats = 0;
+  if (argc < 2 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &src, &srcFloats) ||
+      !GetTypedArrayArg(env, argv[1], napi_float32_array, &dst, &dstFloats) || srcFloats != dstFloats ||
+      srcFloats % 3 != 0) {
+    napi_throw_type_error(env, nullptr, "add(src: Float32Array, dst: Float32Array) with equal xyz lengths");
+    return nullptr;
+  }
+  acc->add(src, dst, srcFloats / 3);
+  return nullptr;
+}
+
+static napi_value UmeyamaClear(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  UmeyamaAccumulator* acc = UnwrapThis<UmeyamaAccumulator>(env, info, &argc, nullptr);
+  if (acc != nullptr) {
+    acc->clear();
+  }
+  return nullptr;
+}
+
+// solve(withScaling = true) -> column-major 4x4 Float32Array
+static napi_value UmeyamaSolve(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  const UmeyamaAccumulator* acc = UnwrapThis<UmeyamaAccumulator>(env, info, &argc, argv);
+  if (acc == nullptr) {
+    return nullptr;
+  }
+
+  bool withScaling = true;
+  if (!GetOptionalBoolArg(env, argc, argv, 0, true, &withScaling)) {
+    napi_throw_type_error(env, nullptr, "solve(withScaling?: boolean)");
+    return nullptr;
+  }
+
+  const Eigen::Matrix4f m = acc->solve(withScaling).cast<float>();
+  return CreateTypedArray(env, napi_float32_array, m.data(), 16, sizeof(float), "solve");
+}
+
+static void ExportUmeyamaAccumulator(napi_env env, napi_value exports) {
+  const napi_property_descriptor props[] = {
+      {"count", nullptr, nullptr, UmeyamaCount, nullptr, nullptr, napi_default, nullptr},
+      {"add", nullptr, UmeyamaAdd, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"clear", nullptr, UmeyamaClear, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"solve", nullptr, UmeyamaSolve, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"dispose", nullptr, DisposeWrapped<UmeyamaAccumulator>, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  napi_value cls;
+  napi_define_class(
+      env, "UmeyamaAccumulator", NAPI_AUTO_LENGTH, UmeyamaNew, nullptr, sizeof(props) / sizeof(props[0]), props,
+      &cls);
+  napi_set_named_property(env, exports, "UmeyamaAccumulator", cls);
+}
+
+// new IcpRegistration(target: Float32Array xyz)
+static napi_value IcpNew(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  napi_value self;
+  napi_get_cb_info(env, info, &argc, argv, &self, nullptr);
+
+  float* points = nullptr;
+  size_t floats = 0;
+  if (argc < 1 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &points, &floats) || floats % 3 != 0) {
+    napi_throw_type_error(env, nullptr, "IcpRegistration(target: Float32Array of xyz)");
+    return nullptr;
+  }
+
+  KdTree* tree = new KdTree(points, floats / 3);
+  if (napi_wrap(env, self, tree, DeleteWrapped<KdTree>, nullptr, nullptr) != napi_ok) {
+    delete tree;
+    napi_throw_error(env, nullptr, "Failed to wrap IcpRegistration");
+    return nullptr;
+  }
+  return self;
+}
+
+static napi_value IcpSize(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  const KdTree* tree = UnwrapThis<KdTree>(env, info, &argc, nullptr);
+  if (tree == nullptr) {
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_uint32(env, (uint32_t)tree->size(), &result);
+  return result;
+}
+
+static bool GetIcpOptions(napi_env env, napi_value obj, IcpOptions* options) {
+  double maxIterations = options->maxIterations;
+  double maxDistance = options->maxDistance;
+  double inlierFraction = options->inlierFraction;
+  if (!GetOptionalNamedNumber(env, obj, "maxIterations", &maxIterations) ||
+      !GetOptionalNamedNumber(env, obj, "maxDistance", &maxDistance) ||
+      !GetOptionalNamedNumber(env, obj, "inlierFraction", &inlierFraction) ||
+      !GetOptionalNamedNumber(env, obj, "tolerance", &options->tolerance) ||
+      !GetOptionalNamedBool(env, obj, "withScaling", &options->withScaling) || !(maxIterations >= 0.0) ||
+      !(inlierFraction > 0.0 && inlierFraction <= 1.0)) {
+    return false;
+  }
+  options->maxIterations = (uint32_t)std::min(maxIterations, 1e6);
+  options->maxDistance = (float)maxDistance;
+  options->inlierFraction = (float)inlierFraction;
+
+  napi_value initial;
+  napi_valuetype t;
+  if (napi_get_named_property(env, obj, "initial", &initial) != napi_ok || napi_typeof(env, initial, &t) != napi_ok) {
+    return false;
+  }
+  if (t != napi_undefined) {
+    float m[16];
+    if (!GetMatrix4Arg(env, initial, m)) {
+      return false;
+    }
+    options->initial = Eigen::Map<const Eigen::Matrix4f>(m).cast<double>();
+  }
+  return true;
+}
+
+// align(source: Float32Array xyz, options?) ->
+//   { matrix: Float32Array(16), converged, iterations: [{ pairs, rmsError, correspondenceMs, solveMs }] }
+static napi_value IcpAlign(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  const KdTree* tree = UnwrapThis<KdTree>(env, info, &argc, argv);
+  if (tree == nullptr) {
+    return nullptr;
+  }
+
+  float* source = nullptr;
+  size_t floats = 0;
+  IcpOptions options;
+  if (argc < 1 || !GetTypedArrayArg(env, argv[0], napi_float32_array, &source, &floats) || floats % 3 != 0 ||
+      (!IsMissingArg(env, argc, argv, 1) && !GetIcpOptions(env, argv[1], &options))) {
+    napi_throw_type_error(env, nullptr, "align(source: Float32Array of xyz, options?: IcpOptions)");
+    return nullptr;
+  }
+
+  const IcpResult fit = icp_align(*tree, source, floats / 3, options);
+
+  const Eigen::Matrix4f m = fit.transform.cast<float>();
+  napi_value matrix = CreateTypedArray(env, napi_float32_array, m.data(), 16, sizeof(float), "matrix");
+  if (matrix == nullptr) {
+    return nullptr;
+  }
+  napi_value iterations;
+  napi_create_array_with_length(env, fit.iterations.size(), &iterations);
+  for (size_t i = 0; i < fit.iterations.size(); i++) {
+    const IcpIteration& it = fit.iterations[i];
+    napi_value entry, pairs, rmsError, correspondenceMs, solveMs;
+    napi_create_object(env, &entry);
+    napi_create_uint32(env, it.pairs, &pairs);
+    napi_create_double(env, it.rmsError, &rmsError);
+    napi_create_double(env, it.correspondenceMs, &correspondenceMs);
+    napi_create_double(env, it.solveMs, &solveMs);
+    napi_set_named_property(env, entry, "pairs", pairs);
+    napi_set_named_property(env, entry, "rmsError", rmsError);
+    napi_set_named_property(env, entry, "correspondenceMs", correspondenceMs);
+    napi_set_named_property(env, entry, "solveMs", solveMs);
+    napi_set_element(env, iterations, (uint32_t)i, entry);
+  }
+
+  napi_value result, converged;
+  napi_create_object(env, &result);
+  napi_get_boolean(env, fit.converged, &converged);
+  napi_set_named_property(env, result, "matrix", matrix);
+  napi_set_named_property(env, result, "converged", converged);
+  napi_set_named_property(env, result, "iterations", iterations);
+  return result;
+}
+
+static void ExportIcpRegistration(napi_env env, napi_value exports) {
+  const napi_property_descriptor props[] = {
+      {"size", nullptr, nullptr, IcpSize, nullptr, nullptr, napi_default, nullptr},
+      {"align", nullptr, IcpAlign, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"dispose", nullptr, DisposeWrapped<KdTree>, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  napi_value cls;
+  napi_define_class(
+      env, "IcpRegistration", NAPI_AUTO_LENGTH, IcpNew, nullptr, sizeof(props) / sizeof(props[0]), props, &cls);
+  napi_set_named_property(env, exports, "IcpRegistration", cls);
+}
+
+// new TransformHierarchy(parents: Int32Array, topologically sorted, -1 = root)
+// The world matrices live in a JS-owned Float32Array exposed as the read-only
+// `world` property, so update() writes straight into memory the renderer reads.
+static napi_value TransformHierarchyNew(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  napi_value self;
+  napi_get_cb_info(env, info, &argc, argv, &self, nullptr);
+
+  int32_t* parents = nullptr;
+  size_t count = 0;
+  if (argc < 1 || !GetTypedArrayArg(env, argv[0], napi_int32_array, &parents, &count) ||
+      !TransformHierarchy::is_topological(parents, count)) {
+    napi_throw_type_error(
+        env, nullptr, "TransformHierarchy(parents: Int32Array with parents[i] in [0, i) or -1 for roots)");
+    return nullptr;
+  }
+
+  float* data = nullptr;
+  napi_value world = NewTypedArray(env, napi_float32_array, count * 16, sizeof(float), (void**)&data, "world");
+  if (world == nullptr) {
+    return nullptr;
+  }
+  const napi_property_descriptor worldProp = {"world", nullptr, nullptr, nullptr, nullptr, world, napi_enumerable,
+                                              nullptr};
+  napi_define_properties(env, self, 1, &worldProp);
+
+  TransformHierarchy* hierarchy = new TransformHierarchy(parents, count);
+  if (napi_wrap(env, self, hierarchy, DeleteWrapped<TransformHierarchy>, nullptr, nullptr) != napi_ok) {
+    delete hierarchy;
+    napi_throw_error(env, nullptr, "Failed to wrap TransformHierarchy");
+    return nullptr;
+  }
+  return self;
+}
+
+static napi_value TransformHierarchySize(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  const TransformHierarchy* hierarchy = UnwrapThis<TransformHierarchy>(env, info, &argc, nullptr);
+  if (hierarchy == nullptr) {
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_uint32(env, (uint32_t)hierarchy->size(), &result);
+  return result;
+}
+
+// setLocal(index, trs: 10 numbers [tx, ty, tz, qx, qy, qz, qw, sx, sy, sz])
+static napi_value TransformHierarchySetLocal(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  TransformHierarchy* hierarchy = UnwrapThis<TransformHierarchy>(env, info, &argc, argv);
+  if (hierarchy == nullptr) {
+    return nullptr;
+  }
+
+  double index = 0.0;
+  float trs[TransformHierarchy::kLocalFloats];
+  if (argc < 2 || !GetNumberArg(env, argv[0], &index) || !(index >= 0.0 && index < (double)hierarchy->size()) ||
+      index != std::floor(index) || !GetFloatsArg(env, argv[1], TransformHierarchy::kLocalFloats, trs)) {
+    napi_throw_type_error(env, nullptr, "setLocal(index: node index, trs: [tx, ty, tz, qx, qy, qz, qw, sx, sy, sz])");
+    return nullptr;
+  }
+  const uint32_t i = (uint32_t)index;
+  hierarchy->set_locals(&i, trs, 1);
+  return nullptr;
+}
+
+// setLocals(indices: Uint32Array, trs: Float32Array, 10 floats per index)
+static napi_value TransformHierarchySetLocals(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  TransformHierarchy* hierarchy = UnwrapThis<TransformHierarchy>(env, info, &argc, argv);
+  if (hierarchy == nullptr) {
+    return nullptr;
+  }
+
+  uint32_t* indices = nullptr;
+  float* trs = nullptr;
+  size_t count = 0, floats = 0;
+  bool valid = argc >= 2 && GetTypedArrayArg(env, argv[0], napi_uint32_array, &indices, &count) &&
+               GetTypedArrayArg(env, argv[1], napi_float32_array, &trs, &floats) &&
+               floats == count * TransformHierarchy::kLocalFloats;
+  for (size_t k = 0; valid && k < count; k++) {
+    valid = indices[k] < hierarchy->size();
+  }
+  if (!valid) {
+    napi_throw_type_error(
+        env, nullptr, "setLocals(indices: Uint32Array of node indices, trs: Float32Array with 10 floats per index)");
+    return nullptr;
+  }
+  hierarchy->set_locals(indices, trs, count);
+  return nullptr;
+}
+
+// update(parallel = false) -> number of world matrices recomputed
+static napi_value TransformHierarchyUpdate(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  napi_value self;
+  TransformHierarchy* hierarchy = UnwrapThis<TransformHierarchy>(env, info, &argc, argv, &self);
+  if (hierarchy == nullptr) {
+    return nullptr;
+  }
+  bool parallel = false;
+  if (!GetOptionalBoolArg(env, argc, argv, 0, false, &parallel)) {
+    napi_throw_type_error(env, nullptr, "update(parallel?: boolean)");
+    return nullptr;
+  }
+
+  // Looked up on every call rather than cached: a transferred (detached)
+  // buffer then fails the length check instead of being written through.
+  napi_value world;
+  float* data = nullptr;
+  size_t length = 0;
+  if (napi_get_named_property(env, self, "world", &world) != napi_ok ||
+      !GetTypedArrayArg(env, world, napi_float32_array, &data, &length) || length != hierarchy->size() * 16) {
+    napi_throw_error(env, nullptr, "TransformHierarchy world buffer was detached");
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_uint32(env, (uint32_t)hierarchy->update(data, parallel), &result);
+  return result;
+}
+
+static void ExportTransformHierarchy(napi_env env, napi_value exports) {
+  const napi_property_descriptor props[] = {
+      {"size", nullptr, nullptr, TransformHierarchySize, nullptr, nullptr, napi_default, nullptr},
+      {"setLocal", nullptr, TransformHierarchySetLocal, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"setLocals", nullptr, TransformHierarchySetLocals, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"update", nullptr, TransformHierarchyUpdate, nullptr, nullptr, nullptr, napi_default, nullptr},
+      {"dispose", nullptr, DisposeWrapped<TransformHierarchy>, nullptr, nullptr, nullptr, napi_default, nullptr},
+  };
+  napi_value cls;
+  napi_define_class(env, "TransformHierarchy", NAPI_AUTO_LENGTH, TransformHierarchyNew, nullptr,
+                    sizeof(props) / sizeof(props[0]), props, &cls);
+  napi_set_named_property(env, exports, "TransformHierarchy", cls);
+}
+
+static void ExportFunction(napi_env env, napi_value exports, const char* name, napi_callback cb, void* data = nullptr) {
+  napi_value fn;
+  napi_create_function(env, name, NAPI_AUTO_LENGTH, cb, data, &fn);
+  napi_set_named_property(env, exports, name, fn);
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  ExportFunction(env, exports, "makeBox", MakeBox);
+  ExportFunction(env, exports, "makePlane", MakePlane);
+  ExportFunction(env, exports, "makeCircle", MakeCircle);
+  ExportFunction(env, exports, "makeRing", MakeRing);
+  ExportFunction(env, exports, "makePolyhedron", MakePolyhedron);
+  for (const SolidEntry& entry : kSolids) {
+    ExportFunction(env, exports, entry.name, MakeSolid, const_cast<SolidEntry*>(&entry));
+  }
+  ExportFunction(env, exports, "triangulate", Triangulate);
+  ExportFunction(env, exports, "makeShape", MakeShape);
+  ExportFunction(env, exports, "makeExtrude", MakeExtrude);
+  ExportFunction(env, exports, "edgesGeometry", EdgesGeometry);
+  ExportFunction(env, exports, "wireframeIndices", WireframeIndices);
+  ExportFunction(env, exports, "quatMultiplyBatch", QuatMultiplyBatch);
+  ExportFunction(env, exports, "quatSlerpBatch", QuatSlerpBatch);
+  ExportFunction(env, exports, "quatNlerpBatch", QuatNlerpBatch);
+  ExportFunction(env, exports, "quatToEulerBatch", QuatToEulerBatch);
+  ExportFunction(env, exports, "eulerToQuatBatch", EulerToQuatBatch);
+  ExportFunction(env, exports, "convertRotationBatch", ConvertRotationBatch);
+  ExportFunction(env, exports, "invertAffineBatch", InvertAffineBatch);
+  ExportFunction(env, exports, "transformMesh", TransformMesh);
+  ExportFunction(env, exports, "skinLbs", SkinLbs);
+  ExportFunction(env, exports, "skinDqs", SkinDqs);
+  ExportFunction(env, exports, "transformBoxes", TransformBoxes);
+  ExportFunction(env, exports, "frustumPlanes", FrustumPlanes);
+  ExportFunction(env, exports, "cullBoxes", CullBoxes);
+  ExportBoxBvh(env, exports);
+  ExportMeshBvh(env, exports);
+  ExportSweepAndPrune(env, exports);
+  ExportPointGrid(env, exports);
+  ExportUmeyamaAccumulator(env, exports);
+  ExportIcpRegistration(env, exports);
+  ExportTransformHierarchy(env, exports);
   return exports;
 }
 
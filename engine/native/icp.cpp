@@ -0,0 +1,92 @@
+#include "icp.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "parallel.h"
+#include "umeyama.h"
+
+namespace {
+
+constexpr size_t kGrain = 1024;
+
+float elapsed_ms(std::chrono::steady_clock::time_point since) {
+  return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+}  // namespace
+
+IcpResult icp_align(const KdTree& target, const float* source, size_t count, const IcpOptions& options) {
+  IcpResult result;
+  result.transform = options.initial;
+  if (target.size() == 0 || count == 0) {
+    return result;
+  }
+
+  const float inlierFraction = std::min(std::max(options.inlierFraction, 0.0f), 1.0f);
+  std::vector<KdTree::Nearest> matches(count);
+  std::vector<float> distances;
+  std::vector<float> src, dst;
+  double previousRms = 0.0;
+
+  for (uint32_t iteration = 0; iteration < options.maxIterations; iteration++) {
+    const auto start = std::chrono::steady_clock::now();
+    const Eigen::Matrix4f transform = result.transform.cast<float>();
+    const Eigen::Matrix3f linear = transform.topLeftCorner<3, 3>();
+    const Eigen::Vector3f translation = transform.topRightCorner<3, 1>();
+
+    parallel::parallel_for(count, kGrain, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        const Eigen::Vector3f p = linear * Eigen::Map<const Eigen::Vector3f>(source + i * 3) + translation;
+        matches[i] = target.nearest(p, options.maxDistance);
+      }
+    });
+
+    // Distance percentile: keep pairs at or below the inlierFraction quantile.
+    distances.clear();
+    for (const KdTree::Nearest& m : matches) {
+      if (m) {
+        distances.push_back(m.distance);
+      }
+    }
+    float cutoff = INFINITY;
+    if (!distances.empty() && inlierFraction < 1.0f) {
+      const size_t keep = std::max<size_t>(1, (size_t)std::ceil(inlierFraction * (double)distances.size()));
+      std::nth_element(distances.begin(), distances.begin() + (keep - 1), distances.end());
+      cutoff = distances[keep - 1];
+    }
+
+    src.clear();
+    dst.clear();
+    double squares = 0.0;
+    for (size_t i = 0; i < count; i++) {
+      const KdTree::Nearest& m = matches[i];
+      if (m && m.distance <= cutoff) {
+        src.insert(src.end(), source + i * 3, source + i * 3 + 3);
+        dst.insert(dst.end(), m.point.data(), m.point.data() + 3);
+        squares += (double)m.distance * m.distance;
+      }
+    }
+    const size_t pairs = src.size() / 3;
+    const double rms = pairs > 0 ? std::sqrt(squares / (double)pairs) : 0.0;
+    const float correspondenceMs = elapsed_ms(start);
+
+    if (pairs < 3) {
+      result.iterations.push_back(IcpIteration{(uint32_t)pairs, (float)rms, correspondenceMs, 0.0f});
+      break;
+    }
+
+    const auto solveStart = std::chrono::steady_clock::now();
+    UmeyamaAccumulator acc;
+    acc.add(src.data(), dst.data(), pairs);
+    result.transform = acc.solve(options.withScaling, UmeyamaSolver::Horn);
+    result.iterations.push_back(IcpIteration{(uint32_t)pairs, (float)rms, correspondenceMs, elapsed_ms(solveStart)});
+
+    if (iteration > 0 && std::abs(previousRms - rms) <= options.tolerance * previousRms) {
+      result.converged = true;
+      break;
+    }
+    previousRms = rms;
+  }
+  return result;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "kd_tree.h"
+
+// Point-to-point ICP registration of a source point cloud onto a target
+// (scanned geometry onto editor meshes).
+//
+// Each iteration matches every transformed source point to its nearest target
+// point through a KdTree (in parallel chunks on the parallel:: pool), drops
+// pairs farther than maxDistance and then all but the closest inlierFraction
+// of the rest (distance percentile, via nth_element), and re-solves the full
+// source -> target transform from the original source points with the
+// streaming Umeyama accumulator and Horn's closed-form rotation. It stops
+// when the RMS pair distance improves by less than `tolerance` (relative), or
+// after maxIterations.
+struct IcpOptions {
+  uint32_t maxIterations = 30;
+  float maxDistance = INFINITY;
+  float inlierFraction = 0.9f;  // in (0, 1]
+  double tolerance = 1e-5;
+  bool withScaling = false;
+  Eigen::Matrix4d initial = Eigen::Matrix4d::Identity();
+};
+
+struct IcpIteration {
+  uint32_t pairs;             // correspondences kept for the solve
+  float rmsError;             // RMS distance of those pairs, before this iteration's update
+  float correspondenceMs;     // nearest-neighbour search and rejection
+  float solveMs;              // Umeyama solve
+};
+
+struct IcpResult {
+  Eigen::Matrix4d transform = Eigen::Matrix4d::Identity();
+  std::vector<IcpIteration> iterations;
+  bool converged = false;  // false when maxIterations ran out or fewer than 3 pairs were left
+};
+
+// `source` is xyz-interleaved.
+IcpResult icp_align(const KdTree& target, const float* source, size_t count, const IcpOptions& options);
@@ -0,0 +1,119 @@
+#include "kd_tree.h"
+
+#include <algorithm>
+
+namespace {
+
+// Deep enough for any median-split tree over 2^32 points.
+constexpr size_t kStackSize = 64;
+
+}  // namespace
+
+KdTree::KdTree(const float* points, size_t count) {
+  std::vector<BuildPoint> buildPoints;
+  buildPoints.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    const Eigen::Vector3f p(points[i * 3 + 0], points[i * 3 + 1], points[i * 3 + 2]);
+    if (p.allFinite()) {
+      buildPoints.push_back(BuildPoint{p, (uint32_t)i});
+    }
+  }
+  if (buildPoints.empty()) {
+    return;
+  }
+
+  nodes_.reserve(4 * (buildPoints.size() / kMaxLeafSize + 1));
+  build(buildPoints, 0, buildPoints.size());
+
+  points_.resize(buildPoints.size());
+  indices_.resize(buildPoints.size());
+  for (size_t i = 0; i < buildPoints.size(); i++) {
+    points_[i] = buildPoints[i].point;
+    indices_[i] = buildPoints[i].index;
+  }
+}
+
+uint32_t KdTree::build(std::vector<BuildPoint>& points, size_t begin, size_t end) {
+  const uint32_t nodeIndex = (uint32_t)nodes_.size();
+  nodes_.push_back(Node{0.0f, kLeaf, (uint32_t)begin, (uint32_t)(end - begin)});
+  if (end - begin <= kMaxLeafSize) {
+    return nodeIndex;
+  }
+
+  Eigen::Vector3f lo = points[begin].point, hi = points[begin].point;
+  for (size_t i = begin + 1; i < end; i++) {
+    lo = lo.cwiseMin(points[i].point);
+    hi = hi.cwiseMax(points[i].point);
+  }
+  Eigen::Index axis;
+  if (!((hi - lo).maxCoeff(&axis) > 0.0f)) {
+    return nodeIndex;  // all points coincide
+  }
+
+  const size_t mid = begin + (end - begin) / 2;
+  std::nth_element(
+      points.begin() + begin, points.begin() + mid, points.begin() + end,
+      [axis](const BuildPoint& a, const BuildPoint& b) { return a.point[axis] < b.point[axis]; });
+
+  nodes_[nodeIndex].split = points[mid].point[axis];
+  nodes_[nodeIndex].axis = (uint32_t)axis;
+  build(points, begin, mid);
+  const uint32_t right = build(points, mid, end);
+  nodes_[nodeIndex].rightOrFirst = right;
+  return nodeIndex;
+}
+
+KdTree::Nearest KdTree::nearest(const Eigen::Vector3f& query, float maxDistance) const {
+  Nearest best;
+  if (nodes_.empty() || !(maxDistance >= 0.0f)) {
+    return best;
+  }
+
+  float best2 = maxDistance * maxDistance;
+  uint32_t bestSlot = kNone;
+
+  struct Pending {
+    uint32_t node;
+    float planeDistance2;
+  };
+  Pending stack[kStackSize];
+  size_t top = 0;
+  stack[top++] = Pending{0, 0.0f};
+
+  while (top > 0) {
+    const Pending pending = stack[--top];
+    if (pending.planeDistance2 > best2) {
+      continue;
+    }
+    uint32_t nodeIndex = pending.node;
+    for (;;) {
+      const Node& node = nodes_[nodeIndex];
+      if (node.is_leaf()) {
+        for (uint32_t slot = node.rightOrFirst; slot < node.rightOrFirst + node.count; slot++) {
+          const float d2 = (points_[slot] - query).squaredNorm();
+          if (d2 < best2 || (d2 == best2 && bestSlot == kNone)) {
+            best2 = d2;
+            bestSlot = slot;
+          }
+        }
+        break;
+      }
+      // Descend the query's side first; the other side waits on the stack
+      // with its distance to the splitting plane.
+      const float diff = query[node.axis] - node.split;
+      const uint32_t nearChild = diff < 0.0f ? nodeIndex + 1 : node.rightOrFirst;
+      const uint32_t farChild = diff < 0.0f ? node.rightOrFirst : nodeIndex + 1;
+      if (diff * diff <= best2 && top < kStackSize) {
+        stack[top++] = Pending{farChild, diff * diff};
+      }
+      nodeIndex = nearChild;
+    }
+  }
+
+  if (bestSlot != kNone) {
+    best.index = indices_[bestSlot];
+    best.distance = std::sqrt(best2);
+    best.point = points_[bestSlot];
+  }
+  return best;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+// Static k-d tree over a point set for nearest-neighbour queries with no
+// natural cell size (ICP correspondences, snapping to scanned geometry); see
+// PointGrid in point_grid.h when a query radius is known up front.
+//
+// Built top-down by splitting at the median of the widest axis of each node's
+// points (nth_element), down to leaves of at most kMaxLeafSize points, so the
+// tree is balanced and at most ~log2(n / 8) deep. Nodes are stored flat in
+// depth-first order (the left child is the next node) and the points are
+// copied into leaf order, so a leaf scan reads contiguous memory. Points with
+// non-finite coordinates are left out.
+class KdTree {
+ public:
+  static constexpr uint32_t kNone = 0xffffffffu;
+  static constexpr size_t kMaxLeafSize = 8;
+
+  struct Nearest {
+    uint32_t index = kNone;  // point index passed to the constructor, kNone when nothing was found
+    float distance = 0.0f;
+    Eigen::Vector3f point = Eigen::Vector3f::Zero();
+
+    explicit operator bool() const { return index != kNone; }
+  };
+
+  KdTree() = default;
+  // `points` is xyz-interleaved.
+  KdTree(const float* points, size_t count);
+
+  // The point closest to `query` within maxDistance (inclusive); equal
+  // distances resolve to any of the tied points.
+  Nearest nearest(const Eigen::Vector3f& query, float maxDistance = INFINITY) const;
+
+  size_t size() const { return points_.size(); }
+
+ private:
+  struct Node {
+    float split;            // interior: splitting coordinate
+    uint32_t axis;          // interior: 0..2; leaf: kLeaf
+    uint32_t rightOrFirst;  // interior: right child node; leaf: first point slot
+    uint32_t count;         // leaf point count
+
+    bool is_leaf() const { return axis == kLeaf; }
+  };
+  static constexpr uint32_t kLeaf = 3;
+
+  struct BuildPoint {
+    Eigen::Vector3f point;
+    uint32_t index;
+  };
+
+  uint32_t build(std::vector<BuildPoint>& points, size_t begin, size_t end);
+
+  std::vector<Node> nodes_;
+  std::vector<Eigen::Vector3f> points_;  // leaf order
+  std::vector<uint32_t> indices_;        // original index per slot
+};
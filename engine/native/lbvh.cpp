@@ -0,0 +1,326 @@
+#include "lbvh.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "parallel.h"
+
+namespace {
+
+using Box = Eigen::AlignedBox3f;
+using Eigen::Vector3f;
+using Node = BoxBvh::Node;
+
+const uint32_t kEmptyCode = 0xffffffffu;  // sorts after every 30-bit code
+const size_t kGrain = 4096;
+
+Box load_box(const ConstBoxSoA& boxes, size_t i) {
+  return Box(
+      Vector3f(boxes.minX[i], boxes.minY[i], boxes.minZ[i]), Vector3f(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]));
+}
+
+int clz32(uint32_t x) {
+#if defined(__GNUC__)
+  return x ? __builtin_clz(x) : 32;
+#else
+  int n = 0;
+  for (uint32_t bit = 0x80000000u; bit != 0 && (x & bit) == 0; bit >>= 1) {
+    n++;
+  }
+  return n;
+#endif
+}
+
+// Spreads the low 10 bits of v so there are two zero bits between each.
+uint32_t expand_bits(uint32_t v) {
+  v = (v * 0x00010001u) & 0xff0000ffu;
+  v = (v * 0x00000101u) & 0x0f00f00fu;
+  v = (v * 0x00000011u) & 0xc30c30c3u;
+  v = (v * 0x00000005u) & 0x49249249u;
+  return v;
+}
+
+uint32_t morton3(const Vector3f& unit) {
+  const Vector3f q = (unit * 1024.0f).cwiseMax(0.0f).cwiseMin(1023.0f);
+  return (expand_bits((uint32_t)q.x()) << 2) | (expand_bits((uint32_t)q.y()) << 1) | expand_bits((uint32_t)q.z());
+}
+
+// Stable LSD radix sort of (keys, values) by key, 8 bits per pass. Each chunk
+// histograms its own range, so the scatter can run per chunk as well. Passes
+// whose digit is the same for every key are skipped.
+void radix_sort(std::vector<uint32_t>& keys, std::vector<uint32_t>& values) {
+  const size_t n = keys.size();
+  std::vector<uint32_t> keysTmp(n);
+  std::vector<uint32_t> valuesTmp(n);
+  const size_t chunks = parallel::chunk_count(n, kGrain);
+  std::vector<uint32_t> offsets(chunks * 256);
+
+  for (int shift = 0; shift < 32; shift += 8) {
+    parallel::for_each_chunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+      uint32_t* hist = offsets.data() + c * 256;
+      std::fill(hist, hist + 256, 0u);
+      for (size_t i = begin; i < end; i++) {
+        hist[(keys[i] >> shift) & 0xff]++;
+      }
+    });
+
+    // offsets[c][d] = keys with a smaller digit + keys with digit d in earlier chunks
+    uint32_t sum = 0;
+    bool trivial = false;
+    for (size_t d = 0; d < 256; d++) {
+      uint32_t digitTotal = 0;
+      for (size_t c = 0; c < chunks; c++) {
+        const uint32_t h = offsets[c * 256 + d];
+        offsets[c * 256 + d] = sum + digitTotal;
+        digitTotal += h;
+      }
+      trivial = trivial || digitTotal == n;
+      sum += digitTotal;
+    }
+    if (trivial) {
+      continue;
+    }
+
+    parallel::for_each_chunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+      uint32_t* next = offsets.data() + c * 256;
+      for (size_t i = begin; i < end; i++) {
+        const uint32_t slot = next[(keys[i] >> shift) & 0xff]++;
+        keysTmp[slot] = keys[i];
+        valuesTmp[slot] = values[i];
+      }
+    });
+    keys.swap(keysTmp);
+    values.swap(valuesTmp);
+  }
+}
+
+// Binary radix tree over sorted codes. Interior node i (n - 1 of them, root 0)
+// covers leaves [first, last]; a child id is a leaf (sorted slot) when its
+// leaf flag is set, else an interior node.
+struct RadixTree {
+  struct Interior {
+    uint32_t left, right;
+    bool leftIsLeaf, rightIsLeaf;
+    uint32_t first, last;
+  };
+
+  std::vector<Interior> interior;
+  std::vector<uint32_t> leafParent;
+  std::vector<uint32_t> interiorParent;
+};
+
+// Length of the common prefix of codes i and j (index bits appended for equal
+// codes), or -1 when j is out of range.
+int common_prefix(const std::vector<uint32_t>& codes, int64_t n, int64_t i, int64_t j) {
+  if (j < 0 || j >= n) {
+    return -1;
+  }
+  const uint32_t x = codes[(size_t)i] ^ codes[(size_t)j];
+  return x != 0 ? clz32(x) : 32 + clz32((uint32_t)i ^ (uint32_t)j);
+}
+
+RadixTree::Interior build_interior(const std::vector<uint32_t>& codes, int64_t n, int64_t i) {
+  // Direction of the range: towards the neighbour sharing the longer prefix.
+  const int64_t d = common_prefix(codes, n, i, i + 1) > common_prefix(codes, n, i, i - 1) ? 1 : -1;
+  const int minPrefix = common_prefix(codes, n, i, i - d);
+
+  // Exponential then binary search for the other end of the range.
+  int64_t maxLength = 2;
+  while (common_prefix(codes, n, i, i + maxLength * d) > minPrefix) {
+    maxLength *= 2;
+  }
+  int64_t length = 0;
+  for (int64_t step = maxLength / 2; step >= 1; step /= 2) {
+    if (common_prefix(codes, n, i, i + (length + step) * d) > minPrefix) {
+      length += step;
+    }
+  }
+  const int64_t j = i + length * d;
+
+  // Binary search for the split: the last leaf sharing more than the range's prefix with i.
+  const int nodePrefix = common_prefix(codes, n, i, j);
+  int64_t split = 0;
+  for (int64_t div = 2;; div *= 2) {
+    const int64_t step = (length + div - 1) / div;
+    if (common_prefix(codes, n, i, i + (split + step) * d) > nodePrefix) {
+      split += step;
+    }
+    if (step <= 1) {
+      break;
+    }
+  }
+  const int64_t gamma = i + split * d + std::min<int64_t>(d, 0);
+
+  RadixTree::Interior node;
+  node.first = (uint32_t)std::min(i, j);
+  node.last = (uint32_t)std::max(i, j);
+  node.left = (uint32_t)gamma;
+  node.right = (uint32_t)gamma + 1;
+  node.leftIsLeaf = node.first == node.left;
+  node.rightIsLeaf = node.last == node.right;
+  return node;
+}
+
+// One pending node of the depth-first emission.
+struct EmitTask {
+  uint32_t id;
+  bool isLeaf;
+  uint32_t pos;
+};
+
+}  // namespace
+
+BoxBvh build_lbvh(ConstBoxSoA boxes, size_t count) {
+  // Centroid bounds (per-chunk partial boxes, merged serially).
+  const size_t boundChunks = parallel::chunk_count(count, kGrain);
+  std::vector<Box> partial(boundChunks, Box());
+  parallel::for_each_chunk(count, boundChunks, [&](size_t c, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const Box b = load_box(boxes, i);
+      if (!b.isEmpty()) {
+        partial[c].extend(b.center());
+      }
+    }
+  });
+  Box centroidBounds;
+  for (const Box& b : partial) {
+    centroidBounds.extend(b);
+  }
+  if (centroidBounds.isEmpty()) {
+    return BoxBvh({}, {}, {}, count);
+  }
+
+  const Vector3f origin = centroidBounds.min();
+  const Vector3f extent = centroidBounds.sizes();
+  const Vector3f scale(
+      extent.x() > 0.0f ? 1.0f / extent.x() : 0.0f,
+      extent.y() > 0.0f ? 1.0f / extent.y() : 0.0f,
+      extent.z() > 0.0f ? 1.0f / extent.z() : 0.0f);
+
+  std::vector<uint32_t> codes(count);
+  std::vector<uint32_t> order(count);
+  parallel::parallel_for(count, kGrain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const Box b = load_box(boxes, i);
+      codes[i] = b.isEmpty() ? kEmptyCode : morton3((b.center() - origin).cwiseProduct(scale));
+      order[i] = (uint32_t)i;
+    }
+  });
+  radix_sort(codes, order);
+
+  // Empty boxes sorted to the end; drop them.
+  const size_t n = (size_t)(std::lower_bound(codes.begin(), codes.end(), kEmptyCode) - codes.begin());
+  codes.resize(n);
+  order.resize(n);
+
+  std::vector<Box> leafBoxes(n);
+  parallel::parallel_for(n, kGrain, [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; k++) {
+      leafBoxes[k] = load_box(boxes, order[k]);
+    }
+  });
+
+  if (n <= kLbvhLeafSize) {
+    Box all;
+    for (const Box& b : leafBoxes) {
+      all.extend(b);
+    }
+    return BoxBvh({Node{all, 0, (uint32_t)n}}, std::move(order), std::move(leafBoxes), count);
+  }
+
+  RadixTree tree;
+  tree.interior.resize(n - 1);
+  tree.leafParent.resize(n);
+  tree.interiorParent.resize(n - 1);
+  tree.interiorParent[0] = BoxBvh::kNone;
+  parallel::parallel_for(n - 1, kGrain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const RadixTree::Interior node = build_interior(codes, (int64_t)n, (int64_t)i);
+      tree.interior[i] = node;
+      (node.leftIsLeaf ? tree.leafParent : tree.interiorParent)[node.left] = (uint32_t)i;
+      (node.rightIsLeaf ? tree.leafParent : tree.interiorParent)[node.right] = (uint32_t)i;
+    }
+  });
+
+  // Bottom-up bounds and emitted-subtree sizes. Each leaf walks towards the
+  // root; at every node the first arrival stops and the second (which then
+  // sees both children finished) merges them and continues.
+  std::vector<Box> interiorBounds(n - 1);
+  std::vector<uint32_t> subtreeNodes(n - 1);
+  std::unique_ptr<std::atomic<uint32_t>[]> arrivals(new std::atomic<uint32_t>[n - 1]);
+  parallel::parallel_for(n - 1, kGrain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      arrivals[i].store(0, std::memory_order_relaxed);
+    }
+  });
+  const auto child_bounds = [&](uint32_t id, bool isLeaf) -> const Box& {
+    return isLeaf ? leafBoxes[id] : interiorBounds[id];
+  };
+  const auto child_nodes = [&](uint32_t id, bool isLeaf) -> uint32_t {
+    return isLeaf ? 1 : subtreeNodes[id];
+  };
+  parallel::parallel_for(n, kGrain, [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; k++) {
+      for (uint32_t p = tree.leafParent[k]; p != BoxBvh::kNone; p = tree.interiorParent[p]) {
+        if (arrivals[p].fetch_add(1, std::memory_order_acq_rel) == 0) {
+          break;
+        }
+        const RadixTree::Interior& node = tree.interior[p];
+        interiorBounds[p] =
+            child_bounds(node.left, node.leftIsLeaf).merged(child_bounds(node.right, node.rightIsLeaf));
+        subtreeNodes[p] = node.last - node.first + 1 <= kLbvhLeafSize
+            ? 1
+            : 1 + child_nodes(node.left, node.leftIsLeaf) + child_nodes(node.right, node.rightIsLeaf);
+      }
+    }
+  });
+
+  // Depth-first emission: a node at `pos` has its left child at pos + 1 and
+  // its right child after the whole left subtree. The top of the tree is
+  // expanded serially into independent subtrees, which are then written in
+  // parallel.
+  std::vector<Node> nodes(subtreeNodes[0]);
+  const auto emit = [&](const EmitTask& task, std::vector<EmitTask>& children) {
+    if (task.isLeaf) {
+      nodes[task.pos] = Node{leafBoxes[task.id], task.id, 1};
+      return;
+    }
+    const RadixTree::Interior& node = tree.interior[task.id];
+    const uint32_t size = node.last - node.first + 1;
+    if (size <= kLbvhLeafSize) {
+      nodes[task.pos] = Node{interiorBounds[task.id], node.first, size};
+      return;
+    }
+    const uint32_t rightPos = task.pos + 1 + child_nodes(node.left, node.leftIsLeaf);
+    nodes[task.pos] = Node{interiorBounds[task.id], rightPos, 0};
+    children.push_back(EmitTask{node.right, node.rightIsLeaf, rightPos});
+    children.push_back(EmitTask{node.left, node.leftIsLeaf, task.pos + 1});
+  };
+
+  std::vector<EmitTask> frontier{EmitTask{0, false, 0}};
+  const size_t wanted = 8 * parallel::thread_count();
+  while (frontier.size() < wanted) {
+    std::vector<EmitTask> next;
+    for (const EmitTask& task : frontier) {
+      emit(task, next);
+    }
+    if (next.empty()) {
+      frontier.clear();
+      break;
+    }
+    frontier.swap(next);
+  }
+  parallel::run(frontier.size(), [&](size_t t) {
+    std::vector<EmitTask> stack{frontier[t]};
+    while (!stack.empty()) {
+      const EmitTask task = stack.back();
+      stack.pop_back();
+      emit(task, stack);
+    }
+  });
+
+  return BoxBvh(std::move(nodes), std::move(order), std::move(leafBoxes), count);
+}
@@ -0,0 +1,312 @@
+#include "mesh_bvh.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+#include "simd.h"
+
+namespace {
+
+using Eigen::Vector3f;
+using simd::vfloat;
+using simd::vmask;
+
+const float kInfinity = std::numeric_limits<float>::infinity();
+
+// 1 / d with zero components mapped to +-1 / FLT_MIN: slab distances then
+// become huge (or +-inf) but never 0 * inf = NaN.
+Vector3f safe_inverse(const Vector3f& d) {
+  Vector3f inv;
+  for (int axis = 0; axis < 3; axis++) {
+    inv[axis] = 1.0f / (std::abs(d[axis]) < FLT_MIN ? std::copysign(FLT_MIN, d[axis]) : d[axis]);
+  }
+  return inv;
+}
+
+float ray_enter(const Vector3f& origin, const Vector3f& invDir, const Eigen::AlignedBox3f& b, float maxT) {
+  const Vector3f t1 = (b.min() - origin).cwiseProduct(invDir);
+  const Vector3f t2 = (b.max() - origin).cwiseProduct(invDir);
+  const float tNear = std::max(0.0f, t1.cwiseMin(t2).maxCoeff());
+  const float tFar = std::min(maxT, t1.cwiseMax(t2).minCoeff());
+  return tNear <= tFar ? tNear : kInfinity;
+}
+
+// Packet of simd::kWidth rays; `best` doubles as each lane's current tMax.
+struct Packet {
+  vfloat o[3];
+  vfloat inv[3];
+  vfloat d[3];
+  vfloat best;
+};
+
+inline bool packet_enters(const Packet& p, const Eigen::AlignedBox3f& b) {
+  vfloat tNear = simd::splat(0.0f);
+  vfloat tFar = p.best;
+  for (int axis = 0; axis < 3; axis++) {
+    const vfloat t1 = (simd::splat(b.min()[axis]) - p.o[axis]) * p.inv[axis];
+    const vfloat t2 = (simd::splat(b.max()[axis]) - p.o[axis]) * p.inv[axis];
+    tNear = simd::max(tNear, simd::min(t1, t2));
+    tFar = simd::min(tFar, simd::max(t1, t2));
+  }
+  return simd::any(tNear <= tFar);
+}
+
+uint32_t material_of(size_t firstIndex, const MeshDataCpp::Group* groups, size_t groupCount) {
+  for (size_t g = 0; g < groupCount; g++) {
+    if (firstIndex >= groups[g].start && firstIndex < (size_t)groups[g].start + groups[g].count) {
+      return groups[g].materialIndex;
+    }
+  }
+  return 0;
+}
+
+}  // namespace
+
+MeshBvh::MeshBvh(
+    const float* positions,
+    size_t vertexCount,
+    const uint32_t* indices,
+    size_t indexCount,
+    const MeshDataCpp::Group* groups,
+    size_t groupCount) {
+  const bool indexed = indices != nullptr && indexCount > 0;
+  triangleCount_ = (indexed ? indexCount : vertexCount) / 3;
+
+  // Triangle bounds as planar SoA boxes for BoxBvh; invalid triangles get an
+  // empty box so the build leaves them out.
+  std::vector<float> boxes(6 * triangleCount_);
+  const BoxSoA soa = box_soa_planar(boxes.data(), triangleCount_);
+  std::vector<Triangle> all(triangleCount_);
+  for (size_t t = 0; t < triangleCount_; t++) {
+    uint32_t idx[3];
+    bool valid = true;
+    for (int k = 0; k < 3; k++) {
+      idx[k] = indexed ? indices[t * 3 + k] : (uint32_t)(t * 3 + k);
+      valid = valid && idx[k] < vertexCount;
+    }
+    if (!valid) {
+      soa.minX[t] = soa.minY[t] = soa.minZ[t] = kInfinity;
+      soa.maxX[t] = soa.maxY[t] = soa.maxZ[t] = -kInfinity;
+      continue;
+    }
+    const Eigen::Map<const Vector3f> a(positions + (size_t)idx[0] * 3);
+    const Eigen::Map<const Vector3f> b(positions + (size_t)idx[1] * 3);
+    const Eigen::Map<const Vector3f> c(positions + (size_t)idx[2] * 3);
+    all[t] = Triangle{a, b - a, c - a};
+    const Vector3f lo = a.cwiseMin(b).cwiseMin(c);
+    const Vector3f hi = a.cwiseMax(b).cwiseMax(c);
+    soa.minX[t] = lo.x();
+    soa.minY[t] = lo.y();
+    soa.minZ[t] = lo.z();
+    soa.maxX[t] = hi.x();
+    soa.maxY[t] = hi.y();
+    soa.maxZ[t] = hi.z();
+  }
+
+  bvh_.build(soa, triangleCount_);
+  const std::vector<uint32_t>& order = bvh_.primitives();
+  triangles_.resize(order.size());
+  materials_.resize(order.size());
+  for (size_t k = 0; k < order.size(); k++) {
+    triangles_[k] = all[order[k]];
+    materials_[k] = material_of((size_t)order[k] * 3, groups, groupCount);
+  }
+}
+
+MeshBvh::MeshBvh(const MeshDataCpp& mesh)
+    : MeshBvh(
+          mesh.vertices.data(),
+          mesh.vertices.size() / 3,
+          mesh.indices.data(),
+          mesh.indices.size(),
+          mesh.groups.data(),
+          mesh.groups.size()) {}
+
+MeshBvh::Hit MeshBvh::raycast(const Eigen::ParametrizedLine<float, 3>& ray, float maxT) const {
+  Hit hit;
+  const std::vector<BoxBvh::Node>& nodes = bvh_.nodes();
+  if (nodes.empty()) {
+    return hit;
+  }
+  const Vector3f& origin = ray.origin();
+  const Vector3f& dir = ray.direction();
+  const Vector3f invDir = safe_inverse(dir);
+
+  float best = maxT;
+  uint32_t bestSlot = kNone;
+  uint32_t stack[BoxBvh::kMaxDepth];
+  size_t top = 0;
+  uint32_t node = 0;
+  if (ray_enter(origin, invDir, nodes[0].bounds, best) == kInfinity) {
+    return hit;
+  }
+  for (;;) {
+    const BoxBvh::Node& n = nodes[node];
+    if (n.is_leaf()) {
+      for (uint32_t k = n.rightOrFirst; k < n.rightOrFirst + n.count; k++) {
+        // Moller-Trumbore.
+        const Triangle& tri = triangles_[k];
+        const Vector3f p = dir.cross(tri.e2);
+        const float det = tri.e1.dot(p);
+        if (det == 0.0f) {
+          continue;
+        }
+        const float invDet = 1.0f / det;
+        const Vector3f s = origin - tri.v0;
+        const float u = s.dot(p) * invDet;
+        if (u < 0.0f || u > 1.0f) {
+          continue;
+        }
+        const Vector3f q = s.cross(tri.e1);
+        const float v = dir.dot(q) * invDet;
+        const float t = tri.e2.dot(q) * invDet;
+        if (v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < best) {
+          best = t;
+          bestSlot = k;
+          hit.u = u;
+          hit.v = v;
+        }
+      }
+    } else {
+      uint32_t a = node + 1;
+      uint32_t b = n.rightOrFirst;
+      float ta = ray_enter(origin, invDir, nodes[a].bounds, best);
+      float tb = ray_enter(origin, invDir, nodes[b].bounds, best);
+      if (tb < ta) {
+        std::swap(a, b);
+        std::swap(ta, tb);
+      }
+      if (ta != kInfinity) {
+        if (tb != kInfinity) {
+          stack[top++] = b;
+        }
+        node = a;
+        continue;
+      }
+    }
+    for (;;) {
+      if (top == 0) {
+        if (bestSlot != kNone) {
+          hit.triangle = bvh_.primitives()[bestSlot];
+          hit.distance = best;
+          hit.materialIndex = materials_[bestSlot];
+        }
+        return hit;
+      }
+      node = stack[--top];
+      if (ray_enter(origin, invDir, nodes[node].bounds, best) != kInfinity) {
+        break;
+      }
+    }
+  }
+}
+
+void MeshBvh::raycast_batch(ConstRaySoA rays, size_t count, float maxT, Hit* out) const {
+  const std::vector<BoxBvh::Node>& nodes = bvh_.nodes();
+  const float* origins[3] = {rays.ox, rays.oy, rays.oz};
+  const float* dirs[3] = {rays.dx, rays.dy, rays.dz};
+  const vfloat zero = simd::splat(0.0f);
+  const vfloat one = simd::splat(1.0f);
+
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = std::min(simd::kWidth, count - i);
+    Packet p;
+    float meanDir[3];
+    for (int axis = 0; axis < 3; axis++) {
+      p.o[axis] = simd::load_n(origins[axis] + i, n);
+      p.d[axis] = simd::load_n(dirs[axis] + i, n);
+      const vfloat tiny = simd::splat(FLT_MIN);
+      p.inv[axis] = one / simd::select(simd::abs(p.d[axis]) < tiny, simd::copysign(tiny, p.d[axis]), p.d[axis]);
+      meanDir[axis] = 0.0f;
+      for (size_t l = 0; l < n; l++) {
+        meanDir[axis] += dirs[axis][i + l];
+      }
+    }
+    // Lanes past the end get tMax = -1 so they never enter a node.
+    alignas(64) float bestInit[simd::kWidth];
+    for (size_t l = 0; l < simd::kWidth; l++) {
+      bestInit[l] = l < n ? maxT : -1.0f;
+    }
+    p.best = simd::load(bestInit);
+
+    vfloat bestU = zero, bestV = zero;
+    uint32_t slot[simd::kWidth];
+    std::fill(slot, slot + simd::kWidth, kNone);
+
+    uint32_t stack[BoxBvh::kMaxDepth];
+    size_t top = 0;
+    if (!nodes.empty() && packet_enters(p, nodes[0].bounds)) {
+      stack[top++] = 0;
+    }
+    while (top > 0) {
+      const uint32_t node = stack[--top];
+      const BoxBvh::Node& nd = nodes[node];
+      if (!packet_enters(p, nd.bounds)) {
+        continue;
+      }
+      if (nd.is_leaf()) {
+        for (uint32_t k = nd.rightOrFirst; k < nd.rightOrFirst + nd.count; k++) {
+          const Triangle& tri = triangles_[k];
+          using simd::fmadd;
+          const vfloat e1[3] = {simd::splat(tri.e1.x()), simd::splat(tri.e1.y()), simd::splat(tri.e1.z())};
+          const vfloat e2[3] = {simd::splat(tri.e2.x()), simd::splat(tri.e2.y()), simd::splat(tri.e2.z())};
+          // p = d x e2, s = o - v0, q = s x e1
+          const vfloat px = p.d[1] * e2[2] - p.d[2] * e2[1];
+          const vfloat py = p.d[2] * e2[0] - p.d[0] * e2[2];
+          const vfloat pz = p.d[0] * e2[1] - p.d[1] * e2[0];
+          const vfloat det = fmadd(e1[0], px, fmadd(e1[1], py, e1[2] * pz));
+          const vfloat invDet = one / det;
+          const vfloat sx = p.o[0] - simd::splat(tri.v0.x());
+          const vfloat sy = p.o[1] - simd::splat(tri.v0.y());
+          const vfloat sz = p.o[2] - simd::splat(tri.v0.z());
+          const vfloat u = fmadd(sx, px, fmadd(sy, py, sz * pz)) * invDet;
+          const vfloat qx = sy * e1[2] - sz * e1[1];
+          const vfloat qy = sz * e1[0] - sx * e1[2];
+          const vfloat qz = sx * e1[1] - sy * e1[0];
+          const vfloat v = fmadd(p.d[0], qx, fmadd(p.d[1], qy, p.d[2] * qz)) * invDet;
+          const vfloat t = fmadd(e2[0], qx, fmadd(e2[1], qy, e2[2] * qz)) * invDet;
+          // det == 0 makes u/v/t inf or NaN, which fail these ordered compares.
+          const vmask hit =
+              (u >= zero) & (v >= zero) & (u + v <= one) & (t >= zero) & (t < p.best);
+          const uint32_t bits = simd::bits(hit);
+          if (bits == 0) {
+            continue;
+          }
+          p.best = simd::select(hit, t, p.best);
+          bestU = simd::select(hit, u, bestU);
+          bestV = simd::select(hit, v, bestV);
+          for (size_t l = 0; l < simd::kWidth; l++) {
+            if (bits & (1u << l)) {
+              slot[l] = k;
+            }
+          }
+        }
+        continue;
+      }
+      // Near child first for the packet's mean direction: order by which
+      // child's center lies further along it.
+      const Vector3f delta = nodes[nd.rightOrFirst].bounds.center() - nodes[node + 1].bounds.center();
+      const bool rightFirst = delta.x() * meanDir[0] + delta.y() * meanDir[1] + delta.z() * meanDir[2] < 0.0f;
+      stack[top++] = rightFirst ? node + 1 : nd.rightOrFirst;
+      stack[top++] = rightFirst ? nd.rightOrFirst : node + 1;
+    }
+
+    alignas(64) float bestT[simd::kWidth], u[simd::kWidth], v[simd::kWidth];
+    simd::store(bestT, p.best);
+    simd::store(u, bestU);
+    simd::store(v, bestV);
+    for (size_t l = 0; l < n; l++) {
+      Hit& h = out[i + l];
+      h = Hit();
+      if (slot[l] != kNone) {
+        h.triangle = bvh_.primitives()[slot[l]];
+        h.distance = bestT[l];
+        h.u = u[l];
+        h.v = v[l];
+        h.materialIndex = materials_[slot[l]];
+      }
+    }
+  }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "bvh.h"
+#include "geometry_lib.h"
+
+// Rays in structure-of-arrays form for the packet kernel: origin and direction
+// components, `count` rays each. ray_soa_planar splits one planar block
+// [ox..., oy..., oz..., dx..., dy..., dz...] (the JS binding layout).
+struct ConstRaySoA {
+  const float* ox;
+  const float* oy;
+  const float* oz;
+  const float* dx;
+  const float* dy;
+  const float* dz;
+};
+
+inline ConstRaySoA ray_soa_planar(const float* block, size_t count) {
+  return ConstRaySoA{block, block + count, block + 2 * count, block + 3 * count, block + 4 * count, block + 5 * count};
+}
+
+// Triangle-level BVH over one mesh for exact ray picking.
+//
+// The tree is a BoxBvh built over the triangles' bounding boxes (same binned
+// SAH and flat depth-first nodes); triangles are then stored in leaf order as
+// Moller-Trumbore-ready (v0, v1 - v0, v2 - v0) records, so a leaf reads one
+// contiguous run. Triangles are double-sided. The mesh is copied: later edits
+// to it need a new MeshBvh.
+class MeshBvh {
+ public:
+  static constexpr uint32_t kNone = BoxBvh::kNone;
+
+  struct Hit {
+    uint32_t triangle = kNone;   // index / 3 of the triangle's first index (or vertex for soup)
+    float distance = 0.0f;       // ray parameter t
+    float u = 0.0f;              // barycentric weight of the triangle's 2nd vertex
+    float v = 0.0f;              // barycentric weight of the 3rd (the 1st is 1 - u - v)
+    uint32_t materialIndex = 0;  // group covering the triangle, 0 if none does
+
+    explicit operator bool() const { return triangle != kNone; }
+  };
+
+  MeshBvh() = default;
+  // `indices` may be null/empty (non-indexed soup). Groups use Three's ranges
+  // (in indices, or vertices for soup). Triangles with out-of-range indices
+  // are skipped.
+  MeshBvh(
+      const float* positions,
+      size_t vertexCount,
+      const uint32_t* indices,
+      size_t indexCount,
+      const MeshDataCpp::Group* groups,
+      size_t groupCount);
+  explicit MeshBvh(const MeshDataCpp& mesh);
+
+  // Closest hit with t in [0, maxT), in units of ray.direction().
+  Hit raycast(const Eigen::ParametrizedLine<float, 3>& ray, float maxT) const;
+
+  // Closest hit for each of `count` rays, written to out[i]. Rays are traced
+  // simd::kWidth at a time as one packet through the tree (a node is entered
+  // when any lane hits it), which pays off for coherent rays such as a pick
+  // region or a camera tile.
+  void raycast_batch(ConstRaySoA rays, size_t count, float maxT, Hit* out) const;
+
+  size_t triangle_count() const { return triangleCount_; }
+
+ private:
+  struct Triangle {
+    Eigen::Vector3f v0, e1, e2;
+  };
+
+  BoxBvh bvh_;
+  std::vector<Triangle> triangles_;  // leaf order (bvh_.primitives())
+  std::vector<uint32_t> materials_;  // leaf order
+  size_t triangleCount_ = 0;
+};
@@ -0,0 +1,101 @@
+#include "mesh_transform.h"
+
+#include "simd.h"
+
+namespace {
+
+using simd::vfloat;
+
+// Column-major 3x3 linear part plus translation, one splat per entry.
+struct AffineLanes {
+  vfloat m[9];
+  vfloat t[3];
+};
+
+AffineLanes make_lanes(const float* linear, size_t ld, const float* translation) {
+  AffineLanes out;
+  for (size_t col = 0; col < 3; col++) {
+    for (size_t row = 0; row < 3; row++) {
+      out.m[col * 3 + row] = simd::splat(linear[col * ld + row]);
+    }
+    out.t[col] = simd::splat(translation != nullptr ? translation[col] : 0.0f);
+  }
+  return out;
+}
+
+inline void apply(const AffineLanes& a, vfloat& x, vfloat& y, vfloat& z) {
+  using simd::fmadd;
+  const vfloat rx = fmadd(a.m[0], x, fmadd(a.m[3], y, fmadd(a.m[6], z, a.t[0])));
+  const vfloat ry = fmadd(a.m[1], x, fmadd(a.m[4], y, fmadd(a.m[7], z, a.t[1])));
+  const vfloat rz = fmadd(a.m[2], x, fmadd(a.m[5], y, fmadd(a.m[8], z, a.t[2])));
+  x = rx;
+  y = ry;
+  z = rz;
+}
+
+// Zero-length vectors stay zero (Three divides by `length() || 1`).
+inline void normalize(vfloat& x, vfloat& y, vfloat& z) {
+  using simd::fmadd;
+  const vfloat one = simd::splat(1.0f);
+  const vfloat len2 = fmadd(x, x, fmadd(y, y, z * z));
+  const vfloat inv = simd::select(len2 > simd::splat(0.0f), one / simd::sqrt(len2), one);
+  x *= inv;
+  y *= inv;
+  z *= inv;
+}
+
+// Deinterleaves kWidth points at a time (simd::load3), applies `fn` to the
+// component vectors and writes them back in place.
+template <typename Fn>
+void for_each_xyz(float* xyz, size_t count, Fn fn) {
+  size_t i = 0;
+  for (; i + simd::kWidth <= count; i += simd::kWidth) {
+    vfloat x, y, z;
+    simd::load3(xyz + i * 3, x, y, z);
+    fn(x, y, z);
+    simd::store3(xyz + i * 3, x, y, z);
+  }
+  if (i < count) {
+    vfloat x, y, z;
+    simd::load3_n(xyz + i * 3, count - i, x, y, z);
+    fn(x, y, z);
+    simd::store3_n(xyz + i * 3, count - i, x, y, z);
+  }
+}
+
+}  // namespace
+
+void transform_points(float* xyz, size_t count, const float* matrix4) {
+  const AffineLanes a = make_lanes(matrix4, 4, matrix4 + 12);
+  for_each_xyz(xyz, count, [&](vfloat& x, vfloat& y, vfloat& z) { apply(a, x, y, z); });
+}
+
+void transform_normals(float* xyz, size_t count, const float* matrix3) {
+  const AffineLanes a = make_lanes(matrix3, 3, nullptr);
+  for_each_xyz(xyz, count, [&](vfloat& x, vfloat& y, vfloat& z) {
+    apply(a, x, y, z);
+    normalize(x, y, z);
+  });
+}
+
+bool normal_matrix(const float* matrix4, float* out9) {
+  const Eigen::Map<const Eigen::Matrix4f> m(matrix4);
+  const Eigen::Matrix3f linear = m.topLeftCorner<3, 3>();
+  Eigen::Map<Eigen::Matrix3f> out(out9);
+  if (linear.determinant() == 0.0f) {
+    out.setZero();
+    return false;
+  }
+  out = linear.inverse().transpose();
+  return true;
+}
+
+void transform_mesh(MeshDataCpp& mesh, const Eigen::Affine3f& transform) {
+  // Affine3f stores the full 4x4 matrix column-major, which is the kernel layout.
+  const float* matrix4 = transform.matrix().data();
+  transform_points(mesh.vertices.data(), mesh.vertices.size() / 3, matrix4);
+
+  float normalMatrix[9];
+  normal_matrix(matrix4, normalMatrix);
+  transform_normals(mesh.normals.data(), mesh.normals.size() / 3, normalMatrix);
+}
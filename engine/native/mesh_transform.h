@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+
+#include <Eigen/Geometry>
+
+#include "geometry_lib.h"
+
+// In-place transforms of flat interleaved xyz buffers (MeshDataCpp::vertices /
+// normals, or the typed arrays handed in from JS). Matrices are column-major,
+// like Eigen's default storage and Three's Matrix4.elements; for 4x4 matrices the
+// bottom row is ignored (affine transforms only, no perspective divide).
+// The kernels deinterleave simd::kWidth points per step (simd::load3/store3),
+// so the matrix math runs on full x/y/z vectors.
+
+// p' = M * [p, 1] for `count` points.
+void transform_points(float* xyz, size_t count, const float* matrix4);
+
+// n' = normalize(N * n) for `count` normals, N a 3x3 normal matrix (see
+// normal_matrix). Zero-length results stay zero, like Three's Vector3.normalize.
+void transform_normals(float* xyz, size_t count, const float* matrix3);
+
+// Inverse-transpose of the upper 3x3 of `matrix4`, column-major into `out9`.
+// A singular linear part yields all zeros (Three's getNormalMatrix behaviour);
+// returns false in that case.
+bool normal_matrix(const float* matrix4, float* out9);
+
+// Positions by the full affine matrix, normals by the inverse-transpose of its
+// linear part (renormalized). Uvs and indices are untouched.
+void transform_mesh(MeshDataCpp& mesh, const Eigen::Affine3f& transform);
@@ -0,0 +1,214 @@
+#include "parallel.h"
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+
+namespace parallel {
+
+size_t thread_count() {
+  return 1;
+}
+
+void run(size_t jobs, const std::function<void(size_t)>& job) {
+  for (size_t i = 0; i < jobs; i++) {
+    job(i);
+  }
+}
+
+}  // namespace parallel
+
+#else
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+namespace {
+
+thread_local bool tInsideJob = false;
+
+// Job indices [begin, end) packed into one word so that taking a job and
+// stealing half of the rest are both a single compare-exchange.
+inline uint64_t pack(uint64_t begin, uint64_t end) {
+  return begin << 32 | end;
+}
+
+// Work-stealing pool. Each run() splits the job indices into one contiguous
+// slice per thread; a thread takes jobs from the front of its own slice and,
+// once that is empty, steals the back half of another thread's. Neighbouring
+// jobs (adjacent chunks of one array) thus mostly stay on one thread, and
+// threads only touch each other's state when the load is uneven.
+class Pool {
+ public:
+  Pool() {
+    const unsigned hw = std::thread::hardware_concurrency();
+    slices_ = std::vector<Slice>(hw > 1 ? hw : 1);
+    for (unsigned i = 1; i < hw; i++) {
+      threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+  }
+
+  ~Pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : threads_) {
+      t.join();
+    }
+  }
+
+  size_t size() const { return threads_.size() + 1; }
+
+  void run(size_t jobs, const std::function<void(size_t)>& job) {
+    std::unique_lock<std::mutex> busy(runMutex_, std::try_to_lock);
+    if (tInsideJob || !busy.owns_lock() || threads_.empty() || jobs <= 1 || (uint64_t)jobs > 0xffffffffu) {
+      for (size_t i = 0; i < jobs; i++) {
+        job(i);
+      }
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = &job;
+      for (size_t s = 0; s < slices_.size(); s++) {
+        slices_[s].range.store(
+            pack(chunk_begin(jobs, slices_.size(), s), chunk_begin(jobs, slices_.size(), s + 1)),
+            std::memory_order_relaxed);
+      }
+      remaining_ = jobs;
+      generation_++;
+    }
+    wake_.notify_all();
+    work(&job, 0);
+
+    // Wait for the jobs and for every worker to leave work(), so the next
+    // run() can reset the shared state.
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return remaining_ == 0 && active_ == 0; });
+    job_ = nullptr;
+  }
+
+ private:
+  struct alignas(64) Slice {
+    std::atomic<uint64_t> range{0};
+  };
+
+  // Takes the first job of slice `s`.
+  bool pop(size_t s, size_t* job) {
+    std::atomic<uint64_t>& range = slices_[s].range;
+    uint64_t r = range.load(std::memory_order_acquire);
+    for (;;) {
+      const uint64_t begin = r >> 32, end = r & 0xffffffffu;
+      if (begin >= end) {
+        return false;
+      }
+      if (range.compare_exchange_weak(r, pack(begin + 1, end), std::memory_order_acq_rel)) {
+        *job = (size_t)begin;
+        return true;
+      }
+    }
+  }
+
+  // Moves the back half (at least one job) of some other slice into the
+  // empty slice `s`. Indices never return to a slice they left, so a stale
+  // (begin, end) cannot compare equal again (no ABA).
+  bool steal(size_t s) {
+    for (size_t k = 1; k < slices_.size(); k++) {
+      std::atomic<uint64_t>& victim = slices_[(s + k) % slices_.size()].range;
+      uint64_t r = victim.load(std::memory_order_acquire);
+      for (;;) {
+        const uint64_t begin = r >> 32, end = r & 0xffffffffu;
+        if (begin >= end) {
+          break;
+        }
+        const uint64_t mid = begin + (end - begin) / 2;
+        if (victim.compare_exchange_weak(r, pack(begin, mid), std::memory_order_acq_rel)) {
+          slices_[s].range.store(pack(mid, end), std::memory_order_release);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void work(const std::function<void(size_t)>* job, size_t slice) {
+    tInsideJob = true;
+    size_t finished = 0;
+    size_t i = 0;
+    while (pop(slice, &i) || (steal(slice) && pop(slice, &i))) {
+      (*job)(i);
+      finished++;
+    }
+    tInsideJob = false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    remaining_ -= finished;
+    if (remaining_ == 0) {
+      done_.notify_one();
+    }
+  }
+
+  void worker_loop(size_t slice) {
+    uint64_t seen = 0;
+    for (;;) {
+      const std::function<void(size_t)>* job = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) {
+          return;
+        }
+        seen = generation_;
+        if (remaining_ == 0) {
+          continue;  // woke after the other threads finished this generation
+        }
+        job = job_;
+        active_++;
+      }
+      work(job, slice);
+      std::lock_guard<std::mutex> lock(mutex_);
+      active_--;
+      if (remaining_ == 0 && active_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::mutex runMutex_;  // one run() at a time; others fall back to serial
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(size_t)>* job_ = nullptr;
+  std::vector<Slice> slices_;  // one per thread; [0] belongs to the caller of run()
+  size_t remaining_ = 0;
+  size_t active_ = 0;
+  uint64_t generation_ = 0;
+  bool stop_ = false;
+};
+
+Pool& pool() {
+  static Pool instance;
+  return instance;
+}
+
+}  // namespace
+
+size_t thread_count() {
+  return pool().size();
+}
+
+void run(size_t jobs, const std::function<void(size_t)>& job) {
+  pool().run(jobs, job);
+}
+
+}  // namespace parallel
+
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+// Process-wide worker pool for the data-parallel kernels (LBVH build, ...).
+//
+// One pool of hardware_concurrency() - 1 workers is started on first use; the
+// calling thread joins in, so thread_count() threads run a job. Builds without
+// threads (wasm without -pthread) run everything serially on the caller.
+namespace parallel {
+
+size_t thread_count();
+
+// Calls job(i) for every i in [0, jobs) and returns once all have finished.
+// Each thread starts on its own contiguous slice of [0, jobs) and steals half
+// of another thread's remaining slice when it runs out, so jobs may differ in
+// cost and neighbouring jobs tend to run on the same thread. A call made
+// from inside a job, or while another thread is running one, executes
+// serially on the caller instead of waiting for the pool.
+void run(size_t jobs, const std::function<void(size_t)>& job);
+
+// Chunking for run(): `count` items in at most 4 chunks per thread (for load
+// balance) of at least `grain` items each. Chunk c is [chunk_begin(c), chunk_begin(c + 1)).
+inline size_t chunk_count(size_t count, size_t grain) {
+  const size_t byGrain = grain > 0 ? (count + grain - 1) / grain : count;
+  const size_t maxChunks = 4 * thread_count();
+  const size_t chunks = byGrain < maxChunks ? byGrain : maxChunks;
+  return chunks > 0 ? chunks : 1;
+}
+
+inline size_t chunk_begin(size_t count, size_t chunks, size_t c) {
+  return count / chunks * c + (c < count % chunks ? c : count % chunks);
+}
+
+// fn(chunk, begin, end) over `chunks` contiguous ranges of [0, count).
+template <typename Fn>
+void for_each_chunk(size_t count, size_t chunks, Fn&& fn) {
+  run(chunks, [&](size_t c) { fn(c, chunk_begin(count, chunks, c), chunk_begin(count, chunks, c + 1)); });
+}
+
+// fn(begin, end) over [0, count), split as chunk_count(count, grain).
+template <typename Fn>
+void parallel_for(size_t count, size_t grain, Fn&& fn) {
+  for_each_chunk(count, chunk_count(count, grain), [&](size_t, size_t begin, size_t end) { fn(begin, end); });
+}
+
+}  // namespace parallel
@@ -0,0 +1,213 @@
+#include "point_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Cell coordinates are clamped so far-away points cannot overflow the int
+// arithmetic in the hash or the shell loops.
+const float kMaxCell = 1073741824.0f;  // 2^30
+
+// Cells in [lo, hi] (0 if empty), as a double: a box spanning the clamped
+// coordinate range overflows 64-bit integers.
+double cell_volume(const Eigen::Vector3i& lo, const Eigen::Vector3i& hi) {
+  double volume = 1.0;
+  for (int a = 0; a < 3; a++) {
+    volume *= std::max((double)hi[a] - (double)lo[a] + 1.0, 0.0);
+  }
+  return volume;
+}
+
+bool less_neighbor(const PointGrid::Neighbor& a, const PointGrid::Neighbor& b) {
+  return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+}
+
+}  // namespace
+
+PointGrid::PointGrid(const float* points, size_t count, float cellSize)
+    : cellSize_(cellSize > 0.0f ? cellSize : 1.0f), invCellSize_(1.0f / cellSize_) {
+  std::vector<uint32_t> kept;
+  std::vector<Eigen::Vector3i> cells;
+  kept.reserve(count);
+  cells.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    const Eigen::Vector3f p = Eigen::Map<const Eigen::Vector3f>(points + i * 3);
+    if (!p.allFinite()) {
+      continue;
+    }
+    const Eigen::Vector3i cell = cell_of(p);
+    if (kept.empty()) {
+      minCell_ = maxCell_ = cell;
+    } else {
+      minCell_ = minCell_.cwiseMin(cell);
+      maxCell_ = maxCell_.cwiseMax(cell);
+    }
+    kept.push_back((uint32_t)i);
+    cells.push_back(cell);
+  }
+
+  dims_ = (maxCell_.cast<int64_t>() - minCell_.cast<int64_t>()).cast<uint64_t>() + Eigen::Matrix<uint64_t, 3, 1>::Ones();
+
+  size_t buckets = 16;
+  while (buckets < kept.size()) {
+    buckets <<= 1;
+  }
+  mask_ = buckets - 1;
+  cellStart_.assign(buckets, 0);
+  cellCount_.assign(buckets, 0);
+
+  // Counting sort by bucket.
+  std::vector<uint32_t> bucketOf(kept.size());
+  for (size_t k = 0; k < kept.size(); k++) {
+    bucketOf[k] = (uint32_t)bucket_of(cells[k]);
+    cellCount_[bucketOf[k]]++;
+  }
+  uint32_t sum = 0;
+  for (size_t b = 0; b < buckets; b++) {
+    cellStart_[b] = sum;
+    sum += cellCount_[b];
+  }
+  std::vector<uint32_t> cursor(cellStart_);
+  entries_.resize(kept.size());
+  for (size_t k = 0; k < kept.size(); k++) {
+    entries_[cursor[bucketOf[k]]++] =
+        Entry{Eigen::Map<const Eigen::Vector3f>(points + (size_t)kept[k] * 3), kept[k], cells[k]};
+  }
+}
+
+Eigen::Vector3i PointGrid::cell_of(const Eigen::Vector3f& p) const {
+  const Eigen::Vector3f c = (p * invCellSize_).array().floor().max(-kMaxCell).min(kMaxCell).matrix();
+  return c.cast<int>();
+}
+
+size_t PointGrid::bucket_of(const Eigen::Vector3i& cell) const {
+  // Row-major cell index within the bounds, wrapped to the table: cells that
+  // are neighbours along x land in neighbouring buckets, so a query's rows of
+  // cells read contiguous runs of the sorted arrays.
+  const Eigen::Matrix<uint64_t, 3, 1> local = (cell - minCell_).cast<uint64_t>();
+  return (size_t)((local.x() + dims_.x() * (local.y() + dims_.y() * local.z())) & mask_);
+}
+
+template <typename Fn>
+void PointGrid::visit_cell(const Eigen::Vector3i& cell, const Eigen::Vector3f& center, Fn&& fn) const {
+  const size_t bucket = bucket_of(cell);
+  const uint32_t end = cellStart_[bucket] + cellCount_[bucket];
+  for (uint32_t slot = cellStart_[bucket]; slot < end; slot++) {
+    const Entry& e = entries_[slot];
+    if (e.cell == cell) {
+      fn(e.index, (e.point - center).squaredNorm());
+    }
+  }
+}
+
+void PointGrid::radius(const Eigen::Vector3f& center, float radius, std::vector<uint32_t>& out) const {
+  if (entries_.empty() || !(radius >= 0.0f)) {
+    return;
+  }
+  const Eigen::Vector3i lo = cell_of(center - Eigen::Vector3f::Constant(radius)).cwiseMax(minCell_);
+  const Eigen::Vector3i hi = cell_of(center + Eigen::Vector3f::Constant(radius)).cwiseMin(maxCell_);
+  const float radius2 = radius * radius;
+  // A box of more cells than there are points costs more to walk than
+  // testing every point (sparse points far apart with a small cellSize).
+  if (cell_volume(lo, hi) > (double)entries_.size()) {
+    for (const Entry& e : entries_) {
+      if ((e.point - center).squaredNorm() <= radius2) {
+        out.push_back(e.index);
+      }
+    }
+    return;
+  }
+  Eigen::Vector3i cell;
+  for (cell.z() = lo.z(); cell.z() <= hi.z(); cell.z()++) {
+    for (cell.y() = lo.y(); cell.y() <= hi.y(); cell.y()++) {
+      for (cell.x() = lo.x(); cell.x() <= hi.x(); cell.x()++) {
+        visit_cell(cell, center, [&](uint32_t index, float distance2) {
+          if (distance2 <= radius2) {
+            out.push_back(index);
+          }
+        });
+      }
+    }
+  }
+}
+
+void PointGrid::nearest(const Eigen::Vector3f& center, size_t k, float maxDistance, std::vector<Neighbor>& out) const {
+  if (entries_.empty() || k == 0 || !(maxDistance >= 0.0f)) {
+    return;
+  }
+  // Max-heap on (distance, index) of the best k so far, squared distances.
+  std::vector<Neighbor> best;
+  best.reserve(k);
+  const float maxDistance2 = maxDistance * maxDistance;
+  const auto consider = [&](uint32_t index, float distance2) {
+    const Neighbor n{index, distance2};
+    if (distance2 > maxDistance2) {
+      return;
+    }
+    if (best.size() < k) {
+      best.push_back(n);
+      std::push_heap(best.begin(), best.end(), less_neighbor);
+    } else if (less_neighbor(n, best.front())) {
+      std::pop_heap(best.begin(), best.end(), less_neighbor);
+      best.back() = n;
+      std::push_heap(best.begin(), best.end(), less_neighbor);
+    }
+  };
+
+  // Shell arithmetic in 64 bits: home and the bounds are within +-2^30, so a
+  // ring reaching from one to the other does not fit an int.
+  typedef Eigen::Matrix<int64_t, 3, 1> Vector3l;
+  const Vector3l home = cell_of(center).cast<int64_t>();
+  const Vector3l boundsMin = minCell_.cast<int64_t>(), boundsMax = maxCell_.cast<int64_t>();
+  // Shells closer than the bounds are empty: start at the Chebyshev distance
+  // from home to the bounds, so far-away queries do not walk every ring in
+  // between.
+  const int64_t firstRing = (boundsMin - home).cwiseMax(home - boundsMax).cwiseMax(Vector3l::Zero()).maxCoeff();
+  for (int64_t ring = firstRing;; ring++) {
+    // Shell of cells at Chebyshev distance `ring` from home, clipped to the bounds.
+    const Vector3l shellMin = home - Vector3l::Constant(ring), shellMax = home + Vector3l::Constant(ring);
+    const Eigen::Vector3i lo = shellMin.cwiseMax(boundsMin).cast<int>();
+    const Eigen::Vector3i hi = shellMax.cwiseMin(boundsMax).cast<int>();
+    // Once the shells reach more cells than there are points (few points
+    // nearby, e.g. k above the local count on a sparse grid), a linear scan is
+    // cheaper than walking empty shells up to the bounds; it replaces the
+    // partial result.
+    if (cell_volume(lo, hi) > (double)entries_.size()) {
+      best.clear();
+      for (const Entry& e : entries_) {
+        consider(e.index, (e.point - center).squaredNorm());
+      }
+      break;
+    }
+    Eigen::Vector3i cell;
+    for (cell.z() = lo.z(); cell.z() <= hi.z(); cell.z()++) {
+      for (cell.y() = lo.y(); cell.y() <= hi.y(); cell.y()++) {
+        const bool faceYZ = std::abs(cell.z() - home.z()) == ring || std::abs(cell.y() - home.y()) == ring;
+        // Inside the shell only x = home.x +- ring lies on it.
+        const int64_t step = faceYZ ? 1 : std::max<int64_t>(2 * ring, 1);
+        for (int64_t x = faceYZ ? lo.x() : shellMin.x(); x <= hi.x(); x += step) {
+          if (x >= lo.x()) {
+            cell.x() = (int)x;
+            visit_cell(cell, center, consider);
+          }
+        }
+      }
+    }
+
+    // Every cell outside the shell is at least this far from center.
+    const Eigen::Vector3f boxMin = shellMin.cast<float>() * cellSize_;
+    const Eigen::Vector3f boxMax = (shellMax + Vector3l::Ones()).cast<float>() * cellSize_;
+    const float clearance = std::max(std::min((center - boxMin).minCoeff(), (boxMax - center).minCoeff()), 0.0f);
+    const bool covered = (shellMin.array() <= boundsMin.array()).all() && (shellMax.array() >= boundsMax.array()).all();
+    const float clearance2 = clearance * clearance;
+    if (covered || clearance2 > maxDistance2 || (best.size() == k && best.front().distance <= clearance2)) {
+      break;
+    }
+  }
+
+  std::sort_heap(best.begin(), best.end(), less_neighbor);
+  for (Neighbor& n : best) {
+    out.push_back(Neighbor{n.index, std::sqrt(n.distance)});
+  }
+}
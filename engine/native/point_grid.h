@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "geometry_lib.h"
+
+// Uniform spatial hash grid over a point set for radius and k-nearest
+// queries (vertex welding, proximity tests, particle neighbourhoods).
+//
+// Each point's integer cell is hashed into a power-of-two table (about one
+// bucket per point; the hash is the cell's row-major index within the point
+// bounds, wrapped, so x-neighbouring cells stay adjacent in memory) and the
+// points are counting-sorted by bucket. A bucket is then the range
+// [cellStart, cellStart + cellCount) of one flat sorted array, and nothing is
+// allocated per cell. Cells sharing a bucket are told apart by the cell
+// coordinates stored with each point.
+// Queries only visit cells inside the point set's cell bounds, and a query
+// that would visit more cells than there are points scans the points linearly
+// instead, so its cost is bounded by the point count however sparse the grid
+// is. Points with non-finite coordinates are left out. The points are copied.
+class PointGrid {
+ public:
+  struct Neighbor {
+    uint32_t index;  // point index passed to the constructor
+    float distance;
+  };
+
+  PointGrid() = default;
+  // `points` is xyz-interleaved; cellSize should be near the typical query
+  // radius (it must be > 0).
+  PointGrid(const float* points, size_t count, float cellSize);
+  PointGrid(const MeshDataCpp& mesh, float cellSize) : PointGrid(mesh.vertices.data(), mesh.vertices.size() / 3, cellSize) {}
+
+  // Appends the index of every point within `radius` of `center` (inclusive),
+  // in no particular order.
+  void radius(const Eigen::Vector3f& center, float radius, std::vector<uint32_t>& out) const;
+
+  // The (up to) k points closest to `center` within maxDistance, nearest first
+  // (equal distances by index). Searches shells of cells outwards, starting at
+  // the first shell that reaches the point bounds, and stops once the k-th best
+  // beats every unvisited cell or the shells cover the bounds.
+  void nearest(const Eigen::Vector3f& center, size_t k, float maxDistance, std::vector<Neighbor>& out) const;
+
+  size_t size() const { return entries_.size(); }
+  float cell_size() const { return cellSize_; }
+
+ private:
+  // One sorted point; everything a query reads from it shares a cache line.
+  struct Entry {
+    Eigen::Vector3f point;
+    uint32_t index;  // original point index
+    Eigen::Vector3i cell;
+  };
+
+  Eigen::Vector3i cell_of(const Eigen::Vector3f& p) const;
+  size_t bucket_of(const Eigen::Vector3i& cell) const;
+
+  // Calls fn(index, squaredDistance) for the points of `cell`.
+  template <typename Fn>
+  void visit_cell(const Eigen::Vector3i& cell, const Eigen::Vector3f& center, Fn&& fn) const;
+
+  float cellSize_ = 1.0f;
+  float invCellSize_ = 1.0f;
+  Eigen::Vector3i minCell_ = Eigen::Vector3i::Zero();
+  Eigen::Vector3i maxCell_ = Eigen::Vector3i::Constant(-1);
+  Eigen::Matrix<uint64_t, 3, 1> dims_ = Eigen::Matrix<uint64_t, 3, 1>::Zero();  // cells per axis in the bounds
+  size_t mask_ = 0;
+  std::vector<uint32_t> cellStart_;  // per bucket
+  std::vector<uint32_t> cellCount_;  // per bucket
+  std::vector<Entry> entries_;       // points sorted by bucket
+};
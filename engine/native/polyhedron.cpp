@@ -0,0 +1,299 @@
+#include "polyhedron.h"
+
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "simd.h"
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Barycentric weights of every emitted vertex of one subdivided face, in the
+// exact order Three's subdivideFace() pushes them. Stored SoA and padded to a
+// multiple of the SIMD width so the expansion loop needs no tail handling.
+struct SubdivisionTemplate {
+  size_t count = 0;   // 3 * (detail + 1)^2 vertices per face
+  std::vector<float> wa;
+  std::vector<float> wb;
+  std::vector<float> wc;
+};
+
+std::shared_ptr<const SubdivisionTemplate> build_template(uint32_t detail) {
+  const uint32_t cols = detail + 1;
+
+  // Lattice v[i][j] = (1-s)(1-t) a + s(1-t) b + t c with t = i/cols, s = j/rows,
+  // which is what the nested lerps in Three expand to.
+  std::vector<std::vector<float>> la(cols + 1), lb(cols + 1), lc(cols + 1);
+  for (uint32_t i = 0; i <= cols; i++) {
+    const uint32_t rows = cols - i;
+    const float t = (float)i / (float)cols;
+    la[i].resize(rows + 1);
+    lb[i].resize(rows + 1);
+    lc[i].resize(rows + 1);
+    for (uint32_t j = 0; j <= rows; j++) {
+      const float s = rows == 0 ? 0.0f : (float)j / (float)rows;
+      la[i][j] = (1.0f - s) * (1.0f - t);
+      lb[i][j] = s * (1.0f - t);
+      lc[i][j] = t;
+    }
+  }
+
+  auto tpl = std::make_shared<SubdivisionTemplate>();
+  tpl->count = 3 * (size_t)cols * cols;
+  const size_t padded = (tpl->count + simd::kWidth - 1) / simd::kWidth * simd::kWidth;
+  tpl->wa.reserve(padded);
+  tpl->wb.reserve(padded);
+  tpl->wc.reserve(padded);
+
+  auto push = [&](uint32_t i, uint32_t j) {
+    tpl->wa.push_back(la[i][j]);
+    tpl->wb.push_back(lb[i][j]);
+    tpl->wc.push_back(lc[i][j]);
+  };
+
+  for (uint32_t i = 0; i < cols; i++) {
+    for (uint32_t j = 0; j < 2 * (cols - i) - 1; j++) {
+      const uint32_t k = j / 2;
+      if (j % 2 == 0) {
+        push(i, k + 1);
+        push(i + 1, k);
+        push(i, k);
+      } else {
+        push(i, k + 1);
+        push(i + 1, k + 1);
+        push(i + 1, k);
+      }
+    }
+  }
+
+  tpl->wa.resize(padded, 0.0f);
+  tpl->wb.resize(padded, 0.0f);
+  tpl->wc.resize(padded, 0.0f);
+  return tpl;
+}
+
+std::shared_ptr<const SubdivisionTemplate> subdivision_template(uint32_t detail) {
+  // All cached levels together are a few MB; a single fine level can be tens,
+  // so those are not kept.
+  if (detail > kCachedPolyhedronDetail) {
+    return build_template(detail);
+  }
+  static std::mutex mutex;
+  static std::vector<std::shared_ptr<const SubdivisionTemplate>> cache(kCachedPolyhedronDetail + 1);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!cache[detail]) {
+    cache[detail] = build_template(detail);
+  }
+  return cache[detail];
+}
+
+// Angle around the Y axis, counter-clockwise when looking from above.
+double azimuth(double x, double z) {
+  return std::atan2(z, -x);
+}
+
+// Angle above the XZ plane.
+double inclination(double x, double y, double z) {
+  return std::atan2(-y, std::sqrt(x * x + z * z));
+}
+
+void generate_uvs(MeshDataCpp& out) {
+  const size_t vertexCount = out.vertices.size() / 3;
+  const float* p = out.vertices.data();
+  std::vector<float>& uv = out.uvs;
+  uv.resize(vertexCount * 2);
+
+  for (size_t i = 0; i < vertexCount; i++) {
+    const double x = p[i * 3 + 0];
+    const double y = p[i * 3 + 1];
+    const double z = p[i * 3 + 2];
+    uv[i * 2 + 0] = (float)(azimuth(x, z) / 2.0 / kPi + 0.5);
+    uv[i * 2 + 1] = (float)(1.0 - (inclination(x, y, z) / kPi + 0.5));
+  }
+
+  // correctUVs(): fix the seam column and the poles, per triangle.
+  for (size_t i = 0; i + 2 < vertexCount; i += 3) {
+    const float* a = p + i * 3;
+    const double cx = ((double)a[0] + a[3] + a[6]) / 3.0;
+    const double cz = ((double)a[2] + a[5] + a[8]) / 3.0;
+    const double azi = azimuth(cx, cz);
+
+    for (size_t k = 0; k < 3; k++) {
+      const float* v = a + k * 3;
+      float& u = uv[(i + k) * 2];
+      if (azi < 0 && u == 1.0f) {
+        u = u - 1.0f;
+      }
+      if (v[0] == 0.0f && v[2] == 0.0f) {
+        u = (float)(azi / 2.0 / kPi + 0.5);
+      }
+    }
+  }
+
+  // correctSeam(): faces straddling the seam get their low u's wrapped.
+  for (size_t i = 0; i + 5 < uv.size(); i += 6) {
+    float& x0 = uv[i + 0];
+    float& x1 = uv[i + 2];
+    float& x2 = uv[i + 4];
+    const float mx = std::fmax(x0, std::fmax(x1, x2));
+    const float mn = std::fmin(x0, std::fmin(x1, x2));
+    if (mx > 0.9f && mn < 0.1f) {
+      if (x0 < 0.2f) x0 += 1.0f;
+      if (x1 < 0.2f) x1 += 1.0f;
+      if (x2 < 0.2f) x2 += 1.0f;
+    }
+  }
+}
+
+}  // namespace
+
+MeshDataCpp make_polyhedron(
+    const float* vertices,
+    size_t vertexCount,
+    const uint32_t* indices,
+    size_t indexCount,
+    float radius,
+    uint32_t detail) {
+  MeshDataCpp out;
+
+  const size_t faceCount = indexCount / 3;
+  for (size_t i = 0; i < faceCount * 3; i++) {
+    if (indices[i] >= vertexCount) {
+      return out;
+    }
+  }
+  uint64_t total64 = 0;
+  if (faceCount == 0 || !polyhedron_vertex_count(faceCount, detail, &total64)) {
+    return out;
+  }
+
+  const std::shared_ptr<const SubdivisionTemplate> tpl = subdivision_template(detail);
+  const size_t perFace = tpl->count;
+  const size_t total = (size_t)total64;
+  const size_t padded = (total + simd::kWidth - 1) / simd::kWidth * simd::kWidth;
+
+  // Expand every base face through the cached template into SoA scratch.
+  std::vector<float> xs(padded + tpl->wa.size()), ys(xs.size()), zs(xs.size());
+  for (size_t f = 0; f < faceCount; f++) {
+    const float* a = vertices + (size_t)indices[f * 3 + 0] * 3;
+    const float* b = vertices + (size_t)indices[f * 3 + 1] * 3;
+    const float* c = vertices + (size_t)indices[f * 3 + 2] * 3;
+    const simd::vfloat ax = simd::splat(a[0]), ay = simd::splat(a[1]), az = simd::splat(a[2]);
+    const simd::vfloat bx = simd::splat(b[0]), by = simd::splat(b[1]), bz = simd::splat(b[2]);
+    const simd::vfloat cx = simd::splat(c[0]), cy = simd::splat(c[1]), cz = simd::splat(c[2]);
+
+    float* ox = xs.data() + f * perFace;
+    float* oy = ys.data() + f * perFace;
+    float* oz = zs.data() + f * perFace;
+    // Full vector stores may run past this face into the next one's slots;
+    // those get rewritten by the next face and the scratch has a padded tail.
+    for (size_t k = 0; k < perFace; k += simd::kWidth) {
+      const simd::vfloat wa = simd::load(tpl->wa.data() + k);
+      const simd::vfloat wb = simd::load(tpl->wb.data() + k);
+      const simd::vfloat wc = simd::load(tpl->wc.data() + k);
+      simd::store(ox + k, simd::fmadd(wa, ax, simd::fmadd(wb, bx, wc * cx)));
+      simd::store(oy + k, simd::fmadd(wa, ay, simd::fmadd(wb, by, wc * cy)));
+      simd::store(oz + k, simd::fmadd(wa, az, simd::fmadd(wb, bz, wc * cz)));
+    }
+  }
+
+  // Project onto the sphere: unit direction goes to normals, direction * radius
+  // to positions. Zero-length inputs stay at the origin like Vector3.normalize().
+  const simd::vfloat zero = simd::splat(0.0f);
+  const simd::vfloat one = simd::splat(1.0f);
+  for (size_t k = 0; k < padded; k += simd::kWidth) {
+    const simd::vfloat x = simd::load(xs.data() + k);
+    const simd::vfloat y = simd::load(ys.data() + k);
+    const simd::vfloat z = simd::load(zs.data() + k);
+    const simd::vfloat len2 = simd::fmadd(x, x, simd::fmadd(y, y, z * z));
+    const simd::vfloat inv = simd::select(len2 > zero, one / simd::sqrt(len2), zero);
+    simd::store(xs.data() + k, x * inv);
+    simd::store(ys.data() + k, y * inv);
+    simd::store(zs.data() + k, z * inv);
+  }
+
+  out.vertices.resize(total * 3);
+  out.normals.resize(total * 3);
+  for (size_t i = 0; i < total; i++) {
+    out.normals[i * 3 + 0] = xs[i];
+    out.normals[i * 3 + 1] = ys[i];
+    out.normals[i * 3 + 2] = zs[i];
+    out.vertices[i * 3 + 0] = xs[i] * radius;
+    out.vertices[i * 3 + 1] = ys[i] * radius;
+    out.vertices[i * 3 + 2] = zs[i] * radius;
+  }
+
+  generate_uvs(out);
+
+  if (detail == 0) {
+    compute_flat_normals(out);
+  }
+
+  return out;
+}
+
+bool polyhedron_vertex_count(size_t faceCount, uint32_t detail, uint64_t* count) {
+  // (detail + 1)^2 alone can overflow 64 bits; anything with detail + 1 above
+  // the budget is over it anyway.
+  const uint64_t side = (uint64_t)detail + 1;
+  if (side > kMaxPolyhedronVertices) {
+    return false;
+  }
+  const uint64_t perFace = 3 * side * side;
+  if (faceCount > kMaxPolyhedronVertices / perFace) {
+    return false;
+  }
+  *count = (uint64_t)faceCount * perFace;
+  return true;
+}
+
+MeshDataCpp make_tetrahedron(float radius, uint32_t detail) {
+  static const float vertices[] = {1, 1, 1, -1, -1, 1, -1, 1, -1, 1, -1, -1};
+  static const uint32_t indices[] = {2, 1, 0, 0, 3, 2, 1, 3, 0, 2, 3, 1};
+  return make_polyhedron(vertices, 4, indices, kTetrahedronFaces * 3, radius, detail);
+}
+
+MeshDataCpp make_octahedron(float radius, uint32_t detail) {
+  static const float vertices[] = {1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1};
+  static const uint32_t indices[] = {0, 2, 4, 0, 4, 3, 0, 3, 5, 0, 5, 2,
+                                     1, 2, 5, 1, 5, 3, 1, 3, 4, 1, 4, 2};
+  return make_polyhedron(vertices, 6, indices, kOctahedronFaces * 3, radius, detail);
+}
+
+MeshDataCpp make_icosahedron(float radius, uint32_t detail) {
+  const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+  const float vertices[] = {-1, t,  0, 1, t,  0, -1, -t, 0,  1, -t, 0,
+                            0,  -1, t, 0, 1,  t, 0,  -1, -t, 0, 1,  -t,
+                            t,  0,  -1, t, 0, 1, -t, 0,  -1, -t, 0, 1};
+  static const uint32_t indices[] = {0, 11, 5,  0, 5,  1, 0, 1, 7, 0, 7,  10, 0, 10, 11,
+                                     1, 5,  9,  5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1,  8,
+                                     3, 9,  4,  3, 4,  2, 3, 2,  6, 3, 6,  8, 3, 8,  9,
+                                     4, 9,  5,  2, 4,  11, 6, 2, 10, 8, 6, 7, 9, 8,  1};
+  return make_polyhedron(vertices, 12, indices, kIcosahedronFaces * 3, radius, detail);
+}
+
+MeshDataCpp make_dodecahedron(float radius, uint32_t detail) {
+  const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+  const float r = 1.0f / t;
+  const float vertices[] = {
+      // (±1, ±1, ±1)
+      -1, -1, -1, -1, -1, 1, -1, 1, -1, -1, 1, 1, 1, -1, -1, 1, -1, 1, 1, 1, -1, 1, 1, 1,
+      // (0, ±1/φ, ±φ)
+      0, -r, -t, 0, -r, t, 0, r, -t, 0, r, t,
+      // (±1/φ, ±φ, 0)
+      -r, -t, 0, -r, t, 0, r, -t, 0, r, t, 0,
+      // (±φ, 0, ±1/φ)
+      -t, 0, -r, t, 0, -r, -t, 0, r, t, 0, r};
+  static const uint32_t indices[] = {
+      3,  11, 7,  3,  7,  15, 3,  15, 13, 7,  19, 17, 7,  17, 6,  7,  6,  15, 17, 4,
+      8,  17, 8,  10, 17, 10, 6,  8,  0,  16, 8,  16, 2,  8,  2,  10, 0,  12, 1,  0,
+      1,  18, 0,  18, 16, 6,  10, 2,  6,  2,  13, 6,  13, 15, 2,  16, 18, 2,  18, 3,
+      2,  3,  13, 18, 1,  9,  18, 9,  11, 18, 11, 3,  4,  14, 12, 4,  12, 0,  4,  0,
+      8,  11, 9,  5,  11, 5,  19, 11, 19, 7,  19, 5,  14, 19, 14, 4,  19, 4,  17, 1,
+      12, 14, 1,  14, 5,  1,  5,  9};
+  return make_polyhedron(vertices, 20, indices, kDodecahedronFaces * 3, radius, detail);
+}
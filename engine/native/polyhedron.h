@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "geometry_lib.h"
+
+constexpr uint32_t kCachedPolyhedronDetail = 64;
+// Output vertex budget (positions, normals and uvs take 32 bytes per vertex, so
+// 128 MB); make_polyhedron returns an empty mesh above it.
+constexpr uint64_t kMaxPolyhedronVertices = uint64_t(1) << 22;
+
+// Base triangles of the named solids.
+constexpr size_t kTetrahedronFaces = 4;
+constexpr size_t kOctahedronFaces = 8;
+constexpr size_t kIcosahedronFaces = 20;
+constexpr size_t kDodecahedronFaces = 36;
+
+// Three-style PolyhedronGeometry: every base face is subdivided `detail` times,
+// projected onto a sphere of `radius` and emitted as a non-indexed triangle soup
+// (positions, normals, uvs; `indices` and `groups` stay empty).
+//
+// The per-face barycentric subdivision pattern only depends on `detail`, so it is
+// built once per detail level and cached for the lifetime of the process, up to
+// kCachedPolyhedronDetail; finer patterns are built per call.
+// Returns an empty mesh if any index is out of range or the output would exceed
+// kMaxPolyhedronVertices (see polyhedron_vertex_count).
+MeshDataCpp make_polyhedron(
+    const float* vertices,
+    size_t vertexCount,
+    const uint32_t* indices,
+    size_t indexCount,
+    float radius,
+    uint32_t detail);
+
+// The output vertex count, 3 * (detail + 1)^2 per base face, computed in 64 bits
+// without overflow; false if it exceeds kMaxPolyhedronVertices.
+bool polyhedron_vertex_count(size_t faceCount, uint32_t detail, uint64_t* count);
+
+MeshDataCpp make_tetrahedron(float radius, uint32_t detail);
+MeshDataCpp make_octahedron(float radius, uint32_t detail);
+MeshDataCpp make_icosahedron(float radius, uint32_t detail);
+MeshDataCpp make_dodecahedron(float radius, uint32_t detail);
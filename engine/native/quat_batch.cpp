@@ -0,0 +1,123 @@
+#include "quat_batch.h"
+
+#include "simd.h"
+#include "simd_math.h"
+
+namespace {
+
+struct QuatLanes {
+  simd::vfloat x, y, z, w;
+};
+
+inline QuatLanes load_quat(const ConstQuatSoA& q, size_t i, size_t n) {
+  if (n == simd::kWidth) {
+    return {simd::load(q.x + i), simd::load(q.y + i), simd::load(q.z + i), simd::load(q.w + i)};
+  }
+  return {simd::load_n(q.x + i, n), simd::load_n(q.y + i, n), simd::load_n(q.z + i, n), simd::load_n(q.w + i, n)};
+}
+
+inline void store_quat(const QuatSoA& q, size_t i, size_t n, const QuatLanes& v) {
+  if (n == simd::kWidth) {
+    simd::store(q.x + i, v.x);
+    simd::store(q.y + i, v.y);
+    simd::store(q.z + i, v.z);
+    simd::store(q.w + i, v.w);
+    return;
+  }
+  simd::store_n(q.x + i, v.x, n);
+  simd::store_n(q.y + i, v.y, n);
+  simd::store_n(q.z + i, v.z, n);
+  simd::store_n(q.w + i, v.w, n);
+}
+
+inline QuatLanes multiply(const QuatLanes& a, const QuatLanes& b) {
+  using simd::fmadd;
+  QuatLanes r;
+  r.w = a.w * b.w - fmadd(a.x, b.x, fmadd(a.y, b.y, a.z * b.z));
+  r.x = fmadd(a.w, b.x, fmadd(a.x, b.w, a.y * b.z)) - a.z * b.y;
+  r.y = fmadd(a.w, b.y, fmadd(a.y, b.w, a.z * b.x)) - a.x * b.z;
+  r.z = fmadd(a.w, b.z, fmadd(a.z, b.w, a.x * b.y)) - a.y * b.x;
+  return r;
+}
+
+inline simd::vfloat dot(const QuatLanes& a, const QuatLanes& b) {
+  using simd::fmadd;
+  return fmadd(a.x, b.x, fmadd(a.y, b.y, fmadd(a.z, b.z, a.w * b.w)));
+}
+
+inline QuatLanes blend(const QuatLanes& a, simd::vfloat sa, const QuatLanes& b, simd::vfloat sb) {
+  using simd::fmadd;
+  return {fmadd(a.x, sa, b.x * sb), fmadd(a.y, sa, b.y * sb), fmadd(a.z, sa, b.z * sb), fmadd(a.w, sa, b.w * sb)};
+}
+
+// Weight sources for the interpolation kernels: one t per quaternion or one for all.
+struct PerElementT {
+  const float* t;
+  simd::vfloat load(size_t i, size_t n) const { return n == simd::kWidth ? simd::load(t + i) : simd::load_n(t + i, n); }
+};
+
+struct UniformT {
+  simd::vfloat t;
+  simd::vfloat load(size_t, size_t) const { return t; }
+};
+
+inline QuatLanes slerp(const QuatLanes& a, const QuatLanes& b, simd::vfloat t) {
+  using namespace simd;
+  const vfloat one = splat(1.0f);
+  const vfloat d = dot(a, b);
+  const vfloat absD = abs(d);
+
+  // theta = acos(|d|) in [0, pi/2]; sin(theta) straight from |d| is cheaper and
+  // more accurate than sin(acos(|d|)).
+  const vfloat theta = simd::acos(absD);
+  const vfloat sinTheta = sqrt((one - absD) * (one + absD));
+  const vfloat s0 = simd::sin((one - t) * theta);
+  const vfloat s1 = simd::sin(t * theta);
+
+  // Nearly identical rotations: lerp (Eigen's `absD >= 1 - epsilon` branch).
+  const vmask nearlyEqual = absD >= splat(1.0f - 1.1920929e-7f);
+  const vfloat invSin = one / select(nearlyEqual, one, sinTheta);
+  const vfloat scale0 = select(nearlyEqual, one - t, s0 * invSin);
+  const vfloat scale1 = mulsign(select(nearlyEqual, t, s1 * invSin), d);
+  return blend(a, scale0, b, scale1);
+}
+
+inline QuatLanes nlerp(const QuatLanes& a, const QuatLanes& b, simd::vfloat t) {
+  using namespace simd;
+  const QuatLanes r = blend(a, splat(1.0f) - t, b, mulsign(t, dot(a, b)));
+  const vfloat invLen = splat(1.0f) / sqrt(dot(r, r));
+  return {r.x * invLen, r.y * invLen, r.z * invLen, r.w * invLen};
+}
+
+template <typename Weights, typename Kernel>
+void interpolate_batch(ConstQuatSoA a, ConstQuatSoA b, const Weights& t, QuatSoA out, size_t count, Kernel kernel) {
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = count - i < simd::kWidth ? count - i : simd::kWidth;
+    store_quat(out, i, n, kernel(load_quat(a, i, n), load_quat(b, i, n), t.load(i, n)));
+  }
+}
+
+}  // namespace
+
+void quat_multiply_batch(ConstQuatSoA a, ConstQuatSoA b, QuatSoA out, size_t count) {
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = count - i < simd::kWidth ? count - i : simd::kWidth;
+    store_quat(out, i, n, multiply(load_quat(a, i, n), load_quat(b, i, n)));
+  }
+}
+
+void quat_slerp_batch(ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t count) {
+  interpolate_batch(a, b, PerElementT{t}, out, count, slerp);
+}
+
+void quat_slerp_batch(ConstQuatSoA a, ConstQuatSoA b, float t, QuatSoA out, size_t count) {
+  interpolate_batch(a, b, UniformT{simd::splat(t)}, out, count, slerp);
+}
+
+void quat_nlerp_batch(ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t count) {
+  interpolate_batch(a, b, PerElementT{t}, out, count, nlerp);
+}
+
+void quat_nlerp_batch(ConstQuatSoA a, ConstQuatSoA b, float t, QuatSoA out, size_t count) {
+  interpolate_batch(a, b, UniformT{simd::splat(t)}, out, count, nlerp);
+}
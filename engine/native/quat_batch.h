@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+
+// Batched quaternion kernels over structure-of-arrays storage: component arrays
+// x[], y[], z[], w[] of `count` quaternions each. Every kernel runs simd::kWidth
+// quaternions per step (16 on AVX-512, 8 on AVX2, 4 on SSE2/WASM SIMD128) and
+// handles the tail with partial loads, so `count` need not be a multiple of it.
+// Outputs may alias inputs element-for-element (in-place update).
+
+struct QuatSoA {
+  float* x;
+  float* y;
+  float* z;
+  float* w;
+};
+
+struct ConstQuatSoA {
+  const float* x;
+  const float* y;
+  const float* z;
+  const float* w;
+
+  ConstQuatSoA(const float* x_, const float* y_, const float* z_, const float* w_) : x(x_), y(y_), z(z_), w(w_) {}
+  ConstQuatSoA(const QuatSoA& q) : x(q.x), y(q.y), z(q.z), w(q.w) {}
+};
+
+// Splits one planar block [x0..xn-1, y0..yn-1, z0..zn-1, w0..wn-1] (the layout
+// the JS bindings use) into component pointers.
+inline QuatSoA quat_soa_planar(float* block, size_t count) {
+  return QuatSoA{block, block + count, block + 2 * count, block + 3 * count};
+}
+
+inline ConstQuatSoA quat_soa_planar(const float* block, size_t count) {
+  return ConstQuatSoA(block, block + count, block + 2 * count, block + 3 * count);
+}
+
+// out[i] = a[i] * b[i] (Hamilton product, same convention as Eigen's
+// Quaternion::operator*: applies b first, then a).
+void quat_multiply_batch(ConstQuatSoA a, ConstQuatSoA b, QuatSoA out, size_t count);
+
+// out[i] = a[i].slerp(t, b[i]) with Eigen's conventions: takes the shorter arc
+// (b is negated when dot(a, b) < 0) and falls back to a plain lerp when the
+// quaternions are within float epsilon of each other. acos/sin are the
+// polynomial approximations from simd_math.h; for unit inputs and t in [0, 1]
+// every component is within 1e-6 of a double-precision slerp. `t` is either one
+// weight per quaternion or a single weight for the whole batch.
+void quat_slerp_batch(ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t count);
+void quat_slerp_batch(ConstQuatSoA a, ConstQuatSoA b, float t, QuatSoA out, size_t count);
+
+// Normalized lerp along the shorter arc: normalize((1 - t) * a + t * +-b).
+// Not constant-velocity like slerp, but much cheaper and close to it for the
+// small inter-key angles of sampled animation.
+void quat_nlerp_batch(ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t count);
+void quat_nlerp_batch(ConstQuatSoA a, ConstQuatSoA b, float t, QuatSoA out, size_t count);
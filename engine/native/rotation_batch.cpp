@@ -0,0 +1,223 @@
+#include "rotation_batch.h"
+
+#include <cstring>
+
+#include "simd.h"
+#include "simd_math.h"
+
+namespace {
+
+using simd::vfloat;
+
+inline vfloat load_lanes(const float* p, size_t i, size_t n) {
+  return n == simd::kWidth ? simd::load(p + i) : simd::load_n(p + i, n);
+}
+
+inline void store_lanes(float* p, size_t i, size_t n, vfloat v) {
+  if (n == simd::kWidth) {
+    simd::store(p + i, v);
+  } else {
+    simd::store_n(p + i, v, n);
+  }
+}
+
+struct QuatLanes {
+  vfloat x, y, z, w;
+};
+
+struct AngleAxisLanes {
+  vfloat x, y, z, angle;
+};
+
+// Column-major like Matrix3SoA: m[c * 3 + r].
+struct Matrix3Lanes {
+  vfloat m[9];
+};
+
+inline QuatLanes load_quat(ConstQuatSoA q, size_t i, size_t n) {
+  return QuatLanes{load_lanes(q.x, i, n), load_lanes(q.y, i, n), load_lanes(q.z, i, n), load_lanes(q.w, i, n)};
+}
+
+inline void store_quat(QuatSoA q, size_t i, size_t n, const QuatLanes& v) {
+  store_lanes(q.x, i, n, v.x);
+  store_lanes(q.y, i, n, v.y);
+  store_lanes(q.z, i, n, v.z);
+  store_lanes(q.w, i, n, v.w);
+}
+
+inline AngleAxisLanes load_angle_axis(ConstAngleAxisSoA a, size_t i, size_t n) {
+  return AngleAxisLanes{load_lanes(a.x, i, n), load_lanes(a.y, i, n), load_lanes(a.z, i, n), load_lanes(a.angle, i, n)};
+}
+
+inline void store_angle_axis(AngleAxisSoA a, size_t i, size_t n, const AngleAxisLanes& v) {
+  store_lanes(a.x, i, n, v.x);
+  store_lanes(a.y, i, n, v.y);
+  store_lanes(a.z, i, n, v.z);
+  store_lanes(a.angle, i, n, v.angle);
+}
+
+inline Matrix3Lanes load_matrix3(ConstMatrix3SoA m, size_t i, size_t n) {
+  Matrix3Lanes v;
+  for (int k = 0; k < 9; k++) {
+    v.m[k] = load_lanes(m.m[k], i, n);
+  }
+  return v;
+}
+
+inline void store_matrix3(Matrix3SoA m, size_t i, size_t n, const Matrix3Lanes& v) {
+  for (int k = 0; k < 9; k++) {
+    store_lanes(m.m[k], i, n, v.m[k]);
+  }
+}
+
+inline QuatLanes angle_axis_to_quat(const AngleAxisLanes& a) {
+  vfloat s, c;
+  simd::sincos(a.angle * simd::splat(0.5f), s, c);
+  return QuatLanes{a.x * s, a.y * s, a.z * s, c};
+}
+
+inline AngleAxisLanes quat_to_angle_axis(const QuatLanes& q) {
+  using namespace simd;
+  const vfloat n = sqrt(fmadd(q.x, q.x, fmadd(q.y, q.y, q.z * q.z)));
+  const vmask identity = n <= splat(0.0f);
+  // Dividing by -n for w < 0 keeps the angle in [0, pi].
+  const vfloat safeN = select(identity, splat(1.0f), n);
+  const vfloat inv = splat(1.0f) / select(q.w < splat(0.0f), -safeN, safeN);
+  AngleAxisLanes a;
+  a.angle = splat(2.0f) * simd::atan2(n, abs(q.w));
+  a.x = select(identity, splat(1.0f), q.x * inv);
+  a.y = select(identity, splat(0.0f), q.y * inv);
+  a.z = select(identity, splat(0.0f), q.z * inv);
+  return a;
+}
+
+inline Matrix3Lanes quat_to_matrix3(const QuatLanes& q) {
+  const vfloat one = simd::splat(1.0f);
+  const vfloat two = simd::splat(2.0f);
+  const vfloat tx = two * q.x, ty = two * q.y, tz = two * q.z;
+  const vfloat twx = tx * q.w, twy = ty * q.w, twz = tz * q.w;
+  const vfloat txx = tx * q.x, txy = ty * q.x, txz = tz * q.x;
+  const vfloat tyy = ty * q.y, tyz = tz * q.y, tzz = tz * q.z;
+  Matrix3Lanes m;
+  m.m[0] = one - (tyy + tzz);
+  m.m[1] = txy + twz;
+  m.m[2] = txz - twy;
+  m.m[3] = txy - twz;
+  m.m[4] = one - (txx + tzz);
+  m.m[5] = tyz + twx;
+  m.m[6] = txz + twy;
+  m.m[7] = tyz - twx;
+  m.m[8] = one - (txx + tyy);
+  return m;
+}
+
+// quaternionbase_assign_impl<Matrix3>: positive trace -> w is the largest
+// component; otherwise the largest diagonal entry i picks q_i. Every case has
+// the form big = sqrt(s) / 2 and the three others = (sum or difference of an
+// off-diagonal pair) * 0.5 / sqrt(s), so the cases only differ in which s
+// and which pair feeds which component.
+inline QuatLanes matrix3_to_quat(const Matrix3Lanes& v) {
+  using namespace simd;
+  const vfloat m00 = v.m[0], m10 = v.m[1], m20 = v.m[2];
+  const vfloat m01 = v.m[3], m11 = v.m[4], m21 = v.m[5];
+  const vfloat m02 = v.m[6], m12 = v.m[7], m22 = v.m[8];
+  const vfloat one = splat(1.0f);
+
+  const vmask caseW = (m00 + m11 + m22) > splat(0.0f);
+  const vmask case1 = m11 > m00;
+  const vmask case2 = m22 > select(case1, m11, m00);
+
+  const vfloat sW = one + m00 + m11 + m22;
+  const vfloat sX = one + m00 - m11 - m22;
+  const vfloat sY = one - m00 + m11 - m22;
+  const vfloat sZ = one - m00 - m11 + m22;
+  const vfloat s = select(caseW, sW, select(case2, sZ, select(case1, sY, sX)));
+  const vfloat root = sqrt(s);
+  const vfloat big = splat(0.5f) * root;
+  const vfloat inv = splat(0.5f) / root;
+
+  const vfloat dx = (m21 - m12) * inv, dy = (m02 - m20) * inv, dz = (m10 - m01) * inv;
+  const vfloat sxy = (m10 + m01) * inv, sxz = (m20 + m02) * inv, syz = (m21 + m12) * inv;
+
+  QuatLanes q;
+  q.w = select(caseW, big, select(case2, dz, select(case1, dy, dx)));
+  q.x = select(caseW, dx, select(case2, sxz, select(case1, sxy, big)));
+  q.y = select(caseW, dy, select(case2, syz, select(case1, big, sxy)));
+  q.z = select(caseW, dz, select(case2, big, select(case1, syz, sxz)));
+  return q;
+}
+
+inline Matrix3Lanes angle_axis_to_matrix3(const AngleAxisLanes& a) {
+  using simd::fmadd;
+  vfloat s, c;
+  simd::sincos(a.angle, s, c);
+  const vfloat sx = s * a.x, sy = s * a.y, sz = s * a.z;
+  const vfloat oneMinusC = simd::splat(1.0f) - c;
+  const vfloat cx = oneMinusC * a.x, cy = oneMinusC * a.y, cz = oneMinusC * a.z;
+  const vfloat xy = cx * a.y, xz = cx * a.z, yz = cy * a.z;
+  Matrix3Lanes m;
+  m.m[0] = fmadd(cx, a.x, c);
+  m.m[1] = xy + sz;
+  m.m[2] = xz - sy;
+  m.m[3] = xy - sz;
+  m.m[4] = fmadd(cy, a.y, c);
+  m.m[5] = yz + sx;
+  m.m[6] = xz + sy;
+  m.m[7] = yz - sx;
+  m.m[8] = fmadd(cz, a.z, c);
+  return m;
+}
+
+template <typename In, typename Out, typename Load, typename Convert, typename Store>
+inline void convert_lanes(In in, Out out, size_t count, Load load, Convert convert, Store store) {
+  for (size_t i = 0; i < count; i += simd::kWidth) {
+    const size_t n = count - i < simd::kWidth ? count - i : simd::kWidth;
+    store(out, i, n, convert(load(in, i, n)));
+  }
+}
+
+}  // namespace
+
+void angle_axis_to_quat_batch(ConstAngleAxisSoA a, QuatSoA out, size_t count) {
+  convert_lanes(a, out, count, load_angle_axis, angle_axis_to_quat, store_quat);
+}
+
+void quat_to_angle_axis_batch(ConstQuatSoA q, AngleAxisSoA out, size_t count) {
+  convert_lanes(q, out, count, load_quat, quat_to_angle_axis, store_angle_axis);
+}
+
+void quat_to_matrix3_batch(ConstQuatSoA q, Matrix3SoA out, size_t count) {
+  convert_lanes(q, out, count, load_quat, quat_to_matrix3, store_matrix3);
+}
+
+void matrix3_to_quat_batch(ConstMatrix3SoA m, QuatSoA out, size_t count) {
+  convert_lanes(m, out, count, load_matrix3, matrix3_to_quat, store_quat);
+}
+
+void angle_axis_to_matrix3_batch(ConstAngleAxisSoA a, Matrix3SoA out, size_t count) {
+  convert_lanes(a, out, count, load_angle_axis, angle_axis_to_matrix3, store_matrix3);
+}
+
+void matrix3_to_angle_axis_batch(ConstMatrix3SoA m, AngleAxisSoA out, size_t count) {
+  const auto convert = [](const Matrix3Lanes& v) { return quat_to_angle_axis(matrix3_to_quat(v)); };
+  convert_lanes(m, out, count, load_matrix3, convert, store_angle_axis);
+}
+
+void convert_rotation_batch(RotationFormat from, RotationFormat to, const float* in, float* out, size_t count) {
+  typedef RotationFormat F;
+  if (from == to) {
+    std::memmove(out, in, rotation_format_floats(from) * count * sizeof(float));
+  } else if (from == F::Quaternion && to == F::AngleAxis) {
+    quat_to_angle_axis_batch(quat_soa_planar(in, count), angle_axis_soa_planar(out, count), count);
+  } else if (from == F::Quaternion && to == F::Matrix3) {
+    quat_to_matrix3_batch(quat_soa_planar(in, count), matrix3_soa_planar(out, count), count);
+  } else if (from == F::AngleAxis && to == F::Quaternion) {
+    angle_axis_to_quat_batch(angle_axis_soa_planar(in, count), quat_soa_planar(out, count), count);
+  } else if (from == F::AngleAxis && to == F::Matrix3) {
+    angle_axis_to_matrix3_batch(angle_axis_soa_planar(in, count), matrix3_soa_planar(out, count), count);
+  } else if (from == F::Matrix3 && to == F::Quaternion) {
+    matrix3_to_quat_batch(matrix3_soa_planar(in, count), quat_soa_planar(out, count), count);
+  } else {
+    matrix3_to_angle_axis_batch(matrix3_soa_planar(in, count), angle_axis_soa_planar(out, count), count);
+  }
+}
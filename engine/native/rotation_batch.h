@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+
+#include "quat_batch.h"
+
+// Batched conversions between the three rotation representations of Eigen's
+// Geometry module -- Quaternion, AngleAxis and the 3x3 rotation matrix --
+// over SoA storage (quaternions as in quat_batch.h). Each kernel reproduces the
+// corresponding Eigen conversion formula lane-wise, simd::kWidth rotations per
+// step with a partial-load tail. Outputs may alias inputs element-for-element
+// (quaternion <-> angle-axis converts in place).
+
+// AngleAxis as four component arrays: the unit axis x[], y[], z[] and angle[].
+struct AngleAxisSoA {
+  float* x;
+  float* y;
+  float* z;
+  float* angle;
+};
+
+struct ConstAngleAxisSoA {
+  const float* x;
+  const float* y;
+  const float* z;
+  const float* angle;
+
+  ConstAngleAxisSoA(const float* x_, const float* y_, const float* z_, const float* angle_)
+      : x(x_), y(y_), z(z_), angle(angle_) {}
+  ConstAngleAxisSoA(const AngleAxisSoA& a) : x(a.x), y(a.y), z(a.z), angle(a.angle) {}
+};
+
+// 3x3 matrices as nine coefficient arrays in Eigen's (column-major) storage
+// order: m[c * 3 + r] holds coefficient (r, c) of every matrix.
+struct Matrix3SoA {
+  float* m[9];
+};
+
+struct ConstMatrix3SoA {
+  const float* m[9];
+
+  ConstMatrix3SoA(const Matrix3SoA& a) {
+    for (int k = 0; k < 9; k++) {
+      m[k] = a.m[k];
+    }
+  }
+  explicit ConstMatrix3SoA(const float* const* m_) {
+    for (int k = 0; k < 9; k++) {
+      m[k] = m_[k];
+    }
+  }
+};
+
+// Planar blocks as used by the JS bindings: [x..., y..., z..., angle...] and
+// [m00..., m10..., m20..., m01..., ..., m22...] (Three's Matrix3.elements order).
+inline AngleAxisSoA angle_axis_soa_planar(float* block, size_t count) {
+  return AngleAxisSoA{block, block + count, block + 2 * count, block + 3 * count};
+}
+
+inline ConstAngleAxisSoA angle_axis_soa_planar(const float* block, size_t count) {
+  return ConstAngleAxisSoA(block, block + count, block + 2 * count, block + 3 * count);
+}
+
+inline Matrix3SoA matrix3_soa_planar(float* block, size_t count) {
+  Matrix3SoA s;
+  for (int k = 0; k < 9; k++) {
+    s.m[k] = block + k * count;
+  }
+  return s;
+}
+
+inline ConstMatrix3SoA matrix3_soa_planar(const float* block, size_t count) {
+  const float* m[9];
+  for (int k = 0; k < 9; k++) {
+    m[k] = block + k * count;
+  }
+  return ConstMatrix3SoA(m);
+}
+
+// Quaternion(AngleAxis): (sin(a/2) * axis, cos(a/2)) with simd::sincos. The
+// axis is assumed to be unit length, as Eigen does.
+void angle_axis_to_quat_batch(ConstAngleAxisSoA a, QuatSoA out, size_t count);
+
+// AngleAxis(Quaternion): angle = 2 atan2(|v|, |w|) in [0, pi], axis = v / |v|
+// flipped with the sign of w; the identity maps to angle 0 about +x. Angles are
+// within ~1e-6 rad of Eigen's.
+void quat_to_angle_axis_batch(ConstQuatSoA q, AngleAxisSoA out, size_t count);
+
+// Quaternion::toRotationMatrix(): the unit-quaternion formula, no normalization.
+void quat_to_matrix3_batch(ConstQuatSoA q, Matrix3SoA out, size_t count);
+
+// Quaternion(Matrix3): Eigen's branch on the trace / largest diagonal entry,
+// evaluated as a select over the four cases (one sqrt and one divide per lane).
+void matrix3_to_quat_batch(ConstMatrix3SoA m, QuatSoA out, size_t count);
+
+// AngleAxis::toRotationMatrix() (Rodrigues with simd::sincos of the angle).
+void angle_axis_to_matrix3_batch(ConstAngleAxisSoA a, Matrix3SoA out, size_t count);
+
+// AngleAxis(Matrix3), which Eigen defines through the quaternion; both steps
+// run in registers.
+void matrix3_to_angle_axis_batch(ConstMatrix3SoA m, AngleAxisSoA out, size_t count);
+
+// Runtime dispatch over planar blocks for the bindings.
+enum class RotationFormat { Quaternion, AngleAxis, Matrix3 };
+
+// Floats per rotation in a planar block: 4, 4 or 9.
+inline size_t rotation_format_floats(RotationFormat f) { return f == RotationFormat::Matrix3 ? 9 : 4; }
+
+// Converts `count` rotations from one planar block to another; equal formats copy
+// (`in` may equal `out`).
+void convert_rotation_batch(RotationFormat from, RotationFormat to, const float* in, float* out, size_t count);
@@ -0,0 +1,527 @@
+#pragma once
+// Thin fixed-width float SIMD wrapper shared by the native kernels.
+//
+// The lane count is chosen at compile time from the target flags:
+//   AVX-512F           -> 16 lanes
+//   AVX2               ->  8 lanes
+//   SSE2 (any x86-64)  ->  4 lanes
+//   WASM SIMD128       ->  4 lanes (build with -msimd128)
+//   anything else      ->  1 lane (plain scalar code)
+//
+// Kernels are written once against `simd::vfloat` / `simd::vmask` and process
+// `simd::kWidth` elements per step; tails go through load_n/store_n.
+// load3/store3 convert kWidth interleaved xyz points to per-component vectors
+// and back (store3 writes 3 * kWidth floats); load4/store4 do the same for
+// kWidth records of 4 floats at a fixed stride, e.g. the columns of 4x4 matrices.
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define GEOMETRY_SIMD_AVX512 1
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define GEOMETRY_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SIMD_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define GEOMETRY_SIMD_WASM 1
+#else
+#define GEOMETRY_SIMD_SCALAR 1
+#endif
+
+#if defined(GEOMETRY_SIMD_AVX2) || defined(GEOMETRY_SIMD_SSE2)
+// 4-point xyz (de)interleave within each 128-bit lane; shared by SSE2 and AVX2.
+#define GEOMETRY_SIMD_DEINTERLEAVE3(SHUF, a, b, c, x, y, z)                \
+  do {                                                                     \
+    const auto t_ = SHUF(b, c, _MM_SHUFFLE(2, 1, 3, 2)); /* x2 y2 x3 y3 */ \
+    const auto u_ = SHUF(a, b, _MM_SHUFFLE(1, 0, 2, 1)); /* y0 z0 y1 z1 */ \
+    x = SHUF(a, t_, _MM_SHUFFLE(2, 0, 3, 0));                              \
+    y = SHUF(u_, t_, _MM_SHUFFLE(3, 1, 2, 0));                             \
+    z = SHUF(u_, c, _MM_SHUFFLE(3, 0, 3, 1));                              \
+  } while (0)
+#define GEOMETRY_SIMD_INTERLEAVE3(SHUF, UNPACKLO, UNPACKHI, x, y, z, a, b, c) \
+  do {                                                                        \
+    const auto l_ = UNPACKLO(x, y);                       /* x0 y0 x1 y1 */   \
+    const auto u_ = UNPACKLO(y, z);                       /* y0 z0 y1 z1 */   \
+    const auto t_ = UNPACKHI(x, y);                       /* x2 y2 x3 y3 */   \
+    const auto v_ = SHUF(z, x, _MM_SHUFFLE(1, 1, 0, 0));  /* z0 z0 x1 x1 */   \
+    const auto w_ = SHUF(z, t_, _MM_SHUFFLE(2, 2, 2, 2)); /* z2 z2 x3 x3 */   \
+    const auto s_ = SHUF(t_, z, _MM_SHUFFLE(3, 3, 3, 3)); /* y3 y3 z3 z3 */   \
+    a = SHUF(l_, v_, _MM_SHUFFLE(2, 0, 1, 0));                                \
+    b = SHUF(u_, t_, _MM_SHUFFLE(1, 0, 3, 2));                                \
+    c = SHUF(w_, s_, _MM_SHUFFLE(2, 1, 2, 0));                                \
+  } while (0)
+#endif
+
+#if defined(GEOMETRY_SIMD_AVX512) || defined(GEOMETRY_SIMD_AVX2) || defined(GEOMETRY_SIMD_SSE2)
+// 4x4 transpose within each 128-bit lane: r0..r3 = rows in, columns out.
+#define GEOMETRY_SIMD_TRANSPOSE4(SHUF, UNPACKLO, UNPACKHI, r0, r1, r2, r3) \
+  do {                                                                  \
+    const auto t0_ = UNPACKLO(r0, r1); /* a0 b0 a1 b1 */                \
+    const auto t1_ = UNPACKLO(r2, r3); /* c0 d0 c1 d1 */                \
+    const auto t2_ = UNPACKHI(r0, r1); /* a2 b2 a3 b3 */                \
+    const auto t3_ = UNPACKHI(r2, r3); /* c2 d2 c3 d3 */                \
+    r0 = SHUF(t0_, t1_, _MM_SHUFFLE(1, 0, 1, 0));                       \
+    r1 = SHUF(t0_, t1_, _MM_SHUFFLE(3, 2, 3, 2));                       \
+    r2 = SHUF(t2_, t3_, _MM_SHUFFLE(1, 0, 1, 0));                       \
+    r3 = SHUF(t2_, t3_, _MM_SHUFFLE(3, 2, 3, 2));                       \
+  } while (0)
+#endif
+
+namespace simd {
+
+#if defined(GEOMETRY_SIMD_AVX512)
+
+constexpr size_t kWidth = 16;
+struct vfloat { __m512 v; };
+struct vmask { __mmask16 m; };
+
+inline vfloat splat(float x) { return {_mm512_set1_ps(x)}; }
+inline vfloat load(const float* p) { return {_mm512_loadu_ps(p)}; }
+inline void store(float* p, vfloat a) { _mm512_storeu_ps(p, a.v); }
+inline vfloat operator+(vfloat a, vfloat b) { return {_mm512_add_ps(a.v, b.v)}; }
+inline vfloat operator-(vfloat a, vfloat b) { return {_mm512_sub_ps(a.v, b.v)}; }
+inline vfloat operator*(vfloat a, vfloat b) { return {_mm512_mul_ps(a.v, b.v)}; }
+inline vfloat operator/(vfloat a, vfloat b) { return {_mm512_div_ps(a.v, b.v)}; }
+inline vfloat fmadd(vfloat a, vfloat b, vfloat c) { return {_mm512_fmadd_ps(a.v, b.v, c.v)}; }
+inline vfloat min(vfloat a, vfloat b) { return {_mm512_min_ps(a.v, b.v)}; }
+inline vfloat max(vfloat a, vfloat b) { return {_mm512_max_ps(a.v, b.v)}; }
+inline vfloat sqrt(vfloat a) { return {_mm512_sqrt_ps(a.v)}; }
+inline vfloat round(vfloat a) {
+  return {_mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+}
+inline vfloat bit_and(vfloat a, vfloat b) {
+  return {_mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a.v), _mm512_castps_si512(b.v)))};
+}
+inline vfloat bit_andnot(vfloat a, vfloat b) {  // ~a & b
+  return {_mm512_castsi512_ps(_mm512_andnot_si512(_mm512_castps_si512(a.v), _mm512_castps_si512(b.v)))};
+}
+inline vfloat bit_or(vfloat a, vfloat b) {
+  return {_mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a.v), _mm512_castps_si512(b.v)))};
+}
+inline vfloat bit_xor(vfloat a, vfloat b) {
+  return {_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a.v), _mm512_castps_si512(b.v)))};
+}
+inline vmask operator<(vfloat a, vfloat b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)}; }
+inline vmask operator<=(vfloat a, vfloat b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ)}; }
+inline vmask operator>(vfloat a, vfloat b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ)}; }
+inline vmask operator>=(vfloat a, vfloat b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ)}; }
+inline vmask operator&(vmask a, vmask b) { return {(__mmask16)(a.m & b.m)}; }
+inline vmask operator|(vmask a, vmask b) { return {(__mmask16)(a.m | b.m)}; }
+inline vfloat select(vmask m, vfloat a, vfloat b) { return {_mm512_mask_blend_ps(m.m, b.v, a.v)}; }
+inline uint32_t bits(vmask m) { return (uint32_t)m.m; }
+
+// xyz triples: load3 reads 3 * kWidth interleaved floats into per-component
+// vectors (lane l = point l), store3 writes them back interleaved.
+namespace detail {
+alignas(64) inline const int32_t kDeinterleave3[3][2][16] = {
+    {{0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 17, 20, 23, 26, 29}},
+    {{1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 18, 21, 24, 27, 30}},
+    {{2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 19, 22, 25, 28, 31}},
+};
+alignas(64) inline const int32_t kInterleave3[3][2][16] = {
+    {{0, 16, 0, 1, 17, 0, 2, 18, 0, 3, 19, 0, 4, 20, 0, 5}, {0, 1, 16, 3, 4, 17, 6, 7, 18, 9, 10, 19, 12, 13, 20, 15}},
+    {{21, 0, 6, 22, 0, 7, 23, 0, 8, 24, 0, 9, 25, 0, 10, 26}, {0, 21, 2, 3, 22, 5, 6, 23, 8, 9, 24, 11, 12, 25, 14, 15}},
+    {{0, 11, 27, 0, 12, 28, 0, 13, 29, 0, 14, 30, 0, 15, 31, 0}, {26, 1, 2, 27, 4, 5, 28, 7, 8, 29, 10, 11, 30, 13, 14, 31}},
+};
+inline __m512 permute3(__m512 a, __m512 b, __m512 c, const int32_t (*idx)[16]) {
+  const __m512 ab = _mm512_permutex2var_ps(a, _mm512_load_si512(idx[0]), b);
+  return _mm512_permutex2var_ps(ab, _mm512_load_si512(idx[1]), c);
+}
+}  // namespace detail
+
+inline void load3(const float* p, vfloat& x, vfloat& y, vfloat& z) {
+  const __m512 a = _mm512_loadu_ps(p), b = _mm512_loadu_ps(p + 16), c = _mm512_loadu_ps(p + 32);
+  x.v = detail::permute3(a, b, c, detail::kDeinterleave3[0]);
+  y.v = detail::permute3(a, b, c, detail::kDeinterleave3[1]);
+  z.v = detail::permute3(a, b, c, detail::kDeinterleave3[2]);
+}
+inline void store3(float* p, vfloat x, vfloat y, vfloat z) {
+  _mm512_storeu_ps(p, detail::permute3(x.v, y.v, z.v, detail::kInterleave3[0]));
+  _mm512_storeu_ps(p + 16, detail::permute3(x.v, y.v, z.v, detail::kInterleave3[1]));
+  _mm512_storeu_ps(p + 32, detail::permute3(x.v, y.v, z.v, detail::kInterleave3[2]));
+}
+
+// load_records4 puts record 4k in 128-bit lane k, so after the in-lane
+// transpose lane k holds records 4k..4k+3.
+namespace detail {
+inline __m512 load_records4(const float* p, size_t stride) {
+  __m512 r = _mm512_castps128_ps512(_mm_loadu_ps(p));
+  r = _mm512_insertf32x4(r, _mm_loadu_ps(p + 4 * stride), 1);
+  r = _mm512_insertf32x4(r, _mm_loadu_ps(p + 8 * stride), 2);
+  return _mm512_insertf32x4(r, _mm_loadu_ps(p + 12 * stride), 3);
+}
+inline void store_records4(float* p, size_t stride, __m512 r) {
+  _mm_storeu_ps(p, _mm512_castps512_ps128(r));
+  _mm_storeu_ps(p + 4 * stride, _mm512_extractf32x4_ps(r, 1));
+  _mm_storeu_ps(p + 8 * stride, _mm512_extractf32x4_ps(r, 2));
+  _mm_storeu_ps(p + 12 * stride, _mm512_extractf32x4_ps(r, 3));
+}
+}  // namespace detail
+inline void load4(const float* p, size_t stride, vfloat& a, vfloat& b, vfloat& c, vfloat& d) {
+  a.v = detail::load_records4(p, stride);
+  b.v = detail::load_records4(p + stride, stride);
+  c.v = detail::load_records4(p + 2 * stride, stride);
+  d.v = detail::load_records4(p + 3 * stride, stride);
+  GEOMETRY_SIMD_TRANSPOSE4(_mm512_shuffle_ps, _mm512_unpacklo_ps, _mm512_unpackhi_ps, a.v, b.v, c.v, d.v);
+}
+inline void store4(float* p, size_t stride, vfloat a, vfloat b, vfloat c, vfloat d) {
+  GEOMETRY_SIMD_TRANSPOSE4(_mm512_shuffle_ps, _mm512_unpacklo_ps, _mm512_unpackhi_ps, a.v, b.v, c.v, d.v);
+  detail::store_records4(p, stride, a.v);
+  detail::store_records4(p + stride, stride, b.v);
+  detail::store_records4(p + 2 * stride, stride, c.v);
+  detail::store_records4(p + 3 * stride, stride, d.v);
+}
+
+#elif defined(GEOMETRY_SIMD_AVX2)
+
+constexpr size_t kWidth = 8;
+struct vfloat { __m256 v; };
+struct vmask { __m256 m; };
+
+inline vfloat splat(float x) { return {_mm256_set1_ps(x)}; }
+inline vfloat load(const float* p) { return {_mm256_loadu_ps(p)}; }
+inline void store(float* p, vfloat a) { _mm256_storeu_ps(p, a.v); }
+inline vfloat operator+(vfloat a, vfloat b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline vfloat operator-(vfloat a, vfloat b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline vfloat operator*(vfloat a, vfloat b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline vfloat operator/(vfloat a, vfloat b) { return {_mm256_div_ps(a.v, b.v)}; }
+#if defined(__FMA__)
+inline vfloat fmadd(vfloat a, vfloat b, vfloat c) { return {_mm256_fmadd_ps(a.v, b.v, c.v)}; }
+#else
+inline vfloat fmadd(vfloat a, vfloat b, vfloat c) { return {_mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v)}; }
+#endif
+inline vfloat min(vfloat a, vfloat b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline vfloat max(vfloat a, vfloat b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline vfloat sqrt(vfloat a) { return {_mm256_sqrt_ps(a.v)}; }
+inline vfloat round(vfloat a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+inline vfloat bit_and(vfloat a, vfloat b) { return {_mm256_and_ps(a.v, b.v)}; }
+inline vfloat bit_andnot(vfloat a, vfloat b) { return {_mm256_andnot_ps(a.v, b.v)}; }
+inline vfloat bit_or(vfloat a, vfloat b) { return {_mm256_or_ps(a.v, b.v)}; }
+inline vfloat bit_xor(vfloat a, vfloat b) { return {_mm256_xor_ps(a.v, b.v)}; }
+inline vmask operator<(vfloat a, vfloat b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline vmask operator<=(vfloat a, vfloat b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+inline vmask operator>(vfloat a, vfloat b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+inline vmask operator>=(vfloat a, vfloat b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+inline vmask operator&(vmask a, vmask b) { return {_mm256_and_ps(a.m, b.m)}; }
+inline vmask operator|(vmask a, vmask b) { return {_mm256_or_ps(a.m, b.m)}; }
+inline vfloat select(vmask m, vfloat a, vfloat b) { return {_mm256_blendv_ps(b.v, a.v, m.m)}; }
+inline uint32_t bits(vmask m) { return (uint32_t)_mm256_movemask_ps(m.m); }
+
+// Each 128-bit lane handles 4 points: lane 0 points 0-3 (floats 0-11), lane 1
+// points 4-7 (floats 12-23).
+inline void load3(const float* p, vfloat& x, vfloat& y, vfloat& z) {
+  const __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+  const __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+  const __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+  GEOMETRY_SIMD_DEINTERLEAVE3(_mm256_shuffle_ps, a, b, c, x.v, y.v, z.v);
+}
+inline void store3(float* p, vfloat x, vfloat y, vfloat z) {
+  __m256 a, b, c;
+  GEOMETRY_SIMD_INTERLEAVE3(_mm256_shuffle_ps, _mm256_unpacklo_ps, _mm256_unpackhi_ps, x.v, y.v, z.v, a, b, c);
+  _mm_storeu_ps(p, _mm256_castps256_ps128(a));
+  _mm_storeu_ps(p + 4, _mm256_castps256_ps128(b));
+  _mm_storeu_ps(p + 8, _mm256_castps256_ps128(c));
+  _mm_storeu_ps(p + 12, _mm256_extractf128_ps(a, 1));
+  _mm_storeu_ps(p + 16, _mm256_extractf128_ps(b, 1));
+  _mm_storeu_ps(p + 20, _mm256_extractf128_ps(c, 1));
+}
+
+// load_records4 puts records 0 and 4 in the low and high 128-bit lanes, so
+// after the in-lane transpose those hold records 0-3 and 4-7.
+namespace detail {
+inline __m256 load_records4(const float* p, size_t stride) {
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 4 * stride), 1);
+}
+inline void store_records4(float* p, size_t stride, __m256 r) {
+  _mm_storeu_ps(p, _mm256_castps256_ps128(r));
+  _mm_storeu_ps(p + 4 * stride, _mm256_extractf128_ps(r, 1));
+}
+}  // namespace detail
+inline void load4(const float* p, size_t stride, vfloat& a, vfloat& b, vfloat& c, vfloat& d) {
+  a.v = detail::load_records4(p, stride);
+  b.v = detail::load_records4(p + stride, stride);
+  c.v = detail::load_records4(p + 2 * stride, stride);
+  d.v = detail::load_records4(p + 3 * stride, stride);
+  GEOMETRY_SIMD_TRANSPOSE4(_mm256_shuffle_ps, _mm256_unpacklo_ps, _mm256_unpackhi_ps, a.v, b.v, c.v, d.v);
+}
+inline void store4(float* p, size_t stride, vfloat a, vfloat b, vfloat c, vfloat d) {
+  GEOMETRY_SIMD_TRANSPOSE4(_mm256_shuffle_ps, _mm256_unpacklo_ps, _mm256_unpackhi_ps, a.v, b.v, c.v, d.v);
+  detail::store_records4(p, stride, a.v);
+  detail::store_records4(p + stride, stride, b.v);
+  detail::store_records4(p + 2 * stride, stride, c.v);
+  detail::store_records4(p + 3 * stride, stride, d.v);
+}
+
+#elif defined(GEOMETRY_SIMD_SSE2)
+
+constexpr size_t kWidth = 4;
+struct vfloat { __m128 v; };
+struct vmask { __m128 m; };
+
+inline vfloat splat(float x) { return {_mm_set1_ps(x)}; }
+inline vfloat load(const float* p) { return {_mm_loadu_ps(p)}; }
+inline void store(float* p, vfloat a) { _mm_storeu_ps(p, a.v); }
+inline vfloat operator+(vfloat a, vfloat b) { return {_mm_add_ps(a.v, b.v)}; }
+inline vfloat operator-(vfloat a, vfloat b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline vfloat operator*(vfloat a, vfloat b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline vfloat operator/(vfloat a, vfloat b) { return {_mm_div_ps(a.v, b.v)}; }
+inline vfloat fmadd(vfloat a, vfloat b, vfloat c) { return {_mm_add_ps(_mm_mul_ps(a.v, b.v), c.v)}; }
+inline vfloat min(vfloat a, vfloat b) { return {_mm_min_ps(a.v, b.v)}; }
+inline vfloat max(vfloat a, vfloat b) { return {_mm_max_ps(a.v, b.v)}; }
+inline vfloat sqrt(vfloat a) { return {_mm_sqrt_ps(a.v)}; }
+// SSE2 has no roundps; the int round trip is exact for |a| < 2^31, which covers
+// every range-reduction use in the kernels.
+inline vfloat round(vfloat a) { return {_mm_cvtepi32_ps(_mm_cvtps_epi32(a.v))}; }
+inline vfloat bit_and(vfloat a, vfloat b) { return {_mm_and_ps(a.v, b.v)}; }
+inline vfloat bit_andnot(vfloat a, vfloat b) { return {_mm_andnot_ps(a.v, b.v)}; }
+inline vfloat bit_or(vfloat a, vfloat b) { return {_mm_or_ps(a.v, b.v)}; }
+inline vfloat bit_xor(vfloat a, vfloat b) { return {_mm_xor_ps(a.v, b.v)}; }
+inline vmask operator<(vfloat a, vfloat b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline vmask operator<=(vfloat a, vfloat b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline vmask operator>(vfloat a, vfloat b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline vmask operator>=(vfloat a, vfloat b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+inline vmask operator&(vmask a, vmask b) { return {_mm_and_ps(a.m, b.m)}; }
+inline vmask operator|(vmask a, vmask b) { return {_mm_or_ps(a.m, b.m)}; }
+inline vfloat select(vmask m, vfloat a, vfloat b) {
+  return {_mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v))};
+}
+inline uint32_t bits(vmask m) { return (uint32_t)_mm_movemask_ps(m.m); }
+
+inline void load3(const float* p, vfloat& x, vfloat& y, vfloat& z) {
+  const __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+  GEOMETRY_SIMD_DEINTERLEAVE3(_mm_shuffle_ps, a, b, c, x.v, y.v, z.v);
+}
+inline void store3(float* p, vfloat x, vfloat y, vfloat z) {
+  __m128 a, b, c;
+  GEOMETRY_SIMD_INTERLEAVE3(_mm_shuffle_ps, _mm_unpacklo_ps, _mm_unpackhi_ps, x.v, y.v, z.v, a, b, c);
+  _mm_storeu_ps(p, a);
+  _mm_storeu_ps(p + 4, b);
+  _mm_storeu_ps(p + 8, c);
+}
+
+inline void load4(const float* p, size_t stride, vfloat& a, vfloat& b, vfloat& c, vfloat& d) {
+  a.v = _mm_loadu_ps(p);
+  b.v = _mm_loadu_ps(p + stride);
+  c.v = _mm_loadu_ps(p + 2 * stride);
+  d.v = _mm_loadu_ps(p + 3 * stride);
+  GEOMETRY_SIMD_TRANSPOSE4(_mm_shuffle_ps, _mm_unpacklo_ps, _mm_unpackhi_ps, a.v, b.v, c.v, d.v);
+}
+inline void store4(float* p, size_t stride, vfloat a, vfloat b, vfloat c, vfloat d) {
+  GEOMETRY_SIMD_TRANSPOSE4(_mm_shuffle_ps, _mm_unpacklo_ps, _mm_unpackhi_ps, a.v, b.v, c.v, d.v);
+  _mm_storeu_ps(p, a.v);
+  _mm_storeu_ps(p + stride, b.v);
+  _mm_storeu_ps(p + 2 * stride, c.v);
+  _mm_storeu_ps(p + 3 * stride, d.v);
+}
+
+#elif defined(GEOMETRY_SIMD_WASM)
+
+constexpr size_t kWidth = 4;
+struct vfloat { v128_t v; };
+struct vmask { v128_t m; };
+
+inline vfloat splat(float x) { return {wasm_f32x4_splat(x)}; }
+inline vfloat load(const float* p) { return {wasm_v128_load(p)}; }
+inline void store(float* p, vfloat a) { wasm_v128_store(p, a.v); }
+inline vfloat operator+(vfloat a, vfloat b) { return {wasm_f32x4_add(a.v, b.v)}; }
+inline vfloat operator-(vfloat a, vfloat b) { return {wasm_f32x4_sub(a.v, b.v)}; }
+inline vfloat operator*(vfloat a, vfloat b) { return {wasm_f32x4_mul(a.v, b.v)}; }
+inline vfloat operator/(vfloat a, vfloat b) { return {wasm_f32x4_div(a.v, b.v)}; }
+inline vfloat fmadd(vfloat a, vfloat b, vfloat c) { return {wasm_f32x4_add(wasm_f32x4_mul(a.v, b.v), c.v)}; }
+inline vfloat min(vfloat a, vfloat b) { return {wasm_f32x4_pmin(a.v, b.v)}; }
+inline vfloat max(vfloat a, vfloat b) { return {wasm_f32x4_pmax(a.v, b.v)}; }
+inline vfloat sqrt(vfloat a) { return {wasm_f32x4_sqrt(a.v)}; }
+inline vfloat round(vfloat a) { return {wasm_f32x4_nearest(a.v)}; }
+inline vfloat bit_and(vfloat a, vfloat b) { return {wasm_v128_and(a.v, b.v)}; }
+inline vfloat bit_andnot(vfloat a, vfloat b) { return {wasm_v128_andnot(b.v, a.v)}; }
+inline vfloat bit_or(vfloat a, vfloat b) { return {wasm_v128_or(a.v, b.v)}; }
+inline vfloat bit_xor(vfloat a, vfloat b) { return {wasm_v128_xor(a.v, b.v)}; }
+inline vmask operator<(vfloat a, vfloat b) { return {wasm_f32x4_lt(a.v, b.v)}; }
+inline vmask operator<=(vfloat a, vfloat b) { return {wasm_f32x4_le(a.v, b.v)}; }
+inline vmask operator>(vfloat a, vfloat b) { return {wasm_f32x4_gt(a.v, b.v)}; }
+inline vmask operator>=(vfloat a, vfloat b) { return {wasm_f32x4_ge(a.v, b.v)}; }
+inline vmask operator&(vmask a, vmask b) { return {wasm_v128_and(a.m, b.m)}; }
+inline vmask operator|(vmask a, vmask b) { return {wasm_v128_or(a.m, b.m)}; }
+inline vfloat select(vmask m, vfloat a, vfloat b) { return {wasm_v128_bitselect(a.v, b.v, m.m)}; }
+inline uint32_t bits(vmask m) { return (uint32_t)wasm_i32x4_bitmask(m.m); }
+
+inline void load3(const float* p, vfloat& x, vfloat& y, vfloat& z) {
+  const v128_t a = wasm_v128_load(p), b = wasm_v128_load(p + 4), c = wasm_v128_load(p + 8);
+  const v128_t t = wasm_i32x4_shuffle(b, c, 2, 3, 5, 6);  // x2 y2 x3 y3
+  const v128_t u = wasm_i32x4_shuffle(a, b, 1, 2, 4, 5);  // y0 z0 y1 z1
+  x.v = wasm_i32x4_shuffle(a, t, 0, 3, 4, 6);
+  y.v = wasm_i32x4_shuffle(u, t, 0, 2, 5, 7);
+  z.v = wasm_i32x4_shuffle(u, c, 1, 3, 4, 7);
+}
+inline void store3(float* p, vfloat x, vfloat y, vfloat z) {
+  const v128_t l = wasm_i32x4_shuffle(x.v, y.v, 0, 4, 1, 5);  // x0 y0 x1 y1
+  const v128_t q = wasm_i32x4_shuffle(x.v, y.v, 2, 6, 3, 7);  // x2 y2 x3 y3
+  const v128_t m = wasm_i32x4_shuffle(y.v, z.v, 1, 5, 0, 0);  // y1 z1 -- --
+  wasm_v128_store(p, wasm_i32x4_shuffle(l, z.v, 0, 1, 4, 2));
+  wasm_v128_store(p + 4, wasm_i32x4_shuffle(m, q, 0, 1, 4, 5));
+  wasm_v128_store(p + 8, wasm_i32x4_shuffle(q, z.v, 6, 2, 3, 7));
+}
+
+inline void transpose4(v128_t& r0, v128_t& r1, v128_t& r2, v128_t& r3) {
+  const v128_t t0 = wasm_i32x4_shuffle(r0, r1, 0, 4, 1, 5);  // a0 b0 a1 b1
+  const v128_t t1 = wasm_i32x4_shuffle(r2, r3, 0, 4, 1, 5);  // c0 d0 c1 d1
+  const v128_t t2 = wasm_i32x4_shuffle(r0, r1, 2, 6, 3, 7);  // a2 b2 a3 b3
+  const v128_t t3 = wasm_i32x4_shuffle(r2, r3, 2, 6, 3, 7);  // c2 d2 c3 d3
+  r0 = wasm_i32x4_shuffle(t0, t1, 0, 1, 4, 5);
+  r1 = wasm_i32x4_shuffle(t0, t1, 2, 3, 6, 7);
+  r2 = wasm_i32x4_shuffle(t2, t3, 0, 1, 4, 5);
+  r3 = wasm_i32x4_shuffle(t2, t3, 2, 3, 6, 7);
+}
+inline void load4(const float* p, size_t stride, vfloat& a, vfloat& b, vfloat& c, vfloat& d) {
+  a.v = wasm_v128_load(p);
+  b.v = wasm_v128_load(p + stride);
+  c.v = wasm_v128_load(p + 2 * stride);
+  d.v = wasm_v128_load(p + 3 * stride);
+  transpose4(a.v, b.v, c.v, d.v);
+}
+inline void store4(float* p, size_t stride, vfloat a, vfloat b, vfloat c, vfloat d) {
+  transpose4(a.v, b.v, c.v, d.v);
+  wasm_v128_store(p, a.v);
+  wasm_v128_store(p + stride, b.v);
+  wasm_v128_store(p + 2 * stride, c.v);
+  wasm_v128_store(p + 3 * stride, d.v);
+}
+
+#else
+
+constexpr size_t kWidth = 1;
+struct vfloat { float v; };
+struct vmask { bool m; };
+
+inline float as_float(uint32_t u) { float f; std::memcpy(&f, &u, sizeof f); return f; }
+inline uint32_t as_uint(float f) { uint32_t u; std::memcpy(&u, &f, sizeof u); return u; }
+
+inline vfloat splat(float x) { return {x}; }
+inline vfloat load(const float* p) { return {*p}; }
+inline void store(float* p, vfloat a) { *p = a.v; }
+inline vfloat operator+(vfloat a, vfloat b) { return {a.v + b.v}; }
+inline vfloat operator-(vfloat a, vfloat b) { return {a.v - b.v}; }
+inline vfloat operator*(vfloat a, vfloat b) { return {a.v * b.v}; }
+inline vfloat operator/(vfloat a, vfloat b) { return {a.v / b.v}; }
+inline vfloat fmadd(vfloat a, vfloat b, vfloat c) { return {a.v * b.v + c.v}; }
+inline vfloat min(vfloat a, vfloat b) { return {b.v < a.v ? b.v : a.v}; }
+inline vfloat max(vfloat a, vfloat b) { return {a.v < b.v ? b.v : a.v}; }
+inline vfloat sqrt(vfloat a) { return {std::sqrt(a.v)}; }
+inline vfloat round(vfloat a) { return {std::nearbyint(a.v)}; }
+inline vfloat bit_and(vfloat a, vfloat b) { return {as_float(as_uint(a.v) & as_uint(b.v))}; }
+inline vfloat bit_andnot(vfloat a, vfloat b) { return {as_float(~as_uint(a.v) & as_uint(b.v))}; }
+inline vfloat bit_or(vfloat a, vfloat b) { return {as_float(as_uint(a.v) | as_uint(b.v))}; }
+inline vfloat bit_xor(vfloat a, vfloat b) { return {as_float(as_uint(a.v) ^ as_uint(b.v))}; }
+inline vmask operator<(vfloat a, vfloat b) { return {a.v < b.v}; }
+inline vmask operator<=(vfloat a, vfloat b) { return {a.v <= b.v}; }
+inline vmask operator>(vfloat a, vfloat b) { return {a.v > b.v}; }
+inline vmask operator>=(vfloat a, vfloat b) { return {a.v >= b.v}; }
+inline vmask operator&(vmask a, vmask b) { return {a.m && b.m}; }
+inline vmask operator|(vmask a, vmask b) { return {a.m || b.m}; }
+inline vfloat select(vmask m, vfloat a, vfloat b) { return m.m ? a : b; }
+inline uint32_t bits(vmask m) { return m.m ? 1u : 0u; }
+
+inline void load3(const float* p, vfloat& x, vfloat& y, vfloat& z) {
+  x.v = p[0];
+  y.v = p[1];
+  z.v = p[2];
+}
+inline void store3(float* p, vfloat x, vfloat y, vfloat z) {
+  p[0] = x.v;
+  p[1] = y.v;
+  p[2] = z.v;
+}
+
+inline void load4(const float* p, size_t, vfloat& a, vfloat& b, vfloat& c, vfloat& d) {
+  a.v = p[0];
+  b.v = p[1];
+  c.v = p[2];
+  d.v = p[3];
+}
+inline void store4(float* p, size_t, vfloat a, vfloat b, vfloat c, vfloat d) {
+  p[0] = a.v;
+  p[1] = b.v;
+  p[2] = c.v;
+  p[3] = d.v;
+}
+
+#endif
+
+// ---- ISA-independent helpers ----
+
+inline vfloat operator-(vfloat a) { return bit_xor(a, splat(-0.0f)); }
+inline vfloat& operator+=(vfloat& a, vfloat b) { return a = a + b; }
+inline vfloat& operator-=(vfloat& a, vfloat b) { return a = a - b; }
+inline vfloat& operator*=(vfloat& a, vfloat b) { return a = a * b; }
+
+inline vfloat abs(vfloat a) { return bit_andnot(splat(-0.0f), a); }
+// Magnitude of `mag` with the sign bit of `sgn`.
+inline vfloat copysign(vfloat mag, vfloat sgn) {
+  const vfloat signBit = splat(-0.0f);
+  return bit_or(bit_andnot(signBit, mag), bit_and(signBit, sgn));
+}
+// Flips the sign of `a` wherever `sgn` is negative.
+inline vfloat mulsign(vfloat a, vfloat sgn) { return bit_xor(a, bit_and(splat(-0.0f), sgn)); }
+
+inline bool any(vmask m) { return bits(m) != 0; }
+inline bool all(vmask m) { return bits(m) == (kWidth >= 32 ? 0xffffffffu : ((1u << kWidth) - 1u)); }
+
+// Partial load/store for loop tails (n < kWidth). Missing lanes read as zero.
+inline vfloat load_n(const float* p, size_t n) {
+  alignas(64) float tmp[kWidth] = {};
+  std::memcpy(tmp, p, n * sizeof(float));
+  return load(tmp);
+}
+
+inline void store_n(float* p, vfloat a, size_t n) {
+  alignas(64) float tmp[kWidth];
+  store(tmp, a);
+  std::memcpy(p, tmp, n * sizeof(float));
+}
+
+// load3/store3 for the last n < kWidth points.
+inline void load3_n(const float* p, size_t n, vfloat& x, vfloat& y, vfloat& z) {
+  alignas(64) float tmp[3 * kWidth] = {};
+  std::memcpy(tmp, p, 3 * n * sizeof(float));
+  load3(tmp, x, y, z);
+}
+
+inline void store3_n(float* p, size_t n, vfloat x, vfloat y, vfloat z) {
+  alignas(64) float tmp[3 * kWidth];
+  store3(tmp, x, y, z);
+  std::memcpy(p, tmp, 3 * n * sizeof(float));
+}
+
+// load4/store4 for the last n < kWidth records (`stride` floats apart).
+inline void load4_n(const float* p, size_t stride, size_t n, vfloat& a, vfloat& b, vfloat& c, vfloat& d) {
+  alignas(64) float tmp[4 * kWidth] = {};
+  for (size_t l = 0; l < n; l++) {
+    std::memcpy(tmp + 4 * l, p + l * stride, 4 * sizeof(float));
+  }
+  load4(tmp, 4, a, b, c, d);
+}
+
+inline void store4_n(float* p, size_t stride, size_t n, vfloat a, vfloat b, vfloat c, vfloat d) {
+  alignas(64) float tmp[4 * kWidth];
+  store4(tmp, 4, a, b, c, d);
+  for (size_t l = 0; l < n; l++) {
+    std::memcpy(p + l * stride, tmp + 4 * l, 4 * sizeof(float));
+  }
+}
+
+// Gathers base[idx[l] * stride] into lane l.
+inline vfloat gather(const float* base, const uint32_t* idx, size_t stride, size_t n = kWidth) {
+  alignas(64) float tmp[kWidth] = {};
+  for (size_t l = 0; l < n; l++) {
+    tmp[l] = base[(size_t)idx[l] * stride];
+  }
+  return load(tmp);
+}
+
+}  // namespace simd
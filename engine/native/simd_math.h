@@ -0,0 +1,101 @@
+#pragma once
+// Polynomial approximations of the transcendental functions the batch kernels
+// need, written once against simd.h so they vectorize on every target.
+// Error bounds are for float evaluation and were measured against double libm.
+#include "simd.h"
+
+namespace simd {
+
+// acos on [-1, 1] (Abramowitz & Stegun 4.4.46: sqrt(1 - x) * P7(x) on [0, 1],
+// reflected for x < 0). Max abs error ~4.5e-7 rad. Inputs outside [-1, 1] are clamped.
+inline vfloat acos(vfloat x) {
+  const vfloat a = min(abs(x), splat(1.0f));
+  vfloat p = splat(-0.0012624911f);
+  p = fmadd(p, a, splat(0.0066700901f));
+  p = fmadd(p, a, splat(-0.0170881256f));
+  p = fmadd(p, a, splat(0.0308918810f));
+  p = fmadd(p, a, splat(-0.0501743046f));
+  p = fmadd(p, a, splat(0.0889789874f));
+  p = fmadd(p, a, splat(-0.2145988016f));
+  p = fmadd(p, a, splat(1.5707963050f));
+  const vfloat r = sqrt(splat(1.0f) - a) * p;
+  return select(x < splat(0.0f), splat(3.14159265358979f) - r, r);
+}
+
+// sin and cos together (cephes sinf/cosf): reduce by the nearest multiple of
+// pi/2 with a three-part Cody-Waite split, evaluate both minimax polynomials on
+// [-pi/4, pi/4] and pick/negate by quadrant. Max abs error ~1e-7 for |x| < 8192.
+inline void sincos(vfloat x, vfloat& s, vfloat& c) {
+  const vfloat j = round(x * splat(0.63661977236758134f));  // x * 2/pi
+  vfloat r = fmadd(j, splat(-1.5703125f), x);
+  r = fmadd(j, splat(-4.837512969970703125e-4f), r);
+  r = fmadd(j, splat(-7.54978995489188216e-8f), r);
+  const vfloat r2 = r * r;
+
+  vfloat ps = splat(-1.9515295891e-4f);
+  ps = fmadd(ps, r2, splat(8.3321608736e-3f));
+  ps = fmadd(ps, r2, splat(-1.6666654611e-1f));
+  const vfloat sinR = fmadd(ps * r2, r, r);
+
+  vfloat pc = splat(2.443315711809948e-5f);
+  pc = fmadd(pc, r2, splat(-1.388731625493765e-3f));
+  pc = fmadd(pc, r2, splat(4.166664568298827e-2f));
+  const vfloat cosR = fmadd(pc * r2, r2, fmadd(splat(-0.5f), r2, splat(1.0f)));
+
+  // Quadrant q = j mod 4 without integer lanes: j is odd iff j - 2*round(j/2)
+  // is +-1 (ties round either way), and floor(j/2) = round((j - 1)/2 + 1/4).
+  const vfloat half = splat(0.5f);
+  const vmask odd = abs(j - splat(2.0f) * round(j * half)) > half;
+  const vfloat h = round(fmadd(j - splat(1.0f), half, splat(0.25f)));     // floor(j/2)
+  const vfloat hc = round(fmadd(j, half, splat(0.25f)));                  // floor((j+1)/2)
+  const vmask sinNeg = abs(h - splat(2.0f) * round(h * half)) > half;     // q in {2, 3}
+  const vmask cosNeg = abs(hc - splat(2.0f) * round(hc * half)) > half;   // q in {1, 2}
+
+  const vfloat sinMag = select(odd, cosR, sinR);
+  const vfloat cosMag = select(odd, sinR, cosR);
+  const vfloat negZero = splat(-0.0f);
+  s = bit_xor(sinMag, select(sinNeg, negZero, splat(0.0f)));
+  c = bit_xor(cosMag, select(cosNeg, negZero, splat(0.0f)));
+}
+
+// atan2(y, x) with std::atan2's quadrants and signed zeros (cephes atanf
+// polynomial): t = min(|x|, |y|) / max(|x|, |y|) in [0, 1], above tan(pi/8)
+// reduced by pi/4 through (min - max) / (min + max), so each lane costs a
+// single division. Max abs error ~3e-7 rad; atan2(0, 0) = 0.
+inline vfloat atan2(vfloat y, vfloat x) {
+  const vfloat ax = abs(x);
+  const vfloat ay = abs(y);
+  const vfloat lo = min(ax, ay);
+  const vfloat hi = max(ax, ay);
+
+  const vmask reduce = lo > hi * splat(0.41421356237f);
+  const vfloat num = select(reduce, lo - hi, lo);
+  const vfloat den = select(reduce, lo + hi, select(hi > splat(0.0f), hi, splat(1.0f)));
+  const vfloat t = num / den;
+  const vfloat z = t * t;
+
+  vfloat p = splat(8.05374449538e-2f);
+  p = fmadd(p, z, splat(-1.38776856032e-1f));
+  p = fmadd(p, z, splat(1.99777106478e-1f));
+  p = fmadd(p, z, splat(-3.33329491539e-1f));
+  vfloat r = fmadd(p * z, t, t);
+  r = select(reduce, r + splat(0.78539816339744831f), r);
+
+  r = select(ay > ax, splat(1.5707963267948966f) - r, r);
+  r = select(copysign(splat(1.0f), x) < splat(0.0f), splat(3.14159265358979f) - r, r);
+  return copysign(r, y);
+}
+
+inline vfloat sin(vfloat x) {
+  vfloat s, c;
+  sincos(x, s, c);
+  return s;
+}
+
+inline vfloat cos(vfloat x) {
+  vfloat s, c;
+  sincos(x, s, c);
+  return c;
+}
+
+}  // namespace simd
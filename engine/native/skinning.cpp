@@ -0,0 +1,225 @@
+#include "skinning.h"
+
+#include <cstring>
+
+#include "parallel.h"
+#include "simd.h"
+
+namespace {
+
+using simd::vfloat;
+
+// Vertices per pool job.
+constexpr size_t kGrain = 4096;
+
+inline void load_xyz(const float* xyz, size_t i, size_t n, vfloat* v) {
+  if (n == simd::kWidth) {
+    simd::load3(xyz + i * 3, v[0], v[1], v[2]);
+  } else {
+    simd::load3_n(xyz + i * 3, n, v[0], v[1], v[2]);
+  }
+}
+
+inline void store_xyz(float* xyz, size_t i, size_t n, const vfloat* v) {
+  if (n == simd::kWidth) {
+    simd::store3(xyz + i * 3, v[0], v[1], v[2]);
+  } else {
+    simd::store3_n(xyz + i * 3, n, v[0], v[1], v[2]);
+  }
+}
+
+// Zero-length vectors stay zero (Three divides by `length() || 1`).
+inline void normalize(vfloat* v) {
+  using simd::fmadd;
+  const vfloat one = simd::splat(1.0f);
+  const vfloat len2 = fmadd(v[0], v[0], fmadd(v[1], v[1], v[2] * v[2]));
+  const vfloat inv = simd::select(len2 > simd::splat(0.0f), one / simd::sqrt(len2), one);
+  for (int c = 0; c < 3; c++) {
+    v[c] *= inv;
+  }
+}
+
+// Runs skin(i, n, position, normal) over the vertices in pool-sized chunks, for
+// vertices [i, i + n), n <= kWidth. `normal` is null when the mesh has no normals.
+template <typename Skin>
+void for_each_vertex_lanes(const SkinningInput& in, float* outPositions, float* outNormals, Skin skin) {
+  const bool withNormals = in.normals != nullptr && outNormals != nullptr;
+  parallel::parallel_for(in.vertexCount, kGrain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i += simd::kWidth) {
+      const size_t n = end - i < simd::kWidth ? end - i : simd::kWidth;
+      vfloat p[3], nrm[3];
+      load_xyz(in.positions, i, n, p);
+      if (withNormals) {
+        load_xyz(in.normals, i, n, nrm);
+      }
+      skin(i, n, p, withNormals ? nrm : nullptr);
+      store_xyz(outPositions, i, n, p);
+      if (withNormals) {
+        store_xyz(outNormals, i, n, nrm);
+      }
+    }
+  });
+}
+
+// sum_k w_k * bone[i_k] as column-major linear part m[0..8] plus translation
+// m[9..11]. Blending is per vertex on whole columns (Matrix4f packets, four
+// multiply-adds per influence; zero weights are not skipped, a branch costs
+// more than the multiply); the kWidth blended matrices are then transposed
+// into lanes with one load4 per column.
+inline void blend_matrices(const SkinningInput& in, size_t i, size_t n, const float* boneMatrices, vfloat* m) {
+  alignas(64) float blended[simd::kWidth][16];
+  for (size_t l = 0; l < n; l++) {
+    const uint16_t* bone = in.boneIndices + (i + l) * 4;
+    const float* weight = in.boneWeights + (i + l) * 4;
+    Eigen::Map<Eigen::Matrix4f, Eigen::Aligned16> out(blended[l]);
+    out.setZero();
+    for (int k = 0; k < 4; k++) {
+      out.noalias() += weight[k] * Eigen::Map<const Eigen::Matrix4f>(boneMatrices + 16 * (size_t)bone[k]);
+    }
+  }
+  for (int col = 0; col < 4; col++) {
+    vfloat bottom;
+    if (n == simd::kWidth) {
+      simd::load4(blended[0] + col * 4, 16, m[col * 3], m[col * 3 + 1], m[col * 3 + 2], bottom);
+    } else {
+      simd::load4_n(blended[0] + col * 4, 16, n, m[col * 3], m[col * 3 + 1], m[col * 3 + 2], bottom);
+    }
+  }
+}
+
+// sum_k s_k w_k * dq[i_k] as real xyzw in q[0..3] and dual xyzw in q[4..7],
+// with s_k = -1 for influences antipodal to the heaviest one. The influences'
+// dual quaternions are copied into a per-step buffer and transposed into lanes
+// (simd::load4), so picking the pivot and the signs are lane selects rather
+// than per-vertex branches on random data.
+inline void blend_dual_quats(const SkinningInput& in, size_t i, size_t n, const float* dualQuats, vfloat* q) {
+  using simd::select;
+  alignas(64) float staged[4][simd::kWidth][kDualQuatFloats];
+  if (n < simd::kWidth) {
+    std::memset(staged, 0, sizeof(staged));  // unused tail lanes blend to zero
+  }
+  for (size_t l = 0; l < n; l++) {
+    const uint16_t* bone = in.boneIndices + (i + l) * 4;
+    for (int k = 0; k < 4; k++) {
+      std::memcpy(staged[k][l], dualQuats + kDualQuatFloats * (size_t)bone[k], sizeof(staged[k][l]));
+    }
+  }
+  vfloat w[4];
+  if (n == simd::kWidth) {
+    simd::load4(in.boneWeights + i * 4, 4, w[0], w[1], w[2], w[3]);
+  } else {
+    simd::load4_n(in.boneWeights + i * 4, 4, n, w[0], w[1], w[2], w[3]);
+  }
+  vfloat dq[4][8];
+  for (int k = 0; k < 4; k++) {
+    simd::load4(staged[k][0], kDualQuatFloats, dq[k][0], dq[k][1], dq[k][2], dq[k][3]);
+    simd::load4(staged[k][0] + 4, kDualQuatFloats, dq[k][4], dq[k][5], dq[k][6], dq[k][7]);
+  }
+
+  // Real part of the heaviest influence (the first one on ties).
+  vfloat pivot[4], pivotWeight = w[0];
+  for (int c = 0; c < 4; c++) {
+    pivot[c] = dq[0][c];
+  }
+  for (int k = 1; k < 4; k++) {
+    const simd::vmask heavier = w[k] > pivotWeight;
+    pivotWeight = select(heavier, w[k], pivotWeight);
+    for (int c = 0; c < 4; c++) {
+      pivot[c] = select(heavier, dq[k][c], pivot[c]);
+    }
+  }
+
+  for (int c = 0; c < 8; c++) {
+    q[c] = simd::splat(0.0f);
+  }
+  for (int k = 0; k < 4; k++) {
+    using simd::fmadd;
+    const vfloat dot =
+        fmadd(dq[k][0], pivot[0], fmadd(dq[k][1], pivot[1], fmadd(dq[k][2], pivot[2], dq[k][3] * pivot[3])));
+    const vfloat wk = select(dot < simd::splat(0.0f), -w[k], w[k]);
+    for (int c = 0; c < 8; c++) {
+      q[c] = fmadd(wk, dq[k][c], q[c]);
+    }
+  }
+}
+
+inline void cross(const vfloat* a, const vfloat* b, vfloat* out) {
+  using simd::fmadd;
+  out[0] = fmadd(a[1], b[2], -(a[2] * b[1]));
+  out[1] = fmadd(a[2], b[0], -(a[0] * b[2]));
+  out[2] = fmadd(a[0], b[1], -(a[1] * b[0]));
+}
+
+// v += 2 u x (u x v + w v): the unit quaternion (u, w) applied to v.
+inline void rotate(const vfloat* u, vfloat w, vfloat* v) {
+  vfloat uv[3], t[3];
+  cross(u, v, uv);
+  for (int c = 0; c < 3; c++) {
+    uv[c] = simd::fmadd(w, v[c], uv[c]);
+  }
+  cross(u, uv, t);
+  for (int c = 0; c < 3; c++) {
+    v[c] = simd::fmadd(simd::splat(2.0f), t[c], v[c]);
+  }
+}
+
+}  // namespace
+
+bool skin_indices_valid(const uint16_t* boneIndices, size_t vertexCount, size_t boneCount) {
+  for (size_t i = 0; i < vertexCount * 4; i++) {
+    if (boneIndices[i] >= boneCount) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void skin_lbs(const SkinningInput& in, const float* boneMatrices, float* outPositions, float* outNormals) {
+  for_each_vertex_lanes(in, outPositions, outNormals, [&](size_t i, size_t n, vfloat* p, vfloat* nrm) {
+    using simd::fmadd;
+    vfloat m[12];
+    blend_matrices(in, i, n, boneMatrices, m);
+    const vfloat x = p[0], y = p[1], z = p[2];
+    for (int row = 0; row < 3; row++) {
+      p[row] = fmadd(m[row], x, fmadd(m[3 + row], y, fmadd(m[6 + row], z, m[9 + row])));
+    }
+    if (nrm != nullptr) {
+      const vfloat nx = nrm[0], ny = nrm[1], nz = nrm[2];
+      for (int row = 0; row < 3; row++) {
+        nrm[row] = fmadd(m[row], nx, fmadd(m[3 + row], ny, m[6 + row] * nz));
+      }
+      normalize(nrm);
+    }
+  });
+}
+
+void skin_dqs(const SkinningInput& in, const float* dualQuats, float* outPositions, float* outNormals) {
+  for_each_vertex_lanes(in, outPositions, outNormals, [&](size_t i, size_t n, vfloat* p, vfloat* nrm) {
+    using simd::fmadd;
+    vfloat q[8];
+    blend_dual_quats(in, i, n, dualQuats, q);
+    // Normalize by |real|; a zero blend gets inv = 0, i.e. no rotation and no
+    // translation.
+    const vfloat len2 = fmadd(q[0], q[0], fmadd(q[1], q[1], fmadd(q[2], q[2], q[3] * q[3])));
+    const vfloat inv = simd::select(len2 > simd::splat(0.0f), simd::splat(1.0f) / simd::sqrt(len2), simd::splat(0.0f));
+    for (int c = 0; c < 8; c++) {
+      q[c] *= inv;
+    }
+    const vfloat* u = q;
+    const vfloat* dv = q + 4;
+    const vfloat w = q[3], dw = q[7];
+    // t = 2 (dual * conj(real)).vec() = 2 (w dv - dw u + u x dv).
+    vfloat t[3];
+    cross(u, dv, t);
+    for (int c = 0; c < 3; c++) {
+      t[c] = simd::splat(2.0f) * fmadd(w, dv[c], fmadd(-dw, u[c], t[c]));
+    }
+    rotate(u, w, p);
+    for (int c = 0; c < 3; c++) {
+      p[c] += t[c];
+    }
+    if (nrm != nullptr) {
+      rotate(u, w, nrm);
+    }
+  });
+}
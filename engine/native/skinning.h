@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <Eigen/Geometry>
+
+#include "dual_quat.h"
+
+// Vertex skinning over the MeshDataCpp streams: bind-pose positions and normals
+// as interleaved xyz, plus up to four bone influences per vertex packed like
+// Three's skinIndex / skinWeight attributes (4 indices, 4 weights). Weights are
+// used as given (Three's normalizeSkinWeights is the caller's job); unused
+// slots carry weight 0.
+//
+// Kernels split the vertices over the parallel:: pool and run simd::kWidth
+// vertices per step, with the vertex math in lanes. skin_lbs blends per vertex
+// on whole matrix columns and transposes the result (simd::load4); skin_dqs
+// transposes each influence's dual quaternion and blends in lanes.
+// Outputs may alias the bind-pose inputs.
+
+struct SkinningInput {
+  const float* positions;       // 3 floats per vertex
+  const float* normals;         // 3 floats per vertex, or nullptr
+  const uint16_t* boneIndices;  // 4 per vertex, each < the bone count
+  const float* boneWeights;     // 4 per vertex
+  size_t vertexCount;
+};
+
+// True if every bone index is < boneCount (the kernels do not check).
+bool skin_indices_valid(const uint16_t* boneIndices, size_t vertexCount, size_t boneCount);
+
+// Linear blend skinning: each vertex goes through M = sum_k w_k * bone[i_k],
+// positions as points, normals by M's linear part and renormalized (zero stays
+// zero), the same as Three's skinning shader chunks. `boneMatrices` holds 16
+// floats per bone, column-major with the bottom row ignored -- Affine3f's
+// storage and Skeleton.boneMatrices alike. `outNormals` is ignored when
+// in.normals is null.
+void skin_lbs(const SkinningInput& in, const float* boneMatrices, float* outPositions, float* outNormals);
+
+inline void skin_lbs(const SkinningInput& in, const Eigen::Affine3f* bones, float* outPositions, float* outNormals) {
+  static_assert(sizeof(Eigen::Affine3f) == 16 * sizeof(float), "Affine3f is a bare 4x4 matrix");
+  skin_lbs(in, bones->data(), outPositions, outNormals);
+}
+
+// Dual-quaternion skinning (Kavan et al.'s DLB): the bones' dual quaternions
+// (dual_quat.h layout, 8 floats per bone, see dual_quats_from_transforms) are
+// blended with the weights, normalized, and applied as a rigid transform, so
+// twisting joints keep their volume instead of collapsing like LBS's
+// candy-wrapper. Antipodality: an influence whose rotation lies in the other
+// hemisphere from the vertex's heaviest influence is blended with a negated
+// weight. Bones must be rigid (no scale); normals are rotated only. A vertex
+// whose blend is zero (all weights 0) is left in its bind pose.
+void skin_dqs(const SkinningInput& in, const float* dualQuats, float* outPositions, float* outNormals);
+
+inline void skin_dqs(const SkinningInput& in, const DualQuaternion* bones, float* outPositions, float* outNormals) {
+  skin_dqs(in, bones->real.coeffs().data(), outPositions, outNormals);
+}
@@ -0,0 +1,150 @@
+#include "transform_hierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "parallel.h"
+
+namespace {
+
+// Nodes per pool job: a few microseconds of work, well above the cost of
+// handing out the job.
+constexpr size_t kGrain = 2048;
+
+}  // namespace
+
+TransformHierarchy::TransformHierarchy(const int32_t* parents, size_t count)
+    : parents_(parents, parents + count), depth_(count, 0), dirty_(count, 1), firstDirtyLevel_(0) {
+  for (auto& v : translation_) {
+    v.assign(count, 0.0f);
+  }
+  for (auto& v : rotation_) {
+    v.assign(count, 0.0f);
+  }
+  rotation_[3].assign(count, 1.0f);
+  for (auto& v : scale_) {
+    v.assign(count, 1.0f);
+  }
+
+  // Depths in one forward pass, then a counting sort into level order.
+  uint32_t levels = count > 0 ? 1 : 0;
+  for (size_t i = 0; i < count; i++) {
+    if (parents_[i] >= 0) {
+      depth_[i] = depth_[parents_[i]] + 1;
+      levels = std::max(levels, depth_[i] + 1);
+    }
+  }
+  levelStart_.assign(levels + 1, 0);
+  for (size_t i = 0; i < count; i++) {
+    levelStart_[depth_[i] + 1]++;
+  }
+  for (size_t d = 0; d < levels; d++) {
+    levelStart_[d + 1] += levelStart_[d];
+  }
+  slotNode_.resize(count);
+  nodeSlot_.resize(count);
+  slotParent_.resize(count);
+  std::vector<uint32_t> cursor(levelStart_.begin(), levelStart_.end() - 1);
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t slot = cursor[depth_[i]]++;
+    slotNode_[slot] = (uint32_t)i;
+    nodeSlot_[i] = slot;
+    // Parents precede their children, so the parent's slot is already known.
+    slotParent_[slot] = parents_[i] >= 0 ? (int32_t)nodeSlot_[parents_[i]] : -1;
+  }
+}
+
+bool TransformHierarchy::is_topological(const int32_t* parents, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    if (parents[i] < -1 || (parents[i] >= 0 && (size_t)parents[i] >= i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TransformHierarchy::set_local(size_t i,
+                                   const Eigen::Vector3f& t,
+                                   const Eigen::Quaternionf& q,
+                                   const Eigen::Vector3f& s) {
+  const size_t slot = nodeSlot_[i];
+  for (int k = 0; k < 3; k++) {
+    translation_[k][slot] = t[k];
+    scale_[k][slot] = s[k];
+  }
+  for (int k = 0; k < 4; k++) {
+    rotation_[k][slot] = q.coeffs()[k];
+  }
+  mark_dirty(i);
+}
+
+void TransformHierarchy::set_locals(const uint32_t* indices, const float* trs, size_t count) {
+  for (size_t k = 0; k < count; k++) {
+    const float* p = trs + k * kLocalFloats;
+    set_local(indices[k], Eigen::Vector3f(p[0], p[1], p[2]), Eigen::Quaternionf(p[6], p[3], p[4], p[5]),
+              Eigen::Vector3f(p[7], p[8], p[9]));
+  }
+}
+
+Eigen::Affine3f TransformHierarchy::local(size_t i) const { return slot_local(nodeSlot_[i]); }
+
+Eigen::Affine3f TransformHierarchy::slot_local(size_t s) const {
+  const Eigen::Quaternionf q(rotation_[3][s], rotation_[0][s], rotation_[1][s], rotation_[2][s]);
+  Eigen::Affine3f m;
+  m.linear() = q.toRotationMatrix() * Eigen::Vector3f(scale_[0][s], scale_[1][s], scale_[2][s]).asDiagonal();
+  m.translation() = Eigen::Vector3f(translation_[0][s], translation_[1][s], translation_[2][s]);
+  m.makeAffine();
+  return m;
+}
+
+void TransformHierarchy::mark_dirty(size_t i) {
+  dirty_[nodeSlot_[i]] = 1;
+  firstDirtyLevel_ = std::min<size_t>(firstDirtyLevel_, depth_[i]);
+}
+
+size_t TransformHierarchy::update_slots(size_t begin, size_t end, float* world) {
+  size_t updated = 0;
+  for (size_t s = begin; s < end; s++) {
+    const int32_t p = slotParent_[s];
+    if (!dirty_[s] && (p < 0 || !dirty_[p])) {
+      continue;
+    }
+    dirty_[s] = 1;
+    // Matrix4f keeps the product on Eigen's packet path: each result column
+    // is four vector multiply-adds of the parent's columns.
+    const Eigen::Matrix4f local = slot_local(s).matrix();
+    Eigen::Map<Eigen::Matrix4f> out(world + 16 * (size_t)slotNode_[s]);
+    if (p < 0) {
+      out = local;
+    } else {
+      out.noalias() = Eigen::Map<const Eigen::Matrix4f>(world + 16 * (size_t)slotNode_[p]) * local;
+    }
+    updated++;
+  }
+  return updated;
+}
+
+size_t TransformHierarchy::update(float* world, bool parallel) {
+  const size_t levels = level_count();
+  if (firstDirtyLevel_ >= levels) {
+    return 0;
+  }
+
+  size_t updated = 0;
+  for (size_t d = firstDirtyLevel_; d < levels; d++) {
+    const size_t begin = levelStart_[d], end = levelStart_[d + 1];
+    if (!parallel || end - begin <= kGrain) {
+      updated += update_slots(begin, end, world);
+      continue;
+    }
+    std::atomic<size_t> levelUpdated{0};
+    parallel::parallel_for(end - begin, kGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+      levelUpdated.fetch_add(update_slots(begin + chunkBegin, begin + chunkEnd, world), std::memory_order_relaxed);
+    });
+    updated += levelUpdated.load(std::memory_order_relaxed);
+  }
+
+  std::fill(dirty_.begin() + levelStart_[firstDirtyLevel_], dirty_.end(), 0);
+  firstDirtyLevel_ = levels;
+  return updated;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+// Scene-graph world transforms for a flat node array in topological order:
+// every node's parent comes before it (parents[i] < i, -1 for a root).
+//
+// Local transforms are stored SoA as the three Eigen factors the editor edits
+// -- Translation3f, Quaternionf, AlignedScaling3f -- and composed like
+// Affine3f(Translation3f(t) * q * Scaling(s)). Setting a local transform only
+// marks the node dirty; update() then recomputes the dirty nodes and their
+// descendants and leaves every other world matrix untouched.
+//
+// Nodes are bucketed by depth at construction, and the local TRS arrays and
+// dirty flags are stored in that level order ("slots"), so one level is a
+// contiguous range. update() walks the levels from the shallowest dirty one
+// down. The nodes of one level are independent: each is composed as a 4x4
+// Matrix4f product on Eigen's SIMD packet path, and in parallel mode the level
+// is split into chunks over the parallel:: pool with a barrier between levels.
+// Both modes run the same per-node code and give identical results.
+//
+// World matrices live in caller storage, 16 floats per node, column-major like
+// Three's Matrix4.elements: the JS bindings hand the same Float32Array to
+// update() every frame and to the renderer, so nothing is copied. update()
+// reads the parents' previous results from it, so it must keep holding them.
+class TransformHierarchy {
+ public:
+  // Floats per node in the set_locals() layout: t xyz, q xyzw, s xyz.
+  static constexpr size_t kLocalFloats = 10;
+
+  TransformHierarchy() = default;
+  // `parents` must pass is_topological(). Every node starts at the identity
+  // and dirty, so the first update() fills the whole world array.
+  TransformHierarchy(const int32_t* parents, size_t count);
+
+  // parents[i] is -1 or in [0, i) for every node.
+  static bool is_topological(const int32_t* parents, size_t count);
+
+  size_t size() const { return parents_.size(); }
+  int32_t parent(size_t i) const { return parents_[i]; }
+
+  // q is assumed to be unit length.
+  void set_local(size_t i, const Eigen::Vector3f& t, const Eigen::Quaternionf& q, const Eigen::Vector3f& s);
+  // Node indices[k] gets trs[k * kLocalFloats ...]; indices must be < size().
+  void set_locals(const uint32_t* indices, const float* trs, size_t count);
+  Eigen::Affine3f local(size_t i) const;
+
+  // Marks a node for recomputation without changing its local transform, e.g.
+  // after the caller overwrote its world matrix.
+  void mark_dirty(size_t i);
+  bool dirty() const { return firstDirtyLevel_ < level_count(); }
+
+  // Number of depth levels (roots are level 0).
+  size_t level_count() const { return levelStart_.empty() ? 0 : levelStart_.size() - 1; }
+
+  // Brings world[16 * i ...] up to date for every dirty node and its
+  // descendants; returns the number of matrices recomputed. `parallel`
+  // spreads each level over the worker pool; levels smaller than one chunk
+  // (kGrain nodes in the .cpp) stay on the calling thread.
+  size_t update(float* world, bool parallel = false);
+
+ private:
+  // Recomputes the slots in [begin, end) (within one level) that are dirty or
+  // have a recomputed parent, and flags them for their children.
+  size_t update_slots(size_t begin, size_t end, float* world);
+  Eigen::Affine3f slot_local(size_t slot) const;
+
+  std::vector<int32_t> parents_;
+  // Slots: nodes grouped by depth, ascending node index within a level; level
+  // d is slots [levelStart_[d], levelStart_[d + 1]).
+  std::vector<uint32_t> levelStart_;
+  std::vector<uint32_t> slotNode_;   // slot -> node
+  std::vector<uint32_t> nodeSlot_;   // node -> slot
+  std::vector<int32_t> slotParent_;  // slot -> parent's slot, -1 for roots
+  std::vector<uint32_t> depth_;      // node -> depth
+  // Local TRS by slot, as component arrays (translation x/y/z, rotation
+  // x/y/z/w, scale x/y/z).
+  std::vector<float> translation_[3];
+  std::vector<float> rotation_[4];
+  std::vector<float> scale_[3];
+  // By slot: set_local() since the last update(); during update(), also
+  // "world matrix recomputed" so the flag reaches the children.
+  std::vector<uint8_t> dirty_;
+  size_t firstDirtyLevel_ = 0;
+};
@@ -0,0 +1,981 @@
+#include "triangulate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// earcut (port of mapbox/earcut, which is also what Three's ShapeUtils uses)
+// ---------------------------------------------------------------------------
+
+struct Node {
+  uint32_t i;  // point index
+  double x;
+  double y;
+  Node* prev = nullptr;
+  Node* next = nullptr;
+  int32_t z = 0;  // z-order curve value
+  Node* prevZ = nullptr;
+  Node* nextZ = nullptr;
+  bool steiner = false;
+};
+
+class Earcut {
+ public:
+  Earcut(const float* xy, size_t pointCount, const uint32_t* holeStarts, size_t holeCount)
+      : xy_(xy), pointCount_(pointCount), holeStarts_(holeStarts), holeCount_(holeCount) {}
+
+  std::vector<uint32_t> run() {
+    const size_t outerEnd = holeCount_ > 0 ? holeStarts_[0] : pointCount_;
+    Node* outerNode = linked_list(0, outerEnd, true);
+    if (outerNode == nullptr || outerNode->next == outerNode->prev) {
+      return std::move(triangles_);
+    }
+
+    if (holeCount_ > 0) {
+      outerNode = eliminate_holes(outerNode);
+    }
+
+    // If the shape is not too simple, hash ear tests through a z-order curve.
+    if (pointCount_ > 80) {
+      minX_ = maxX_ = xy_[0];
+      minY_ = maxY_ = xy_[1];
+      for (size_t i = 1; i < outerEnd; i++) {
+        const double x = xy_[i * 2];
+        const double y = xy_[i * 2 + 1];
+        minX_ = std::min(minX_, x);
+        minY_ = std::min(minY_, y);
+        maxX_ = std::max(maxX_, x);
+        maxY_ = std::max(maxY_, y);
+      }
+      // minX, minY and invSize map coords into a 15-bit integer grid for zOrder.
+      invSize_ = std::max(maxX_ - minX_, maxY_ - minY_);
+      invSize_ = invSize_ != 0.0 ? 32767.0 / invSize_ : 0.0;
+    }
+
+    triangles_.reserve((pointCount_ + 2 * holeCount_) * 3);
+    earcut_linked(outerNode, 0);
+    return std::move(triangles_);
+  }
+
+ private:
+  Node* linked_list(size_t start, size_t end, bool clockwise) {
+    Node* last = nullptr;
+    if (clockwise == (signed_area(start, end) > 0)) {
+      for (size_t i = start; i < end; i++) {
+        last = insert_node((uint32_t)i, xy_[i * 2], xy_[i * 2 + 1], last);
+      }
+    } else {
+      for (size_t i = end; i-- > start;) {
+        last = insert_node((uint32_t)i, xy_[i * 2], xy_[i * 2 + 1], last);
+      }
+    }
+    if (last != nullptr && equals(last, last->next)) {
+      remove_node(last);
+      last = last->next;
+    }
+    return last;
+  }
+
+  // Eliminate colinear or duplicate points.
+  Node* filter_points(Node* start, Node* end = nullptr) {
+    if (start == nullptr) return start;
+    if (end == nullptr) end = start;
+
+    Node* p = start;
+    bool again;
+    do {
+      again = false;
+      if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0)) {
+        remove_node(p);
+        p = end = p->prev;
+        if (p == p->next) break;
+        again = true;
+      } else {
+        p = p->next;
+      }
+    } while (again || p != end);
+
+    return end;
+  }
+
+  void earcut_linked(Node* ear, int pass) {
+    if (ear == nullptr) return;
+
+    // Interlink polygon nodes in z-order.
+    if (pass == 0 && invSize_ != 0.0) index_curve(ear);
+
+    Node* stop = ear;
+    while (ear->prev != ear->next) {
+      Node* prev = ear->prev;
+      Node* next = ear->next;
+
+      if (invSize_ != 0.0 ? is_ear_hashed(ear) : is_ear(ear)) {
+        triangles_.push_back(prev->i);
+        triangles_.push_back(ear->i);
+        triangles_.push_back(next->i);
+
+        remove_node(ear);
+
+        // Skipping the next vertex leads to less sliver triangles.
+        ear = next->next;
+        stop = next->next;
+        continue;
+      }
+
+      ear = next;
+
+      // Went through the whole polygon without finding an ear.
+      if (ear == stop) {
+        if (pass == 0) {
+          // Try filtering points and slicing again.
+          earcut_linked(filter_points(ear), 1);
+        } else if (pass == 1) {
+          // Both "split" and "cure" below the recursion: cure local self-intersections first.
+          ear = cure_local_intersections(filter_points(ear));
+          earcut_linked(ear, 2);
+        } else if (pass == 2) {
+          // As a last resort, try splitting the remaining polygon into two.
+          split_earcut(ear);
+        }
+        break;
+      }
+    }
+  }
+
+  // Whether a polygon node forms a valid ear with adjacent nodes.
+  bool is_ear(Node* ear) const {
+    const Node* a = ear->prev;
+    const Node* b = ear;
+    const Node* c = ear->next;
+    if (area(a, b, c) >= 0) return false;  // reflex, can't be an ear
+
+    const double x0 = std::min(a->x, std::min(b->x, c->x));
+    const double y0 = std::min(a->y, std::min(b->y, c->y));
+    const double x1 = std::max(a->x, std::max(b->x, c->x));
+    const double y1 = std::max(a->y, std::max(b->y, c->y));
+
+    // Now make sure we don't have other points inside the potential ear.
+    for (const Node* p = c->next; p != a; p = p->next) {
+      if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+          point_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+          area(p->prev, p, p->next) >= 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool blocks_ear(const Node* p, const Node* a, const Node* b, const Node* c,
+                  double x0, double y0, double x1, double y1) const {
+    return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c &&
+           point_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+           area(p->prev, p, p->next) >= 0;
+  }
+
+  // Same as is_ear, but only visits nodes whose z-order value lies within the
+  // ear's bounding box range.
+  bool is_ear_hashed(Node* ear) const {
+    const Node* a = ear->prev;
+    const Node* b = ear;
+    const Node* c = ear->next;
+    if (area(a, b, c) >= 0) return false;
+
+    const double x0 = std::min(a->x, std::min(b->x, c->x));
+    const double y0 = std::min(a->y, std::min(b->y, c->y));
+    const double x1 = std::max(a->x, std::max(b->x, c->x));
+    const double y1 = std::max(a->y, std::max(b->y, c->y));
+
+    const int32_t minZ = z_order(x0, y0);
+    const int32_t maxZ = z_order(x1, y1);
+
+    const Node* p = ear->prevZ;
+    const Node* n = ear->nextZ;
+
+    // Look for points inside the triangle in both directions.
+    while (p != nullptr && p->z >= minZ && n != nullptr && n->z <= maxZ) {
+      if (blocks_ear(p, a, b, c, x0, y0, x1, y1)) return false;
+      p = p->prevZ;
+      if (blocks_ear(n, a, b, c, x0, y0, x1, y1)) return false;
+      n = n->nextZ;
+    }
+
+    // Look for remaining points in decreasing z-order.
+    while (p != nullptr && p->z >= minZ) {
+      if (blocks_ear(p, a, b, c, x0, y0, x1, y1)) return false;
+      p = p->prevZ;
+    }
+
+    // Look for remaining points in increasing z-order.
+    while (n != nullptr && n->z <= maxZ) {
+      if (blocks_ear(n, a, b, c, x0, y0, x1, y1)) return false;
+      n = n->nextZ;
+    }
+
+    return true;
+  }
+
+  // Go through all polygon nodes and cure small local self-intersections.
+  Node* cure_local_intersections(Node* start) {
+    Node* p = start;
+    do {
+      Node* a = p->prev;
+      Node* b = p->next->next;
+
+      if (!equals(a, b) && intersects(a, p, p->next, b) && locally_inside(a, b) && locally_inside(b, a)) {
+        triangles_.push_back(a->i);
+        triangles_.push_back(p->i);
+        triangles_.push_back(b->i);
+
+        // Remove two nodes involved.
+        remove_node(p);
+        remove_node(p->next);
+
+        p = start = b;
+      }
+      p = p->next;
+    } while (p != start);
+
+    return filter_points(p);
+  }
+
+  // Try splitting the polygon into two and triangulate them independently.
+  void split_earcut(Node* start) {
+    Node* a = start;
+    do {
+      Node* b = a->next->next;
+      while (b != a->prev) {
+        if (a->i != b->i && is_valid_diagonal(a, b)) {
+          Node* c = split_polygon(a, b);
+
+          a = filter_points(a, a->next);
+          c = filter_points(c, c->next);
+
+          earcut_linked(a, 0);
+          earcut_linked(c, 0);
+          return;
+        }
+        b = b->next;
+      }
+      a = a->next;
+    } while (a != start);
+  }
+
+  // Link every hole into the outer loop, producing a single-ring polygon without holes.
+  Node* eliminate_holes(Node* outerNode) {
+    std::vector<Node*> queue;
+    queue.reserve(holeCount_);
+    for (size_t h = 0; h < holeCount_; h++) {
+      const size_t start = holeStarts_[h];
+      const size_t end = h + 1 < holeCount_ ? holeStarts_[h + 1] : pointCount_;
+      Node* list = linked_list(start, end, false);
+      if (list == nullptr) continue;
+      if (list == list->next) list->steiner = true;
+      queue.push_back(get_leftmost(list));
+    }
+
+    std::stable_sort(queue.begin(), queue.end(), [](const Node* a, const Node* b) { return a->x < b->x; });
+
+    // Process holes from left to right.
+    for (Node* hole : queue) {
+      outerNode = eliminate_hole(hole, outerNode);
+    }
+    return outerNode;
+  }
+
+  Node* eliminate_hole(Node* hole, Node* outerNode) {
+    Node* bridge = find_hole_bridge(hole, outerNode);
+    if (bridge == nullptr) {
+      return outerNode;
+    }
+
+    Node* bridgeReverse = split_polygon(bridge, hole);
+
+    // Filter collinear points around the cuts.
+    filter_points(bridgeReverse, bridgeReverse->next);
+    return filter_points(bridge, bridge->next);
+  }
+
+  // David Eberly's algorithm for finding a bridge between a hole and the outer polygon.
+  Node* find_hole_bridge(Node* hole, Node* outerNode) const {
+    Node* p = outerNode;
+    const double hx = hole->x;
+    const double hy = hole->y;
+    double qx = -std::numeric_limits<double>::infinity();
+    Node* m = nullptr;
+
+    // Find a segment intersected by a ray from the hole's leftmost point to the left;
+    // segment's endpoint with lesser x will be potential connection point.
+    do {
+      if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+        const double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+        if (x <= hx && x > qx) {
+          qx = x;
+          m = p->x < p->next->x ? p : p->next;
+          if (x == hx) return m;  // hole touches outer segment; pick leftmost endpoint
+        }
+      }
+      p = p->next;
+    } while (p != outerNode);
+
+    if (m == nullptr) return nullptr;
+
+    // Look for points inside the triangle of hole point, segment intersection and
+    // endpoint; if there are none, m is the bridge. Otherwise pick the point with
+    // the minimum angle to the ray.
+    const Node* stop = m;
+    const double mx = m->x;
+    const double my = m->y;
+    double tanMin = std::numeric_limits<double>::infinity();
+
+    p = m;
+    do {
+      if (hx >= p->x && p->x >= mx && hx != p->x &&
+          point_in_triangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+        const double tan = std::fabs(hy - p->y) / (hx - p->x);  // tangential
+        if (locally_inside(p, hole) &&
+            (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && sector_contains_sector(m, p)))))) {
+          m = p;
+          tanMin = tan;
+        }
+      }
+      p = p->next;
+    } while (p != stop);
+
+    return m;
+  }
+
+  // Whether sector in vertex m contains sector in vertex p in the same coordinates.
+  static bool sector_contains_sector(const Node* m, const Node* p) {
+    return area(m->prev, m, p->prev) < 0 && area(p->next, m, m->next) < 0;
+  }
+
+  void index_curve(Node* start) const {
+    Node* p = start;
+    do {
+      if (p->z == 0) p->z = z_order(p->x, p->y);
+      p->prevZ = p->prev;
+      p->nextZ = p->next;
+      p = p->next;
+    } while (p != start);
+
+    p->prevZ->nextZ = nullptr;
+    p->prevZ = nullptr;
+
+    sort_linked(p);
+  }
+
+  // Simon Tatham's linked list merge sort on the z links.
+  static Node* sort_linked(Node* list) {
+    size_t inSize = 1;
+    size_t numMerges;
+    do {
+      Node* p = list;
+      list = nullptr;
+      Node* tail = nullptr;
+      numMerges = 0;
+
+      while (p != nullptr) {
+        numMerges++;
+        Node* q = p;
+        size_t pSize = 0;
+        for (size_t i = 0; i < inSize; i++) {
+          pSize++;
+          q = q->nextZ;
+          if (q == nullptr) break;
+        }
+        size_t qSize = inSize;
+
+        while (pSize > 0 || (qSize > 0 && q != nullptr)) {
+          Node* e;
+          if (pSize != 0 && (qSize == 0 || q == nullptr || p->z <= q->z)) {
+            e = p;
+            p = p->nextZ;
+            pSize--;
+          } else {
+            e = q;
+            q = q->nextZ;
+            qSize--;
+          }
+
+          if (tail != nullptr) {
+            tail->nextZ = e;
+          } else {
+            list = e;
+          }
+          e->prevZ = tail;
+          tail = e;
+        }
+        p = q;
+      }
+
+      tail->nextZ = nullptr;
+      inSize *= 2;
+    } while (numMerges > 1);
+
+    return list;
+  }
+
+  // z-order of a point given coords and inverse of the longer side of data bbox.
+  int32_t z_order(double px, double py) const {
+    int32_t x = (int32_t)((px - minX_) * invSize_);
+    int32_t y = (int32_t)((py - minY_) * invSize_);
+
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+
+    y = (y | (y << 8)) & 0x00FF00FF;
+    y = (y | (y << 4)) & 0x0F0F0F0F;
+    y = (y | (y << 2)) & 0x33333333;
+    y = (y | (y << 1)) & 0x55555555;
+
+    return x | (y << 1);
+  }
+
+  static Node* get_leftmost(Node* start) {
+    Node* p = start;
+    Node* leftmost = start;
+    do {
+      if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y)) leftmost = p;
+      p = p->next;
+    } while (p != start);
+    return leftmost;
+  }
+
+  static bool point_in_triangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py) {
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+           (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+           (bx - px) * (cy - py) >= (cx - px) * (by - py);
+  }
+
+  // Whether a diagonal between two polygon nodes lies within the polygon interior.
+  static bool is_valid_diagonal(const Node* a, const Node* b) {
+    return a->next->i != b->i && a->prev->i != b->i && !intersects_polygon(a, b) &&  // doesn't intersect other edges
+           ((locally_inside(a, b) && locally_inside(b, a) && middle_inside(a, b) &&  // locally visible
+             (area(a->prev, a, b->prev) != 0 || area(a, b->prev, b) != 0)) ||       // no opposite-facing sectors
+            (equals(a, b) && area(a->prev, a, a->next) > 0 && area(b->prev, b, b->next) > 0));  // zero-length case
+  }
+
+  // Signed area of a triangle.
+  static double area(const Node* p, const Node* q, const Node* r) {
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+  }
+
+  static bool equals(const Node* p1, const Node* p2) { return p1->x == p2->x && p1->y == p2->y; }
+
+  static int sign(double v) { return v > 0 ? 1 : v < 0 ? -1 : 0; }
+
+  // For collinear points p, q, r, check if point q lies on segment pr.
+  static bool on_segment(const Node* p, const Node* q, const Node* r) {
+    return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) && q->y <= std::max(p->y, r->y) &&
+           q->y >= std::min(p->y, r->y);
+  }
+
+  static bool intersects(const Node* p1, const Node* q1, const Node* p2, const Node* q2) {
+    const int o1 = sign(area(p1, q1, p2));
+    const int o2 = sign(area(p1, q1, q2));
+    const int o3 = sign(area(p2, q2, p1));
+    const int o4 = sign(area(p2, q2, q1));
+
+    if (o1 != o2 && o3 != o4) return true;  // general case
+
+    if (o1 == 0 && on_segment(p1, p2, q1)) return true;  // p1, q1 and p2 are collinear and p2 lies on p1q1
+    if (o2 == 0 && on_segment(p1, q2, q1)) return true;  // p1, q1 and q2 are collinear and q2 lies on p1q1
+    if (o3 == 0 && on_segment(p2, p1, q2)) return true;  // p2, q2 and p1 are collinear and p1 lies on p2q2
+    if (o4 == 0 && on_segment(p2, q1, q2)) return true;  // p2, q2 and q1 are collinear and q1 lies on p2q2
+
+    return false;
+  }
+
+  // Whether a polygon diagonal intersects any polygon segments.
+  static bool intersects_polygon(const Node* a, const Node* b) {
+    const Node* p = a;
+    do {
+      if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && intersects(p, p->next, a, b)) {
+        return true;
+      }
+      p = p->next;
+    } while (p != a);
+    return false;
+  }
+
+  // Whether a polygon diagonal is locally inside the polygon.
+  static bool locally_inside(const Node* a, const Node* b) {
+    return area(a->prev, a, a->next) < 0 ? area(a, b, a->next) >= 0 && area(a, a->prev, b) >= 0
+                                         : area(a, b, a->prev) < 0 || area(a, a->next, b) < 0;
+  }
+
+  // Whether the middle point of a polygon diagonal is inside the polygon.
+  static bool middle_inside(const Node* a, const Node* b) {
+    const Node* p = a;
+    bool inside = false;
+    const double px = (a->x + b->x) / 2;
+    const double py = (a->y + b->y) / 2;
+    do {
+      if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y &&
+          (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)) {
+        inside = !inside;
+      }
+      p = p->next;
+    } while (p != a);
+    return inside;
+  }
+
+  // Link two polygon vertices with a bridge; if the vertices belong to the same
+  // ring, it splits polygon into two; if one belongs to the outer ring and
+  // another to a hole, it merges it into a single ring.
+  Node* split_polygon(Node* a, Node* b) {
+    Node* a2 = new_node(a->i, a->x, a->y);
+    Node* b2 = new_node(b->i, b->x, b->y);
+    Node* an = a->next;
+    Node* bp = b->prev;
+
+    a->next = b;
+    b->prev = a;
+
+    a2->next = an;
+    an->prev = a2;
+
+    b2->next = a2;
+    a2->prev = b2;
+
+    bp->next = b2;
+    b2->prev = bp;
+
+    return b2;
+  }
+
+  Node* new_node(uint32_t i, double x, double y) {
+    nodes_.push_back(Node{i, x, y});
+    return &nodes_.back();
+  }
+
+  // Create a node and optionally link it with the previous one (in a circular doubly linked list).
+  Node* insert_node(uint32_t i, double x, double y, Node* last) {
+    Node* p = new_node(i, x, y);
+    if (last == nullptr) {
+      p->prev = p;
+      p->next = p;
+    } else {
+      p->next = last->next;
+      p->prev = last;
+      last->next->prev = p;
+      last->next = p;
+    }
+    return p;
+  }
+
+  static void remove_node(Node* p) {
+    p->next->prev = p->prev;
+    p->prev->next = p->next;
+
+    if (p->prevZ != nullptr) p->prevZ->nextZ = p->nextZ;
+    if (p->nextZ != nullptr) p->nextZ->prevZ = p->prevZ;
+  }
+
+  double signed_area(size_t start, size_t end) const {
+    double sum = 0;
+    for (size_t i = start, j = end - 1; i < end; j = i++) {
+      sum += ((double)xy_[j * 2] - xy_[i * 2]) * ((double)xy_[i * 2 + 1] + xy_[j * 2 + 1]);
+    }
+    return sum;
+  }
+
+  const float* xy_;
+  size_t pointCount_;
+  const uint32_t* holeStarts_;
+  size_t holeCount_;
+
+  double minX_ = 0, minY_ = 0, maxX_ = 0, maxY_ = 0, invSize_ = 0;
+
+  std::deque<Node> nodes_;  // stable addresses while nodes are appended
+  std::vector<uint32_t> triangles_;
+};
+
+// ---------------------------------------------------------------------------
+// Shape preparation shared by make_shape / make_extrude
+// ---------------------------------------------------------------------------
+
+struct Vec2 {
+  double x;
+  double y;
+};
+
+// Contour + holes with closing duplicates removed and Three's winding applied:
+// outer ring clockwise (negative ShapeUtils.area), holes counter-clockwise.
+struct PreparedShape {
+  std::vector<Vec2> contour;
+  std::vector<std::vector<Vec2>> holes;
+
+  std::vector<float> flat;             // contour then holes, xy
+  std::vector<uint32_t> holeStarts;    // into `flat`, in points
+  std::vector<uint32_t> faces;         // earcut output over `flat`
+};
+
+double shape_area(const std::vector<Vec2>& ring) {
+  double a = 0.0;
+  for (size_t p = ring.size() - 1, q = 0; q < ring.size(); p = q++) {
+    a += ring[p].x * ring[q].y - ring[q].x * ring[p].y;
+  }
+  return a * 0.5;
+}
+
+std::vector<Vec2> read_ring(const float* xy, size_t start, size_t end) {
+  std::vector<Vec2> ring;
+  ring.reserve(end - start);
+  for (size_t i = start; i < end; i++) {
+    ring.push_back(Vec2{xy[i * 2], xy[i * 2 + 1]});
+  }
+  if (ring.size() > 2 && ring.front().x == ring.back().x && ring.front().y == ring.back().y) {
+    ring.pop_back();
+  }
+  return ring;
+}
+
+void append_flat(std::vector<float>& flat, const std::vector<Vec2>& ring) {
+  for (const Vec2& p : ring) {
+    flat.push_back((float)p.x);
+    flat.push_back((float)p.y);
+  }
+}
+
+PreparedShape prepare_shape(const float* xy, size_t pointCount, const uint32_t* holeStarts, size_t holeCount) {
+  PreparedShape s;
+  const size_t outerEnd = holeCount > 0 ? std::min<size_t>(holeStarts[0], pointCount) : pointCount;
+  s.contour = read_ring(xy, 0, outerEnd);
+  if (s.contour.size() < 3) {
+    s.contour.clear();
+    return s;
+  }
+  if (!(shape_area(s.contour) < 0)) {
+    std::reverse(s.contour.begin(), s.contour.end());
+  }
+
+  for (size_t h = 0; h < holeCount; h++) {
+    const size_t start = std::min<size_t>(holeStarts[h], pointCount);
+    const size_t end = h + 1 < holeCount ? std::min<size_t>(holeStarts[h + 1], pointCount) : pointCount;
+    if (end <= start) continue;
+    std::vector<Vec2> hole = read_ring(xy, start, end);
+    if (shape_area(hole) < 0) {
+      std::reverse(hole.begin(), hole.end());
+    }
+    s.holes.push_back(std::move(hole));
+  }
+
+  append_flat(s.flat, s.contour);
+  for (const std::vector<Vec2>& hole : s.holes) {
+    s.holeStarts.push_back((uint32_t)(s.flat.size() / 2));
+    append_flat(s.flat, hole);
+  }
+
+  s.faces = triangulate_polygon(s.flat.data(), s.flat.size() / 2, s.holeStarts.data(), s.holeStarts.size());
+  return s;
+}
+
+int sign_of(double v) {
+  return v > 0 ? 1 : v < 0 ? -1 : 0;
+}
+
+// Direction (scaled so that a unit shrink moves the edges by one unit) in which a
+// contour point moves when the bevel contracts/expands the shape.
+Vec2 bevel_vec(const Vec2& inPt, const Vec2& inPrev, const Vec2& inNext) {
+  const double eps = std::numeric_limits<double>::epsilon();
+  double v_trans_x, v_trans_y, shrink_by;
+
+  // good reading for geometry algorithms (here: line-line intersection)
+  // http://geomalgorithms.com/a05-_intersect-1.html
+  const double v_prev_x = inPt.x - inPrev.x;
+  const double v_prev_y = inPt.y - inPrev.y;
+  const double v_next_x = inNext.x - inPt.x;
+  const double v_next_y = inNext.y - inPt.y;
+
+  const double v_prev_lensq = v_prev_x * v_prev_x + v_prev_y * v_prev_y;
+
+  // check for collinear edges
+  const double collinear0 = v_prev_x * v_next_y - v_prev_y * v_next_x;
+
+  if (std::fabs(collinear0) > eps) {
+    // not collinear: length of vectors for normalizing
+    const double v_prev_len = std::sqrt(v_prev_lensq);
+    const double v_next_len = std::sqrt(v_next_x * v_next_x + v_next_y * v_next_y);
+
+    // shift adjacent points by unit vectors to the left
+    const double ptPrevShift_x = inPrev.x - v_prev_y / v_prev_len;
+    const double ptPrevShift_y = inPrev.y + v_prev_x / v_prev_len;
+    const double ptNextShift_x = inNext.x - v_next_y / v_next_len;
+    const double ptNextShift_y = inNext.y + v_next_x / v_next_len;
+
+    // scaling factor for v_prev to intersection point
+    const double sf = ((ptNextShift_x - ptPrevShift_x) * v_next_y - (ptNextShift_y - ptPrevShift_y) * v_next_x) /
+                      (v_prev_x * v_next_y - v_prev_y * v_next_x);
+
+    // vector from inPt to intersection point
+    v_trans_x = ptPrevShift_x + v_prev_x * sf - inPt.x;
+    v_trans_y = ptPrevShift_y + v_prev_y * sf - inPt.y;
+
+    // Don't normalize!, otherwise sharp corners become ugly
+    // but prevent crazy spikes
+    const double v_trans_lensq = v_trans_x * v_trans_x + v_trans_y * v_trans_y;
+    if (v_trans_lensq <= 2) {
+      return Vec2{v_trans_x, v_trans_y};
+    }
+    shrink_by = std::sqrt(v_trans_lensq / 2);
+  } else {
+    // handle special case of collinear edges
+    bool direction_eq = false;  // assumes: opposite
+    if (v_prev_x > eps) {
+      if (v_next_x > eps) direction_eq = true;
+    } else {
+      if (v_prev_x < -eps) {
+        if (v_next_x < -eps) direction_eq = true;
+      } else {
+        if (sign_of(v_prev_y) == sign_of(v_next_y)) direction_eq = true;
+      }
+    }
+
+    if (direction_eq) {
+      v_trans_x = -v_prev_y;
+      v_trans_y = v_prev_x;
+      shrink_by = std::sqrt(v_prev_lensq);
+    } else {
+      v_trans_x = v_prev_x;
+      v_trans_y = v_prev_y;
+      shrink_by = std::sqrt(v_prev_lensq / 2);
+    }
+  }
+
+  return Vec2{v_trans_x / shrink_by, v_trans_y / shrink_by};
+}
+
+std::vector<Vec2> ring_movements(const std::vector<Vec2>& ring) {
+  const size_t n = ring.size();
+  std::vector<Vec2> out(n);
+  for (size_t i = 0; i < n; i++) {
+    const size_t j = (i + n - 1) % n;
+    const size_t k = (i + 1) % n;
+    out[i] = bevel_vec(ring[i], ring[j], ring[k]);
+  }
+  return out;
+}
+
+}  // namespace
+
+std::vector<uint32_t> triangulate_polygon(
+    const float* xy,
+    size_t pointCount,
+    const uint32_t* holeStarts,
+    size_t holeCount) {
+  if (pointCount < 3) {
+    return {};
+  }
+  for (size_t h = 0; h < holeCount; h++) {
+    if (holeStarts[h] > pointCount || (h > 0 && holeStarts[h] < holeStarts[h - 1])) {
+      return {};
+    }
+  }
+  return Earcut(xy, pointCount, holeStarts, holeCount).run();
+}
+
+MeshDataCpp make_shape(const float* xy, size_t pointCount, const uint32_t* holeStarts, size_t holeCount) {
+  MeshDataCpp out;
+  const PreparedShape s = prepare_shape(xy, pointCount, holeStarts, holeCount);
+  const size_t vertexCount = s.flat.size() / 2;
+
+  out.vertices.resize(vertexCount * 3);
+  out.normals.resize(vertexCount * 3);
+  out.uvs = s.flat;
+  for (size_t i = 0; i < vertexCount; i++) {
+    out.vertices[i * 3 + 0] = s.flat[i * 2 + 0];
+    out.vertices[i * 3 + 1] = s.flat[i * 2 + 1];
+    out.vertices[i * 3 + 2] = 0.0f;
+    out.normals[i * 3 + 0] = 0.0f;
+    out.normals[i * 3 + 1] = 0.0f;
+    out.normals[i * 3 + 2] = 1.0f;
+  }
+  out.indices = s.faces;
+  return out;
+}
+
+MeshDataCpp make_extrude(
+    const float* xy,
+    size_t pointCount,
+    const uint32_t* holeStarts,
+    size_t holeCount,
+    const ExtrudeOptions& options) {
+  MeshDataCpp out;
+  if (options.steps > kMaxExtrudeSegments || options.bevelSegments > kMaxExtrudeSegments) {
+    return out;
+  }
+  const PreparedShape s = prepare_shape(xy, pointCount, holeStarts, holeCount);
+  if (s.faces.empty()) {
+    return out;
+  }
+
+  const double pi = 3.14159265358979323846;
+  const uint32_t steps = std::max<uint32_t>(options.steps, 1);
+  const double depth = options.depth;
+  const bool bevelEnabled = options.bevelEnabled;
+  const uint32_t bevelSegments = bevelEnabled ? options.bevelSegments : 0;
+  const double bevelThickness = bevelEnabled ? options.bevelThickness : 0.0;
+  const double bevelSize = bevelEnabled ? options.bevelSize : 0.0;
+  const double bevelOffset = bevelEnabled ? options.bevelOffset : 0.0;
+
+  const std::vector<Vec2>& contour = s.contour;
+  const size_t vlen = s.flat.size() / 2;
+  const size_t flen = s.faces.size() / 3;
+
+  const std::vector<Vec2> contourMovements = ring_movements(contour);
+  std::vector<std::vector<Vec2>> holesMovements;
+  std::vector<Vec2> verticesMovements = contourMovements;
+  for (const std::vector<Vec2>& hole : s.holes) {
+    holesMovements.push_back(ring_movements(hole));
+    verticesMovements.insert(verticesMovements.end(), holesMovements.back().begin(), holesMovements.back().end());
+  }
+
+  // Layered vertex placeholder: (steps + 1 + 2 * bevelSegments) layers of vlen points.
+  const size_t layers = steps + 1 + 2 * (size_t)bevelSegments;
+  std::vector<float> placeholder;
+  placeholder.reserve(layers * vlen * 3);
+  auto v = [&](double x, double y, double z) {
+    placeholder.push_back((float)x);
+    placeholder.push_back((float)y);
+    placeholder.push_back((float)z);
+  };
+  auto bevel_ring = [&](double bs, double z) {
+    for (size_t i = 0; i < contour.size(); i++) {
+      v(contour[i].x + contourMovements[i].x * bs, contour[i].y + contourMovements[i].y * bs, z);
+    }
+    for (size_t h = 0; h < s.holes.size(); h++) {
+      const std::vector<Vec2>& hole = s.holes[h];
+      for (size_t i = 0; i < hole.size(); i++) {
+        v(hole[i].x + holesMovements[h][i].x * bs, hole[i].y + holesMovements[h][i].y * bs, z);
+      }
+    }
+  };
+
+  // Back bevel: contract the shape, expand the holes.
+  for (uint32_t b = 0; b < bevelSegments; b++) {
+    const double t = (double)b / bevelSegments;
+    const double z = bevelThickness * std::cos(t * pi / 2);
+    const double bs = std::sin(t * pi / 2) * bevelSize + bevelOffset;
+    bevel_ring(bs, -z);
+  }
+
+  // Back facing vertices, then the stepped layers up to the front.
+  const double bs = bevelSize + bevelOffset;
+  for (uint32_t st = 0; st <= steps; st++) {
+    const double z = depth / steps * st;
+    for (size_t i = 0; i < vlen; i++) {
+      double x = s.flat[i * 2];
+      double y = s.flat[i * 2 + 1];
+      if (bevelEnabled) {
+        x += verticesMovements[i].x * bs;
+        y += verticesMovements[i].y * bs;
+      }
+      v(x, y, z);
+    }
+  }
+
+  // Front bevel.
+  for (uint32_t b = bevelSegments; b-- > 0;) {
+    const double t = (double)b / bevelSegments;
+    const double z = bevelThickness * std::cos(t * pi / 2);
+    const double bsb = std::sin(t * pi / 2) * bevelSize + bevelOffset;
+    bevel_ring(bsb, depth + z);
+  }
+
+  // Expand the layered points into the non-indexed triangle list.
+  size_t sideQuads = 0;
+  sideQuads += contour.size();
+  for (const std::vector<Vec2>& hole : s.holes) sideQuads += hole.size();
+  sideQuads *= steps + 2 * (size_t)bevelSegments;
+  const size_t totalVertices = flen * 6 + sideQuads * 6;
+  out.vertices.reserve(totalVertices * 3);
+  out.uvs.reserve(totalVertices * 2);
+
+  auto add_vertex = [&](size_t index) {
+    out.vertices.push_back(placeholder[index * 3 + 0]);
+    out.vertices.push_back(placeholder[index * 3 + 1]);
+    out.vertices.push_back(placeholder[index * 3 + 2]);
+  };
+  auto add_uv = [&](float u, float w) {
+    out.uvs.push_back(u);
+    out.uvs.push_back(w);
+  };
+
+  // WorldUVGenerator.generateTopUV
+  auto f3 = [&](size_t a, size_t b, size_t c) {
+    add_vertex(a);
+    add_vertex(b);
+    add_vertex(c);
+    const float* p = out.vertices.data() + out.vertices.size() - 9;
+    add_uv(p[0], p[1]);
+    add_uv(p[3], p[4]);
+    add_uv(p[6], p[7]);
+  };
+
+  // WorldUVGenerator.generateSideWallUV
+  auto f4 = [&](size_t a, size_t b, size_t c, size_t d) {
+    add_vertex(a);
+    add_vertex(b);
+    add_vertex(d);
+    add_vertex(b);
+    add_vertex(c);
+    add_vertex(d);
+    const float* pa = &placeholder[a * 3];
+    const float* pb = &placeholder[b * 3];
+    const float* pc = &placeholder[c * 3];
+    const float* pd = &placeholder[d * 3];
+    const int axis = std::fabs(pa[1] - pb[1]) < std::fabs(pa[0] - pb[0]) ? 0 : 1;
+    add_uv(pa[axis], 1.0f - pa[2]);
+    add_uv(pb[axis], 1.0f - pb[2]);
+    add_uv(pd[axis], 1.0f - pd[2]);
+    add_uv(pb[axis], 1.0f - pb[2]);
+    add_uv(pc[axis], 1.0f - pc[2]);
+    add_uv(pd[axis], 1.0f - pd[2]);
+  };
+
+  // Lids: bottom faces reversed on the first layer, top faces on the last.
+  const uint32_t lidStart = 0;
+  const size_t topOffset = vlen * (steps + 2 * (size_t)bevelSegments);
+  for (size_t i = 0; i < flen; i++) {
+    const uint32_t* face = &s.faces[i * 3];
+    f3(face[2], face[1], face[0]);
+  }
+  for (size_t i = 0; i < flen; i++) {
+    const uint32_t* face = &s.faces[i * 3];
+    f3(face[0] + topOffset, face[1] + topOffset, face[2] + topOffset);
+  }
+  const uint32_t lidCount = (uint32_t)(out.vertices.size() / 3) - lidStart;
+  out.groups.push_back(MeshDataCpp::Group{lidStart, lidCount, 0});
+
+  // Side walls, one quad strip per ring edge.
+  const uint32_t sideStart = (uint32_t)(out.vertices.size() / 3);
+  size_t layeroffset = 0;
+  auto sidewalls = [&](size_t ringLength) {
+    for (size_t i = ringLength; i-- > 0;) {
+      const size_t j = i;
+      const size_t k = i == 0 ? ringLength - 1 : i - 1;
+      for (size_t sl = 0; sl < steps + 2 * (size_t)bevelSegments; sl++) {
+        const size_t slen1 = vlen * sl;
+        const size_t slen2 = vlen * (sl + 1);
+        f4(layeroffset + j + slen1, layeroffset + k + slen1, layeroffset + k + slen2, layeroffset + j + slen2);
+      }
+    }
+    layeroffset += ringLength;
+  };
+  sidewalls(contour.size());
+  for (const std::vector<Vec2>& hole : s.holes) {
+    sidewalls(hole.size());
+  }
+  out.groups.push_back(MeshDataCpp::Group{sideStart, (uint32_t)(out.vertices.size() / 3) - sideStart, 1});
+
+  compute_flat_normals(out);
+
+  return out;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "geometry_lib.h"
+
+// Polygons are passed the way earcut takes them: one flat xy array holding the
+// outer contour followed by every hole, plus the point index at which each hole
+// starts (`holeStarts`, ascending). A closing point equal to the first point of
+// a ring is ignored.
+
+// Ear-clipping triangulation (earcut). Above 80 points the ring is also linked in
+// z-order-curve order and the ear test only visits nodes inside the ear's z range
+// instead of the whole ring, which keeps large SVG outlines near O(n log n). Returns point indices, 3 per triangle;
+// empty for degenerate input or hole starts that are out of range/unsorted.
+std::vector<uint32_t> triangulate_polygon(
+    const float* xy,
+    size_t pointCount,
+    const uint32_t* holeStarts,
+    size_t holeCount);
+
+// Three-style ShapeGeometry: flat, indexed, +Z normals, uvs = xy.
+MeshDataCpp make_shape(const float* xy, size_t pointCount, const uint32_t* holeStarts, size_t holeCount);
+
+// Upper bound on ExtrudeOptions::steps and ::bevelSegments. Each one adds a ring
+// of side-wall vertices per contour point, so unbounded values only allocate.
+constexpr uint32_t kMaxExtrudeSegments = 4096;
+
+struct ExtrudeOptions {
+  uint32_t steps = 1;
+  float depth = 1.0f;
+  bool bevelEnabled = true;
+  float bevelThickness = 0.2f;
+  float bevelSize = 0.1f;
+  float bevelOffset = 0.0f;
+  uint32_t bevelSegments = 3;
+};
+
+// Three-style ExtrudeGeometry (straight extrusion along +Z, no path): non-indexed,
+// flat normals, WorldUVGenerator uvs, group 0 = caps, group 1 = side walls.
+// Returns an empty mesh if steps or bevelSegments exceed kMaxExtrudeSegments.
+MeshDataCpp make_extrude(
+    const float* xy,
+    size_t pointCount,
+    const uint32_t* holeStarts,
+    size_t holeCount,
+    const ExtrudeOptions& options);
@@ -0,0 +1,245 @@
+#include "umeyama.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/Geometry>
+#include <Eigen/LU>
+#include <Eigen/SVD>
+
+#include "parallel.h"
+
+namespace {
+
+// Pairs per block: the block's src and dst (2 x 192 KB) stay in L2 between
+// the mean pass and the centered pass.
+constexpr size_t kBlock = 16384;
+
+// [c*R t; 0 1] with t = dstMean - c*R*srcMean.
+Eigen::Matrix4d similarity(
+    const Eigen::Matrix3d& rotation,
+    double scale,
+    const Eigen::Vector3d& srcMean,
+    const Eigen::Vector3d& dstMean) {
+  Eigen::Matrix4d rt = Eigen::Matrix4d::Identity();
+  rt.topLeftCorner<3, 3>() = scale * rotation;
+  rt.topRightCorner<3, 1>() = dstMean - rt.topLeftCorner<3, 3>() * srcMean;
+  return rt;
+}
+
+// Determinant of `m` without row/column `skipRow`/`skipCol`.
+double minor3(const Eigen::Matrix4d& m, int skipRow, int skipCol) {
+  int r[3], c[3];
+  for (int i = 0, k = 0; i < 4; i++) {
+    if (i != skipRow) r[k++] = i;
+  }
+  for (int j = 0, k = 0; j < 4; j++) {
+    if (j != skipCol) c[k++] = j;
+  }
+  return m(r[0], c[0]) * (m(r[1], c[1]) * m(r[2], c[2]) - m(r[1], c[2]) * m(r[2], c[1])) -
+         m(r[0], c[1]) * (m(r[1], c[0]) * m(r[2], c[2]) - m(r[1], c[2]) * m(r[2], c[0])) +
+         m(r[0], c[2]) * (m(r[1], c[0]) * m(r[2], c[1]) - m(r[1], c[1]) * m(r[2], c[0]));
+}
+
+// Unit quaternion (w, x, y, z) of the rotation R maximizing trace(R^T sigma).
+Eigen::Quaterniond horn_rotation(const Eigen::Matrix3d& sigma) {
+  // Horn's M = sum src dst^T = n * sigma^T.
+  const Eigen::Matrix3d m = sigma.transpose();
+  const double sxx = m(0, 0), sxy = m(0, 1), sxz = m(0, 2);
+  const double syx = m(1, 0), syy = m(1, 1), syz = m(1, 2);
+  const double szx = m(2, 0), szy = m(2, 1), szz = m(2, 2);
+
+  Eigen::Matrix4d n;
+  n << sxx + syy + szz, syz - szy, szx - sxz, sxy - syx,
+       syz - szy, sxx - syy - szz, sxy + syx, szx + sxz,
+       szx - sxz, sxy + syx, -sxx + syy - szz, syz + szy,
+       sxy - syx, szx + sxz, syz + szy, -sxx - syy + szz;
+
+  // det(N - l I) = l^4 + c2 l^2 + c1 l + c0 (N is traceless).
+  const double frobenius2 = m.squaredNorm();
+  if (!(frobenius2 > 0.0)) {
+    return Eigen::Quaterniond::Identity();
+  }
+  const double c2 = -2.0 * frobenius2;
+  const double c1 = -8.0 * m.determinant();
+  const double c0 = n.determinant();
+
+  // All roots are real, so Newton from above the largest root decreases
+  // monotonically onto it. sqrt(3) |M|_F bounds the nuclear norm, which
+  // bounds every eigenvalue.
+  double lambda = std::sqrt(3.0 * frobenius2);
+  for (int iter = 0; iter < 50; iter++) {
+    const double l2 = lambda * lambda;
+    const double p = (l2 + c2) * l2 + c1 * lambda + c0;
+    const double dp = (4.0 * l2 + 2.0 * c2) * lambda + c1;
+    if (!(dp > 0.0)) {
+      break;
+    }
+    const double step = p / dp;
+    lambda -= step;
+    if (std::abs(step) <= 1e-15 * lambda) {
+      break;
+    }
+  }
+
+  // Every column of adj(N - l I) is a multiple of the eigenvector; take the
+  // longest. adj(A)(i, j) = (-1)^(i+j) * minor(j, i), and A is symmetric.
+  const Eigen::Matrix4d a = n - lambda * Eigen::Matrix4d::Identity();
+  Eigen::Vector4d best = Eigen::Vector4d::Zero();
+  for (int j = 0; j < 4; j++) {
+    Eigen::Vector4d column;
+    for (int i = 0; i < 4; i++) {
+      column(i) = ((i + j) % 2 ? -1.0 : 1.0) * minor3(a, i, j);
+    }
+    if (column.squaredNorm() > best.squaredNorm()) {
+      best = column;
+    }
+  }
+
+  // The adjugate vanishes when the eigenvalue is repeated; its size relative
+  // to lambda^3 tells how well separated the eigenvalue is.
+  const double scale3 = frobenius2 * std::sqrt(frobenius2);
+  if (!(best.squaredNorm() > 1e-16 * scale3 * scale3)) {
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> eig(n);
+    best = eig.eigenvectors().col(3);  // eigenvalues ascend
+  }
+  best.normalize();
+  return Eigen::Quaterniond(best(0), best(1), best(2), best(3));
+}
+
+}  // namespace
+
+UmeyamaAccumulator UmeyamaAccumulator::block(const float* src, const float* dst, size_t count) {
+  UmeyamaAccumulator out;
+  if (count == 0) {
+    return out;
+  }
+
+  double sum[6] = {0, 0, 0, 0, 0, 0};
+  for (size_t i = 0; i < count; i++) {
+    for (int k = 0; k < 3; k++) {
+      sum[k] += src[i * 3 + k];
+      sum[3 + k] += dst[i * 3 + k];
+    }
+  }
+  const double inv = 1.0 / (double)count;
+  const double smx = sum[0] * inv, smy = sum[1] * inv, smz = sum[2] * inv;
+  const double dmx = sum[3] * inv, dmy = sum[4] * inv, dmz = sum[5] * inv;
+
+  // Plain scalars keep the loop free of Eigen temporaries.
+  double c[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+  double squares = 0.0;
+  for (size_t i = 0; i < count; i++) {
+    const double sx = src[i * 3 + 0] - smx, sy = src[i * 3 + 1] - smy, sz = src[i * 3 + 2] - smz;
+    const double dx = dst[i * 3 + 0] - dmx, dy = dst[i * 3 + 1] - dmy, dz = dst[i * 3 + 2] - dmz;
+    c[0] += dx * sx, c[1] += dx * sy, c[2] += dx * sz;
+    c[3] += dy * sx, c[4] += dy * sy, c[5] += dy * sz;
+    c[6] += dz * sx, c[7] += dz * sy, c[8] += dz * sz;
+    squares += sx * sx + sy * sy + sz * sz;
+  }
+
+  out.count_ = count;
+  out.srcMean_ = Eigen::Vector3d(smx, smy, smz);
+  out.dstMean_ = Eigen::Vector3d(dmx, dmy, dmz);
+  out.cross_ << c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8];
+  out.srcSquares_ = squares;
+  return out;
+}
+
+void UmeyamaAccumulator::add(const float* src, const float* dst, size_t count) {
+  if (count <= kBlock) {
+    merge(block(src, dst, count));
+    return;
+  }
+
+  const size_t blocks = (count + kBlock - 1) / kBlock;
+  std::vector<UmeyamaAccumulator> partial(blocks);
+  parallel::run(blocks, [&](size_t b) {
+    const size_t begin = b * kBlock;
+    const size_t n = std::min(kBlock, count - begin);
+    partial[b] = block(src + begin * 3, dst + begin * 3, n);
+  });
+  // Merge in block order so the result does not depend on scheduling.
+  for (const UmeyamaAccumulator& p : partial) {
+    merge(p);
+  }
+}
+
+void UmeyamaAccumulator::add(const Eigen::Vector3d& src, const Eigen::Vector3d& dst) {
+  // Welford's update: the co-moment takes the src delta before and the dst
+  // delta after the mean moves.
+  count_++;
+  const Eigen::Vector3d srcDelta = src - srcMean_;
+  srcMean_ += srcDelta / (double)count_;
+  dstMean_ += (dst - dstMean_) / (double)count_;
+  const Eigen::Vector3d dstCentered = dst - dstMean_;
+  cross_.noalias() += dstCentered * srcDelta.transpose();
+  srcSquares_ += srcDelta.dot(src - srcMean_);
+}
+
+void UmeyamaAccumulator::merge(const UmeyamaAccumulator& other) {
+  if (other.count_ == 0) {
+    return;
+  }
+  if (count_ == 0) {
+    *this = other;
+    return;
+  }
+
+  // Chan, Golub & LeVeque: M = Ma + Mb + (na nb / n) dDst dSrc^T.
+  const double na = (double)count_, nb = (double)other.count_;
+  const double n = na + nb;
+  const Eigen::Vector3d srcDelta = other.srcMean_ - srcMean_;
+  const Eigen::Vector3d dstDelta = other.dstMean_ - dstMean_;
+  const double weight = na * nb / n;
+
+  cross_ += other.cross_;
+  cross_.noalias() += weight * dstDelta * srcDelta.transpose();
+  srcSquares_ += other.srcSquares_ + weight * srcDelta.squaredNorm();
+  srcMean_ += srcDelta * (nb / n);
+  dstMean_ += dstDelta * (nb / n);
+  count_ += other.count_;
+}
+
+Eigen::Matrix3d UmeyamaAccumulator::covariance() const {
+  return count_ > 0 ? Eigen::Matrix3d(cross_ / (double)count_) : Eigen::Matrix3d::Zero();
+}
+
+double UmeyamaAccumulator::src_variance() const {
+  return count_ > 0 ? srcSquares_ / (double)count_ : 0.0;
+}
+
+Eigen::Matrix4d UmeyamaAccumulator::solve(bool withScaling, UmeyamaSolver solver) const {
+  if (count_ == 0) {
+    return Eigen::Matrix4d::Identity();
+  }
+  if (solver == UmeyamaSolver::Horn) {
+    return umeyama_horn(covariance(), srcMean_, dstMean_, src_variance(), withScaling);
+  }
+
+  // Same steps as Eigen::umeyama, Eqs. (38)-(43).
+  Eigen::JacobiSVD<Eigen::Matrix3d> svd(covariance(), Eigen::ComputeFullU | Eigen::ComputeFullV);
+  Eigen::Vector3d s = Eigen::Vector3d::Ones();
+  if (svd.matrixU().determinant() * svd.matrixV().determinant() < 0) {
+    s(2) = -1;
+  }
+  const Eigen::Matrix3d rotation = svd.matrixU() * s.asDiagonal() * svd.matrixV().transpose();
+
+  const double variance = src_variance();
+  const double scale = withScaling && variance > 0.0 ? svd.singularValues().dot(s) / variance : 1.0;
+  return similarity(rotation, scale, srcMean_, dstMean_);
+}
+
+Eigen::Matrix4d umeyama_horn(
+    const Eigen::Matrix3d& sigma,
+    const Eigen::Vector3d& srcMean,
+    const Eigen::Vector3d& dstMean,
+    double srcVariance,
+    bool withScaling) {
+  const Eigen::Matrix3d rotation = horn_rotation(sigma).toRotationMatrix();
+  // trace(R^T Sigma) is the signed singular value sum of Eq. (42).
+  const double scale = withScaling && srcVariance > 0.0 ? rotation.cwiseProduct(sigma).sum() / srcVariance : 1.0;
+  return similarity(rotation, scale, srcMean, dstMean);
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+
+#include <Eigen/Core>
+
+// How the rotation is extracted from the 3x3 covariance: Svd is Eigen's
+// umeyama() (JacobiSVD plus reflection fix), Horn the closed-form quaternion
+// method of umeyama_horn(). Both give the same proper rotation.
+enum class UmeyamaSolver { Svd, Horn };
+
+// Streaming form of Eigen's umeyama() for 3D correspondences (scan alignment,
+// ICP): point pairs arrive in chunks of any size and only the running means
+// and co-moments are kept, so tens of millions of pairs never have to sit in
+// one src/dst matrix.
+//
+// Each chunk is reduced in fixed blocks (mean first, then the centered
+// sums, while the block is still in cache) and folded in with Chan et al.'s
+// pairwise update, which is as stable as Welford's per-point recurrence but
+// vectorizes. Blocks run on the parallel:: pool; block boundaries do not
+// depend on the thread count, so results are reproducible. Accumulators built
+// on different threads combine with merge(). Sums are kept in double.
+class UmeyamaAccumulator {
+ public:
+  // Adds `count` pairs; src and dst are xyz-interleaved.
+  void add(const float* src, const float* dst, size_t count);
+  void add(const Eigen::Vector3d& src, const Eigen::Vector3d& dst);
+  // Folds in the pairs seen by `other`, as if they had been added here.
+  void merge(const UmeyamaAccumulator& other);
+  void clear() { *this = UmeyamaAccumulator(); }
+
+  size_t count() const { return count_; }
+  const Eigen::Vector3d& src_mean() const { return srcMean_; }
+  const Eigen::Vector3d& dst_mean() const { return dstMean_; }
+  // Umeyama's Sigma: (1/n) * sum (dst - dstMean) (src - srcMean)^T.
+  Eigen::Matrix3d covariance() const;
+  // (1/n) * sum |src - srcMean|^2.
+  double src_variance() const;
+
+  // The similarity transform [c*R t; 0 1] mapping src onto dst in the
+  // least-squares sense, as umeyama(src, dst, withScaling) computes it.
+  // Identity when empty; with zero src variance the scale is 1.
+  Eigen::Matrix4d solve(bool withScaling = true, UmeyamaSolver solver = UmeyamaSolver::Svd) const;
+
+ private:
+  // Two-pass moments of one block of pairs.
+  static UmeyamaAccumulator block(const float* src, const float* dst, size_t count);
+
+  size_t count_ = 0;
+  Eigen::Vector3d srcMean_ = Eigen::Vector3d::Zero();
+  Eigen::Vector3d dstMean_ = Eigen::Vector3d::Zero();
+  Eigen::Matrix3d cross_ = Eigen::Matrix3d::Zero();  // sum (dst - dstMean) (src - srcMean)^T
+  double srcSquares_ = 0.0;                         // sum |src - srcMean|^2
+};
+
+// Similarity transform from precomputed moments (Sigma as in
+// UmeyamaAccumulator::covariance()) with Horn's quaternion method: the
+// rotation is the eigenvector of the largest eigenvalue of a symmetric 4x4
+// built from Sigma. That eigenvalue is the largest root of the matrix's
+// characteristic quartic, found by Newton iteration from an upper bound
+// (Theobald's QCP), and the eigenvector is read off the adjugate of
+// (N - lambda I). No SVD and no heap allocation; falls back to
+// SelfAdjointEigenSolver when the largest eigenvalue is (nearly) repeated,
+// i.e. when the rotation is not unique (collinear points).
+Eigen::Matrix4d umeyama_horn(
+    const Eigen::Matrix3d& sigma,
+    const Eigen::Vector3d& srcMean,
+    const Eigen::Vector3d& dstMean,
+    double srcVariance,
+    bool withScaling = true);
+
+// Fixed-size umeyama() for 3 x n src/dst (Matrix3Xf, Map, block, ...): means
+// and Sigma in double with fixed-size temporaries, then umeyama_horn(). Meant
+// for the small point sets of ICP refinement loops, where Eigen's generic
+// path is dominated by the dynamic-size JacobiSVD.
+template <typename SrcDerived, typename DstDerived>
+Eigen::Matrix<typename SrcDerived::Scalar, 4, 4> umeyama3(
+    const Eigen::MatrixBase<SrcDerived>& src,
+    const Eigen::MatrixBase<DstDerived>& dst,
+    bool withScaling = true) {
+  static_assert(SrcDerived::RowsAtCompileTime == 3 && DstDerived::RowsAtCompileTime == 3, "umeyama3 takes 3 x n points");
+  typedef typename SrcDerived::Scalar Scalar;
+
+  const Eigen::Index n = src.cols();
+  if (n == 0 || dst.cols() != n) {
+    return Eigen::Matrix<Scalar, 4, 4>::Identity();
+  }
+  Eigen::Vector3d srcMean = Eigen::Vector3d::Zero();
+  Eigen::Vector3d dstMean = Eigen::Vector3d::Zero();
+  for (Eigen::Index i = 0; i < n; i++) {
+    srcMean += src.col(i).template cast<double>();
+    dstMean += dst.col(i).template cast<double>();
+  }
+  srcMean /= (double)n;
+  dstMean /= (double)n;
+
+  Eigen::Matrix3d sigma = Eigen::Matrix3d::Zero();
+  double srcSquares = 0.0;
+  for (Eigen::Index i = 0; i < n; i++) {
+    const Eigen::Vector3d s = src.col(i).template cast<double>() - srcMean;
+    const Eigen::Vector3d d = dst.col(i).template cast<double>() - dstMean;
+    sigma.noalias() += d * s.transpose();
+    srcSquares += s.squaredNorm();
+  }
+  return umeyama_horn(sigma / (double)n, srcMean, dstMean, srcSquares / (double)n, withScaling).template cast<Scalar>();
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing hash helpers shared by the edge extractors (edges.cpp,
+// wireframe.cpp): a splitmix64 mixer and a welder that maps integer position
+// keys to dense vertex ids.
+namespace weld {
+
+const uint32_t kEmpty = 0xffffffffu;
+
+inline uint64_t mix64(uint64_t x) {
+  // splitmix64 finalizer
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  x ^= x >> 31;
+  return x;
+}
+
+inline size_t table_capacity(size_t expected) {
+  size_t cap = 16;
+  while (cap < expected * 2) {
+    cap <<= 1;
+  }
+  return cap;
+}
+
+// Maps (quantized or bit-exact) positions to dense vertex ids, in first-seen
+// order (linear probing).
+class VertexWelder {
+ public:
+  explicit VertexWelder(size_t expected)
+      : mask_(table_capacity(expected) - 1), keys_((mask_ + 1) * 3), ids_(mask_ + 1, kEmpty) {}
+
+  uint32_t id_of(int64_t qx, int64_t qy, int64_t qz) {
+    const uint64_t h = mix64((uint64_t)qx * 0x9e3779b97f4a7c15ull ^ mix64((uint64_t)qy) ^ ((uint64_t)qz << 1));
+    for (size_t slot = h & mask_;; slot = (slot + 1) & mask_) {
+      if (ids_[slot] == kEmpty) {
+        keys_[slot * 3 + 0] = qx;
+        keys_[slot * 3 + 1] = qy;
+        keys_[slot * 3 + 2] = qz;
+        ids_[slot] = next_++;
+        return ids_[slot];
+      }
+      if (keys_[slot * 3 + 0] == qx && keys_[slot * 3 + 1] == qy && keys_[slot * 3 + 2] == qz) {
+        return ids_[slot];
+      }
+    }
+  }
+
+  // Number of distinct positions seen so far.
+  uint32_t size() const { return next_; }
+
+ private:
+  size_t mask_;
+  std::vector<int64_t> keys_;
+  std::vector<uint32_t> ids_;
+  uint32_t next_ = 0;
+};
+
+}  // namespace weld
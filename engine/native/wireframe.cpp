@@ -0,0 +1,158 @@
+#include "wireframe.h"
+
+#include <cstring>
+#include <utility>
+
+#include "vertex_weld.h"
+
+namespace {
+
+unsigned bit_width(uint64_t v) {
+  unsigned bits = 0;
+  while (v != 0) {
+    bits++;
+    v >>= 1;
+  }
+  return bits;
+}
+
+const unsigned kDigitBits = 11;
+const size_t kBuckets = (size_t)1 << kDigitBits;
+const uint64_t kDigitMask = kBuckets - 1;
+
+// LSD radix sort on 11-bit digits. All digit histograms are built in a single
+// read pass, and digits that are identical for every key (always the case for
+// the high digits of packed small vertex ids) are skipped without touching memory.
+// The sorted keys end up in `keys`.
+void radix_sort(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch, unsigned keyBits) {
+  const size_t n = keys.size();
+  const unsigned passes = (keyBits + kDigitBits - 1) / kDigitBits;
+  if (n < 2 || passes == 0) {
+    return;
+  }
+
+  std::vector<size_t> counts((size_t)passes * kBuckets, 0);
+  for (size_t i = 0; i < n; i++) {
+    uint64_t k = keys[i];
+    for (unsigned p = 0; p < passes; p++) {
+      counts[(size_t)p * kBuckets + (k & kDigitMask)]++;
+      k >>= kDigitBits;
+    }
+  }
+
+  scratch.resize(n);
+  uint64_t* src = keys.data();
+  uint64_t* dst = scratch.data();
+  for (unsigned p = 0; p < passes; p++) {
+    size_t* c = &counts[(size_t)p * kBuckets];
+    const unsigned shift = p * kDigitBits;
+    if (c[(src[0] >> shift) & kDigitMask] == n) {
+      continue;
+    }
+
+    size_t sum = 0;
+    for (size_t d = 0; d < kBuckets; d++) {
+      const size_t count = c[d];
+      c[d] = sum;
+      sum += count;
+    }
+    for (size_t i = 0; i < n; i++) {
+      const uint64_t k = src[i];
+      dst[c[(k >> shift) & kDigitMask]++] = k;
+    }
+    std::swap(src, dst);
+  }
+
+  if (src != keys.data()) {
+    std::memcpy(keys.data(), src, n * sizeof(uint64_t));
+  }
+}
+
+// Welder key for an exact coordinate: its bit pattern, with -0 folded into 0
+// (Three's position hash prints both as "0").
+int64_t exact_key(float v) {
+  const float folded = v + 0.0f;
+  uint32_t bits;
+  std::memcpy(&bits, &folded, sizeof(bits));
+  return bits;
+}
+
+}  // namespace
+
+std::vector<uint32_t> wireframe_indices(
+    const float* positions,
+    size_t vertexCount,
+    const uint32_t* indices,
+    size_t indexCount) {
+  std::vector<uint32_t> out;
+
+  const bool indexed = indices != nullptr && indexCount > 0;
+  const size_t triangleCount = (indexed ? indexCount : vertexCount) / 3;
+  if (triangleCount == 0 || vertexCount >= 0xffffffffull) {
+    return out;
+  }
+
+  // Welded id of every vertex, and the first vertex index of every welded id.
+  weld::VertexWelder welder(vertexCount);
+  std::vector<uint32_t> welded(vertexCount);
+  std::vector<uint32_t> first;
+  for (size_t i = 0; i < vertexCount; i++) {
+    const float* p = positions + i * 3;
+    welded[i] = welder.id_of(exact_key(p[0]), exact_key(p[1]), exact_key(p[2]));
+    if (welded[i] == first.size()) {
+      first.push_back((uint32_t)i);
+    }
+  }
+
+  // Pack (min, max) with just enough bits per id, so the sort skips every pass
+  // above 2 * bit_width(weldedCount - 1).
+  const unsigned idBits = bit_width(first.size() - 1);
+  const unsigned keyBits = idBits * 2;
+
+  std::vector<uint64_t> keys;
+  keys.reserve(triangleCount * 3);
+  for (size_t t = 0; t < triangleCount; t++) {
+    uint32_t v[3];
+    bool valid = true;
+    for (int k = 0; k < 3; k++) {
+      v[k] = indexed ? indices[t * 3 + k] : (uint32_t)(t * 3 + k);
+      valid = valid && v[k] < vertexCount;
+    }
+    if (!valid) {
+      continue;
+    }
+    for (int j = 0; j < 3; j++) {
+      const uint32_t a = welded[v[j]];
+      const uint32_t b = welded[v[(j + 1) % 3]];
+      if (a == b) {
+        continue;
+      }
+      const uint64_t lo = a < b ? a : b;
+      const uint64_t hi = a < b ? b : a;
+      keys.push_back((lo << idBits) | hi);
+    }
+  }
+
+  std::vector<uint64_t> scratch;
+  radix_sort(keys, scratch, keyBits);
+
+  const uint64_t idMask = ((uint64_t)1 << idBits) - 1;
+  size_t unique = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    unique += (i == 0 || keys[i] != keys[i - 1]) ? 1 : 0;
+  }
+  out.resize(unique * 2);
+  size_t o = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (i == 0 || keys[i] != keys[i - 1]) {
+      out[o++] = first[keys[i] >> idBits];
+      out[o++] = first[keys[i] & idMask];
+    }
+  }
+
+  return out;
+}
+
+std::vector<uint32_t> wireframe_indices(const MeshDataCpp& mesh) {
+  return wireframe_indices(mesh.vertices.data(), mesh.vertices.size() / 3, mesh.indices.data(), mesh.indices.size());
+}
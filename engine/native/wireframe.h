@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "geometry_lib.h"
+
+// Three-style WireframeGeometry as an index buffer: every unique triangle edge
+// once, as uint32 vertex index pairs (a line list over the mesh's own vertices).
+//
+// Like Three, edges are unique by vertex position, not by index: vertices are
+// welded on their exact coordinates (-0 equals 0), so split vertices (box
+// faces, non-indexed soups) share edges, and each welded vertex is emitted as
+// its first index. Welded ids are packed into 64-bit (min, max) keys, LSD radix
+// sorted and swept for duplicates, so the cost is a few linear passes
+// regardless of mesh size. Pairs come out sorted by welded id, not in Three's
+// first-seen order. `indices` may be null/empty, in which case `positions` is a
+// non-indexed triangle soup. Triangles referencing a vertex >= `vertexCount`
+// are skipped, as are zero-length edges.
+std::vector<uint32_t> wireframe_indices(
+    const float* positions,
+    size_t vertexCount,
+    const uint32_t* indices,
+    size_t indexCount);
+
+std::vector<uint32_t> wireframe_indices(const MeshDataCpp& mesh);
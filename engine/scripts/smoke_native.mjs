@@ -35,3 +35,413 @@ console.log('uvs:', mesh.uvs ? mesh.uvs.length : '(missing)');
 console.log('indices:', mesh.indices.length, '(uint32)');
 console.log('groups:', Array.isArray(mesh.groups) ? mesh.groups.length : '(missing)');
 console.log('first vertex:', mesh.vertices[0], mesh.vertices[1], mesh.vertices[2]);
+
+for (const name of ['makeTetrahedron', 'makeOctahedron', 'makeIcosahedron', 'makeDodecahedron']) {
+  if (typeof addon[name] !== 'function') {
+    fail(`Addon loaded but missing ${name}(radius,detail) export`);
+  }
+}
+const ico = addon.makeIcosahedron(1, 2);
+if (ico.vertices.length !== 20 * 9 * 9 || ico.uvs.length !== (ico.vertices.length / 3) * 2) {
+  fail('makeIcosahedron(1,2) returned unexpected buffer sizes');
+}
+console.log('icosahedron(detail=2) vertices:', ico.vertices.length / 3);
+// Detail 4096 would be ~1e9 vertices: rejected against the vertex budget before allocating.
+try {
+  addon.makeIcosahedron(1, 4096);
+  fail('makeIcosahedron(1, 4096) did not throw');
+} catch (e) {
+  if (!(e instanceof RangeError)) throw e;
+}
+
+const square = new Float32Array([0, 0, 1, 0, 1, 1, 0, 1]);
+const tris = addon.triangulate(square);
+if (!(tris instanceof Uint32Array) || tris.length !== 6) {
+  fail('triangulate(square) should return 2 triangles');
+}
+const extruded = addon.makeExtrude(square, undefined, { depth: 1, bevelEnabled: false });
+if (extruded.vertices.length !== 36 * 3 || !Array.isArray(extruded.groups) || extruded.groups.length !== 2) {
+  fail('makeExtrude(square) returned unexpected layout');
+}
+console.log('extrude(square) vertices:', extruded.vertices.length / 3);
+// steps / bevelSegments above kMaxExtrudeSegments are rejected, not wrapped to uint32 or allocated.
+for (const options of [{ steps: 1e12 }, { bevelSegments: 1e6 }]) {
+  try {
+    addon.makeExtrude(square, undefined, options);
+    fail(`makeExtrude(${JSON.stringify(options)}) did not throw`);
+  } catch (e) {
+    if (!(e instanceof RangeError)) throw e;
+  }
+}
+
+// A box has 12 hard edges; every face pair meets at 90 degrees.
+const boxEdges = addon.edgesGeometry(mesh.vertices, mesh.indices, 1);
+if (!(boxEdges instanceof Float32Array) || boxEdges.length !== 12 * 6) {
+  fail(`edgesGeometry(box) expected 12 edges, got ${boxEdges.length / 6}`);
+}
+console.log('box edges:', boxEdges.length / 6);
+
+// Box: 12 outline edges + 6 face diagonals, as in Three -- the faces' 24 split vertices weld by
+// position. The non-indexed icosahedron (60 vertices) has the solid's 30 edges.
+const wire = addon.wireframeIndices(mesh.vertices, mesh.indices);
+if (!(wire instanceof Uint32Array) || wire.length !== 18 * 2) {
+  fail(`wireframeIndices(box) expected 18 edges, got ${wire.length / 2}`);
+}
+const icoWire = addon.wireframeIndices(addon.makeIcosahedron(1, 0).vertices, null);
+if (icoWire.length !== 30 * 2) {
+  fail(`wireframeIndices(icosahedron) expected 30 edges, got ${icoWire.length / 2}`);
+}
+console.log('box wireframe edges:', wire.length / 2);
+
+const plane = addon.makePlane(2, 1, 4, 3);
+if (plane.vertices.length !== 5 * 4 * 3 || plane.indices.length !== 4 * 3 * 6 || plane.normals[2] !== 1) {
+  fail('makePlane(2, 1, 4, 3) returned an unexpected layout');
+}
+const circle = addon.makeCircle(1, 8);
+const ring = addon.makeRing(0.5, 1, 8, 2);
+if (circle.vertices.length !== 10 * 3 || circle.indices.length !== 8 * 3 || ring.indices.length !== 8 * 2 * 6) {
+  fail('makeCircle/makeRing returned an unexpected layout');
+}
+console.log('plane/circle/ring vertices:', plane.vertices.length / 3, circle.vertices.length / 3, ring.vertices.length / 3);
+
+// Planar xyzw: q0 = identity, q1 = 90 degrees about Z; q1 * q1 = 180 degrees about Z.
+const quats = new Float32Array([0, 0, 0, 0, 0, Math.SQRT1_2, 1, Math.SQRT1_2]);
+const squared = addon.quatMultiplyBatch(quats, quats);
+if (squared[6] !== 1 || Math.abs(squared[5] - 1) > 1e-6 || Math.abs(squared[7]) > 1e-6) {
+  fail(`quatMultiplyBatch returned ${Array.from(squared)}`);
+}
+addon.quatMultiplyBatch(quats, quats, quats);
+console.log('quat batch z/w:', quats[5].toFixed(3), quats[7].toFixed(3));
+
+// Halfway between identity and 90 degrees about Z is 45 degrees about Z.
+const qa = new Float32Array([0, 0, 0, 1]);
+const qb = new Float32Array([0, 0, Math.SQRT1_2, Math.SQRT1_2]);
+const halfway = addon.quatSlerpBatch(qa, qb, 0.5);
+const nhalfway = addon.quatNlerpBatch(qa, qb, new Float32Array([0.5]));
+if (Math.abs(halfway[2] - Math.sin(Math.PI / 8)) > 1e-6 || Math.abs(nhalfway[3] - Math.cos(Math.PI / 8)) > 1e-6) {
+  fail(`quatSlerpBatch/quatNlerpBatch returned ${Array.from(halfway)} / ${Array.from(nhalfway)}`);
+}
+console.log('slerp halfway z:', halfway[2].toFixed(6));
+
+// 90 degrees about Z in ZXY: eulerAngles(2, 0, 1) gives (pi/2, 0, 0); and back.
+const euler = addon.quatToEulerBatch(qb, [2, 0, 1]);
+const fromEuler = addon.eulerToQuatBatch(euler, [2, 0, 1]);
+if (Math.abs(euler[0] - Math.PI / 2) > 1e-6 || Math.abs(euler[1]) > 1e-6 || Math.abs(fromEuler[2] - Math.SQRT1_2) > 1e-6) {
+  fail(`quatToEulerBatch/eulerToQuatBatch returned ${Array.from(euler)} / ${Array.from(fromEuler)}`);
+}
+console.log('euler z:', euler[0].toFixed(6));
+
+// 90 degrees about Z: column 0 of the matrix is +y, angle-axis is (0, 0, 1) pi/2; and back.
+const rotation = addon.convertRotationBatch(qb, 'quaternion', 'matrix3');
+const angleAxis = addon.convertRotationBatch(rotation, 'matrix3', 'angleAxis');
+const fromMatrix = addon.convertRotationBatch(rotation, 'matrix3', 'quaternion');
+if (
+  rotation.length !== 9 ||
+  Math.abs(rotation[1] - 1) > 1e-6 ||
+  Math.abs(angleAxis[2] - 1) > 1e-6 ||
+  Math.abs(angleAxis[3] - Math.PI / 2) > 1e-6 ||
+  Math.abs(fromMatrix[3] - Math.SQRT1_2) > 1e-6
+) {
+  fail(`convertRotationBatch returned ${Array.from(rotation)} / ${Array.from(angleAxis)} / ${Array.from(fromMatrix)}`);
+}
+console.log('rotation angle:', angleAxis[3].toFixed(6));
+
+// Translate by (1, 2, 3) and scale x by 2: normals stay unit length.
+const moved = addon.makeBox(1, 1, 1);
+addon.transformMesh(moved.vertices, moved.normals, [2, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 1, 2, 3, 1]);
+if (moved.vertices[0] !== 2 || moved.vertices[1] !== 2.5 || moved.vertices[2] !== 3.5 || moved.normals[0] !== 1) {
+  fail(`transformMesh moved the first box vertex to ${Array.from(moved.vertices.slice(0, 3))}`);
+}
+console.log('transformMesh first vertex:', Array.from(moved.vertices.slice(0, 3)).join(','));
+
+// Bone 0 identity, bone 1 rotated 90 degrees about Z and moved +2 x. A vertex at (1, 0, 0) split
+// evenly between them lands at (1.5, 0.5, 0); the second vertex follows bone 1 only.
+const skinned = new Float32Array(6);
+const skinnedNormals = new Float32Array(6);
+addon.skinLbs(
+  new Float32Array([1, 0, 0, 1, 0, 0]),
+  new Float32Array([1, 0, 0, 1, 0, 0]),
+  new Uint16Array([0, 1, 0, 0, 1, 0, 0, 0]),
+  new Float32Array([0.5, 0.5, 0, 0, 1, 0, 0, 0]),
+  new Float32Array([1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0, -1, 0, 0, 0, 0, 0, 1, 0, 2, 0, 0, 1]),
+  skinned,
+  skinnedNormals,
+);
+const expectedSkin = [1.5, 0.5, 0, 2, 1, 0];
+const expectedNormals = [Math.SQRT1_2, Math.SQRT1_2, 0, 0, 1, 0];
+if (expectedSkin.some((v, i) => Math.abs(skinned[i] - v) > 1e-6) || expectedNormals.some((v, i) => Math.abs(skinnedNormals[i] - v) > 1e-6)) {
+  fail(`skinLbs returned ${Array.from(skinned)} / ${Array.from(skinnedNormals)}`);
+}
+console.log('skinLbs first vertex:', Array.from(skinned.subarray(0, 3)).join(','));
+
+// Same influences with bone 1 a pure 90 degree turn about Z: LBS shrinks the half-way vertex to
+// (0.5, 0.5, 0), DQS turns it 45 degrees and keeps its length.
+const dqSkinned = new Float32Array(6);
+addon.skinDqs(
+  new Float32Array([1, 0, 0, 1, 0, 0]),
+  null,
+  new Uint16Array([0, 1, 0, 0, 1, 0, 0, 0]),
+  new Float32Array([0.5, 0.5, 0, 0, 1, 0, 0, 0]),
+  new Float32Array([1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0, -1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1]),
+  dqSkinned,
+  null,
+);
+const expectedDq = [Math.SQRT1_2, Math.SQRT1_2, 0, 0, 1, 0];
+if (expectedDq.some((v, i) => Math.abs(dqSkinned[i] - v) > 1e-6)) {
+  fail(`skinDqs returned ${Array.from(dqSkinned)}`);
+}
+console.log('skinDqs first vertex:', Array.from(dqSkinned.subarray(0, 3), (v) => v.toFixed(6)).join(','));
+
+// Inverse of "rotate 90 degrees about Z, scale 2, move +x 4": maps (4, 2, 0) back to (1, 0, 0).
+const scaled = new Float32Array([0, 2, 0, 0, -2, 0, 0, 0, 0, 0, 2, 0, 4, 0, 0, 1]);
+const inverses = addon.invertAffineBatch(new Float32Array([...scaled, ...scaled]), 'uniformScale');
+const general = addon.invertAffineBatch(scaled, 'general');
+const mappedX = inverses[16] * 4 + inverses[20] * 2 + inverses[28];
+if (Math.abs(mappedX - 1) > 1e-6 || inverses[31] !== 1 || general.some((v, i) => Math.abs(v - inverses[i]) > 1e-6)) {
+  fail(`invertAffineBatch returned ${Array.from(inverses)} / ${Array.from(general)}`);
+}
+console.log('invertAffineBatch x:', mappedX.toFixed(6));
+
+// Unit cube rotated 45 degrees about Z and moved by +10 x: x/y half-extent grows to sqrt(2)/2.
+const c45 = Math.SQRT1_2;
+const rotated = addon.transformBoxes(
+  new Float32Array([-0.5, -0.5, -0.5, 0.5, 0.5, 0.5]),
+  new Float32Array([c45, c45, 0, 0, -c45, c45, 0, 0, 0, 0, 1, 0, 10, 0, 0, 1]),
+);
+if (Math.abs(rotated[0] - (10 - c45)) > 1e-5 || Math.abs(rotated[4] - c45) > 1e-5 || rotated[5] !== 0.5) {
+  fail(`transformBoxes returned ${Array.from(rotated)}`);
+}
+console.log('transformBoxes min x:', rotated[0].toFixed(4));
+
+// Orthographic [-1, 1]^3 frustum: a box at the origin is visible, one at x = 5 is not.
+const planes = addon.frustumPlanes([1, 0, 0, 0, 0, 1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 1]);
+const cullMask = addon.cullBoxes(planes, new Float32Array([-0.5, 4.5, -0.5, -0.5, -0.5, -0.5, 0.5, 5.5, 0.5, 0.5, 0.5, 0.5]));
+if (cullMask.length !== 1 || cullMask[0] !== 1) {
+  fail(`cullBoxes returned ${Array.from(cullMask)}`);
+}
+console.log('cullBoxes mask:', cullMask[0]);
+
+// Ten unit boxes along +x: a ray down the x axis from -5 hits box 0 at t = 4.5.
+const row = new Float32Array(60);
+for (let i = 0; i < 10; i++) {
+  row[i] = i - 0.5; // minX
+  row[10 + i] = row[20 + i] = -0.5;
+  row[30 + i] = i + 0.5; // maxX
+  row[40 + i] = row[50 + i] = 0.5;
+}
+const bvh = new addon.BoxBvh(row);
+const picked = bvh.raycast([-5, 0, 0], [1, 0, 0]);
+const near = bvh.nearest([7.2, 3, 0]);
+if (!picked || picked.index !== 0 || picked.distance !== 4.5 || near.index !== 7 || bvh.overlap([2.6, 0, 0], [4, 0, 0]).length !== 2) {
+  fail(`BoxBvh raycast ${JSON.stringify(picked)}, nearest ${JSON.stringify(near)}`);
+}
+bvh.dispose();
+console.log('BoxBvh raycast:', picked.index, picked.distance);
+
+const lbvh = new addon.BoxBvh(row, 'lbvh');
+const lbvhPicked = lbvh.raycast([-5, 0, 0], [1, 0, 0]);
+if (!lbvhPicked || lbvhPicked.index !== 0 || lbvhPicked.distance !== 4.5 || lbvh.nearest([7.2, 3, 0]).index !== 7) {
+  fail(`BoxBvh (lbvh) raycast ${JSON.stringify(lbvhPicked)}`);
+}
+lbvh.dispose();
+
+// Both builders against brute force on a seeded random scene, before and after a refit.
+let seed = 7;
+const random = () => ((seed = (seed * 1664525 + 1013904223) >>> 0) / 2 ** 32) * 10 - 5;
+const boxCount = 300;
+const scene = new Float32Array(boxCount * 6);
+const scatter = () => {
+  for (let i = 0; i < boxCount; i++) {
+    for (let a = 0; a < 3; a++) {
+      const c = random();
+      const h = Math.abs(random()) * 0.1;
+      scene[a * boxCount + i] = c - h;
+      scene[(3 + a) * boxCount + i] = c + h;
+    }
+  }
+};
+const boxLo = (i, a) => scene[a * boxCount + i];
+const boxHi = (i, a) => scene[(3 + a) * boxCount + i];
+const bruteRay = (o, d) => {
+  let best = Infinity;
+  for (let i = 0; i < boxCount; i++) {
+    let t0 = 0;
+    let t1 = Infinity;
+    for (let a = 0; a < 3; a++) {
+      const ta = (boxLo(i, a) - o[a]) / d[a];
+      const tb = (boxHi(i, a) - o[a]) / d[a];
+      t0 = Math.max(t0, Math.min(ta, tb));
+      t1 = Math.min(t1, Math.max(ta, tb));
+    }
+    if (t0 <= t1) best = Math.min(best, t0);
+  }
+  return best;
+};
+const bruteNearest = (p) => {
+  let best = Infinity;
+  for (let i = 0; i < boxCount; i++) {
+    let d2 = 0;
+    for (let a = 0; a < 3; a++) {
+      const g = Math.max(boxLo(i, a) - p[a], 0, p[a] - boxHi(i, a));
+      d2 += g * g;
+    }
+    best = Math.min(best, Math.sqrt(d2));
+  }
+  return best;
+};
+const bruteOverlap = (lo, hi) => {
+  const hits = [];
+  for (let i = 0; i < boxCount; i++) {
+    if ([0, 1, 2].every((a) => boxLo(i, a) <= hi[a] && boxHi(i, a) >= lo[a])) hits.push(i);
+  }
+  return hits.join();
+};
+const checkScene = (tree, label) => {
+  for (let q = 0; q < 40; q++) {
+    const o = [random(), random(), random()];
+    const d = [random(), random(), random()];
+    const hit = tree.raycast(o, d);
+    const got = hit ? hit.distance : Infinity;
+    const expected = bruteRay(o, d);
+    if (got !== expected && !(Math.abs(got - expected) < 1e-4)) {
+      fail(`${label} raycast ${JSON.stringify(hit)}, brute force ${expected}`);
+    }
+    const close = tree.nearest(o);
+    if (!close || Math.abs(close.distance - bruteNearest(o)) > 1e-4) {
+      fail(`${label} nearest ${JSON.stringify(close)}, brute force ${bruteNearest(o)}`);
+    }
+    const hi = o.map((v) => v + Math.abs(random()) * 0.5);
+    const found = Array.from(tree.overlap(o, hi)).sort((x, y) => x - y).join();
+    if (found !== bruteOverlap(o, hi)) {
+      fail(`${label} overlap ${found}, brute force ${bruteOverlap(o, hi)}`);
+    }
+  }
+};
+for (const builder of ['sah', 'lbvh']) {
+  scatter();
+  const tree = new addon.BoxBvh(scene, builder);
+  checkScene(tree, `BoxBvh (${builder})`);
+  scatter();
+  tree.refit(scene);
+  checkScene(tree, `BoxBvh (${builder}) after refit`);
+  tree.dispose();
+}
+console.log('BoxBvh brute-force scenes: sah, lbvh, each refit');
+
+// Boxes 3 and 4 of the row touch at x = 3.5; pull box 4 away and the pair is reported removed.
+const sap = new addon.SweepAndPrune(0);
+const first = sap.update(row);
+row[4] += 0.5;
+row[34] += 0.5;
+const second = sap.update(row);
+if (first[0] !== 9 || first[1] !== 0 || first[8] !== 3 || first[9] !== 4 || second[0] !== 0 || second[1] !== 1 || second[2] !== 3 || sap.pairs().length !== 16) {
+  fail(`SweepAndPrune ${first} / ${second}`);
+}
+// A NaN coordinate makes box 7 empty: its pairs with 6 and 8 stop overlapping.
+row[27] = NaN;
+const third = sap.update(row);
+if (third.join() !== '0,2,6,7,7,8' || sap.pairs().length !== 12) {
+  fail(`SweepAndPrune with a NaN box: ${third}`);
+}
+sap.dispose();
+console.log('SweepAndPrune pairs:', first[0], '-', second[1]);
+
+// Box corners are at +-0.5: the corner (0.5, 0.5, 0.5) is shared by three faces' vertices.
+const grid = new addon.PointGrid(addon.makeBox(1, 1, 1).vertices, 0.25);
+const corner = grid.radius([0.5, 0.5, 0.5], 0.01);
+const closest = grid.nearest([0.6, 0.5, 0.5], 4);
+if (grid.size !== 24 || corner.length !== 3 || closest.index.length !== 4 || Math.abs(closest.distance[0] - 0.1) > 1e-6 || closest.distance[3] < closest.distance[2]) {
+  fail(`PointGrid radius ${corner}, nearest ${closest.index} / ${closest.distance}`);
+}
+grid.dispose();
+console.log('PointGrid corner welds:', corner.length);
+
+// A query far outside the points starts at the ring that reaches them: 1e9 empty shells of
+// 0.001 cells lie in between.
+const fineGrid = new addon.PointGrid(addon.makeBox(1, 1, 1).vertices, 0.001);
+const far = fineGrid.nearest([1e6, 0.5, 0.5], 1);
+if (far.index.length !== 1 || Math.abs(far.distance[0] - (1e6 - 0.5)) > 1) {
+  fail(`PointGrid far nearest ${far.index} / ${far.distance}`);
+}
+fineGrid.dispose();
+console.log('PointGrid far distance:', far.distance[0].toFixed(1));
+
+// Two points 1000 apart on 0.01 cells: 1e15 cells in the bounds, so both queries have to fall
+// back to scanning the points instead of walking cells.
+const sparse = new addon.PointGrid(new Float32Array([0, 0, 0, 1000, 1000, 1000]), 0.01);
+const sparseNearest = sparse.nearest([1, 1, 1], 2);
+const sparseRadius = sparse.radius([500, 500, 500], 1000);
+if (sparseNearest.index.length !== 2 || sparseNearest.index[0] !== 0 || sparseNearest.index[1] !== 1 || sparseRadius.length !== 2) {
+  fail(`PointGrid sparse nearest ${sparseNearest.index}, radius ${sparseRadius}`);
+}
+sparse.dispose();
+console.log('PointGrid sparse nearest:', Array.from(sparseNearest.index).join(','));
+
+// dst = 2 * src + (1, 2, 3), fed in two chunks.
+const src = addon.makeBox(1, 2, 3).vertices;
+const dst = src.map((v, i) => 2 * v + (i % 3) + 1);
+const umeyama = new addon.UmeyamaAccumulator();
+umeyama.add(src.subarray(0, 36), dst.subarray(0, 36));
+umeyama.add(src.subarray(36), dst.subarray(36));
+const similarity = umeyama.solve();
+const expected = [2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 1, 2, 3, 1];
+if (umeyama.count !== 24 || expected.some((v, i) => Math.abs(similarity[i] - v) > 1e-5)) {
+  fail(`UmeyamaAccumulator ${umeyama.count}: ${similarity}`);
+}
+umeyama.dispose();
+console.log('Umeyama scale:', similarity[0]);
+
+// Source = sphere vertices shifted by (0.05, -0.03, 0.02); ICP should undo the shift.
+const target = addon.makeIcosahedron(1, 3).vertices;
+const shifted = target.map((v, i) => v - [0.05, -0.03, 0.02][i % 3]);
+const icp = new addon.IcpRegistration(target);
+const fit = icp.align(shifted, { inlierFraction: 1 });
+const last = fit.iterations[fit.iterations.length - 1];
+if (!fit.converged || Math.abs(fit.matrix[12] - 0.05) > 1e-3 || Math.abs(fit.matrix[13] + 0.03) > 1e-3 || last.rmsError > 1e-3) {
+  fail(`IcpRegistration ${fit.converged} ${fit.matrix} rms ${last.rmsError}`);
+}
+icp.dispose();
+console.log('ICP iterations:', fit.iterations.length);
+
+// Root at (1, 0, 0) turned 90 degrees about Z, child 2 up the root's local y: world (-1, 0, 0).
+// Moving only the child recomputes one matrix; an unchanged frame recomputes none.
+const hierarchy = new addon.TransformHierarchy(new Int32Array([-1, 0]));
+hierarchy.setLocal(0, [1, 0, 0, 0, 0, Math.SQRT1_2, Math.SQRT1_2, 1, 1, 1]);
+hierarchy.setLocal(1, [0, 2, 0, 0, 0, 0, 1, 1, 1, 1]);
+const firstUpdate = hierarchy.update();
+const idleUpdate = hierarchy.update();
+const childX = hierarchy.world[16 + 12];
+hierarchy.setLocals(new Uint32Array([1]), new Float32Array([0, 3, 0, 0, 0, 0, 1, 1, 1, 1]));
+const childUpdate = hierarchy.update();
+if (firstUpdate !== 2 || idleUpdate !== 0 || childUpdate !== 1 || Math.abs(childX + 1) > 1e-6 || Math.abs(hierarchy.world[16 + 12] + 2) > 1e-6) {
+  fail(`TransformHierarchy updates ${firstUpdate}/${idleUpdate}/${childUpdate}, world ${Array.from(hierarchy.world)}`);
+}
+hierarchy.dispose();
+
+// Parallel mode must match the serial update on a hierarchy wide enough to be split.
+const wideParents = new Int32Array(20000).map((_, i) => (i === 0 ? -1 : (i - 1) >> 2));
+const serialTree = new addon.TransformHierarchy(wideParents);
+const parallelTree = new addon.TransformHierarchy(wideParents);
+for (const tree of [serialTree, parallelTree]) {
+  for (let i = 0; i < wideParents.length; i++) {
+    tree.setLocal(i, [1, i % 7, 0, 0, 0, Math.sin(i), Math.cos(i), 1, 1, 1]);
+  }
+}
+serialTree.update(false);
+parallelTree.update(true);
+if (!serialTree.world.every((v, i) => v === parallelTree.world[i])) {
+  fail('TransformHierarchy parallel update differs from serial');
+}
+serialTree.dispose();
+parallelTree.dispose();
+console.log('hierarchy child x:', childX.toFixed(6));
+
+// Straight down onto a unit box: hits the +y face (group 2) at t = 4.5, single and batched.
+const meshBvh = new addon.MeshBvh(addon.makeBox(1, 1, 1));
+const faceHit = meshBvh.raycast([0.1, 5, 0.2], [0, -1, 0]);
+const batch = meshBvh.raycastBatch(new Float32Array([0.1, 9, 5, 5, 0.2, 0, 0, 0, -1, -1, 0, 0]));
+if (!faceHit || faceHit.distance !== 4.5 || faceHit.materialIndex !== 2 || batch.triangle[0] !== faceHit.triangle || batch.triangle[1] !== 0xffffffff) {
+  fail(`MeshBvh raycast ${JSON.stringify(faceHit)}, batch ${Array.from(batch.triangle)}`);
+}
+meshBvh.dispose();
+console.log('MeshBvh hit triangle:', faceHit.triangle, 'material', faceHit.materialIndex);
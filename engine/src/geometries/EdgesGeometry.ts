@@ -0,0 +1,15 @@
+import { backend } from '../platform/backend.js';
+import type { MeshData } from '../platform/types.js';
+
+/**
+ * Sharp and boundary edges of a mesh as line segments (Three's EdgesGeometry).
+ * `vertices` holds two xyz points per edge; draw it as a line list.
+ */
+export class EdgesGeometry {
+  public readonly vertices: Float32Array;
+
+  constructor(mesh: Pick<MeshData, 'vertices' | 'indices'>, thresholdAngle = 1) {
+    const indices = mesh.indices.length > 0 ? mesh.indices : null;
+    this.vertices = backend.edgesGeometry(mesh.vertices, indices, thresholdAngle);
+  }
+}
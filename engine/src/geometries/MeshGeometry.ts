@@ -0,0 +1,31 @@
+import { backend } from '../platform/backend.js';
+import type { MeshData } from '../platform/types.js';
+
+/**
+ * Common shape of every backend-generated geometry: the flat typed arrays
+ * returned by the native/WASM generator, exposed as readonly fields.
+ */
+export class MeshGeometry {
+  public readonly vertices: Float32Array;
+  public readonly normals: Float32Array;
+  public readonly uvs: Float32Array;
+  public readonly indices: Uint32Array;
+  public readonly groups?: Array<{ start: number; count: number; materialIndex: number }>;
+
+  constructor(mesh: MeshData) {
+    this.vertices = mesh.vertices;
+    this.normals = mesh.normals;
+    this.uvs = mesh.uvs;
+    this.indices = mesh.indices;
+    this.groups = mesh.groups;
+  }
+
+  /**
+   * Transforms positions and normals in place, like Three's BufferGeometry.applyMatrix4
+   * (affine matrices only). `matrix` is column-major, e.g. Matrix4.elements.
+   */
+  applyMatrix4(matrix: ArrayLike<number>): this {
+    backend.transformMesh(this.vertices, this.normals.length > 0 ? this.normals : null, matrix);
+    return this;
+  }
+}
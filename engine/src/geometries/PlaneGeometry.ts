@@ -0,0 +1,27 @@
+import { backend } from '../platform/backend.js';
+import { MeshGeometry } from './MeshGeometry.js';
+
+export class PlaneGeometry extends MeshGeometry {
+  constructor(width = 1, height = 1, widthSegments = 1, heightSegments = 1) {
+    super(backend.makePlane(width, height, widthSegments, heightSegments));
+  }
+}
+
+export class CircleGeometry extends MeshGeometry {
+  constructor(radius = 1, segments = 32, thetaStart = 0, thetaLength = Math.PI * 2) {
+    super(backend.makeCircle(radius, segments, thetaStart, thetaLength));
+  }
+}
+
+export class RingGeometry extends MeshGeometry {
+  constructor(
+    innerRadius = 0.5,
+    outerRadius = 1,
+    thetaSegments = 32,
+    phiSegments = 1,
+    thetaStart = 0,
+    thetaLength = Math.PI * 2,
+  ) {
+    super(backend.makeRing(innerRadius, outerRadius, thetaSegments, phiSegments, thetaStart, thetaLength));
+  }
+}
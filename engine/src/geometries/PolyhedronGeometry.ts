@@ -0,0 +1,43 @@
+import { backend } from '../platform/backend.js';
+import { MeshGeometry } from './MeshGeometry.js';
+
+/**
+ * Projects the base faces onto a sphere of `radius`, subdividing each one
+ * `detail` times. Non-indexed, like Three's PolyhedronGeometry: `indices` is empty.
+ */
+export class PolyhedronGeometry extends MeshGeometry {
+  constructor(vertices: ArrayLike<number> = [], indices: ArrayLike<number> = [], radius = 1, detail = 0) {
+    super(
+      backend.makePolyhedron(
+        vertices instanceof Float32Array ? vertices : Float32Array.from(vertices),
+        indices instanceof Uint32Array ? indices : Uint32Array.from(indices),
+        radius,
+        detail,
+      ),
+    );
+  }
+}
+
+export class TetrahedronGeometry extends MeshGeometry {
+  constructor(radius = 1, detail = 0) {
+    super(backend.makeTetrahedron(radius, detail));
+  }
+}
+
+export class OctahedronGeometry extends MeshGeometry {
+  constructor(radius = 1, detail = 0) {
+    super(backend.makeOctahedron(radius, detail));
+  }
+}
+
+export class IcosahedronGeometry extends MeshGeometry {
+  constructor(radius = 1, detail = 0) {
+    super(backend.makeIcosahedron(radius, detail));
+  }
+}
+
+export class DodecahedronGeometry extends MeshGeometry {
+  constructor(radius = 1, detail = 0) {
+    super(backend.makeDodecahedron(radius, detail));
+  }
+}
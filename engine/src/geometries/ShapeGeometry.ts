@@ -0,0 +1,42 @@
+import { backend } from '../platform/backend.js';
+import type { ExtrudeOptions } from '../platform/types.js';
+import { MeshGeometry } from './MeshGeometry.js';
+
+/**
+ * Packs an xy contour and its holes into the flat layout the backend expects:
+ * one Float32Array with every ring back to back, plus each hole's start point.
+ */
+export function flattenPolygon(
+  contour: ArrayLike<number>,
+  holes: ReadonlyArray<ArrayLike<number>> = [],
+): { points: Float32Array; holeStarts: Uint32Array } {
+  let total = contour.length;
+  for (const hole of holes) total += hole.length;
+
+  const points = new Float32Array(total);
+  const holeStarts = new Uint32Array(holes.length);
+  points.set(contour, 0);
+  let offset = contour.length;
+  holes.forEach((hole, i) => {
+    holeStarts[i] = offset / 2;
+    points.set(hole, offset);
+    offset += hole.length;
+  });
+  return { points, holeStarts };
+}
+
+/** Flat triangulated shape in the XY plane (Three's ShapeGeometry for a single shape). */
+export class ShapeGeometry extends MeshGeometry {
+  constructor(contour: ArrayLike<number>, holes: ReadonlyArray<ArrayLike<number>> = []) {
+    const { points, holeStarts } = flattenPolygon(contour, holes);
+    super(backend.makeShape(points, holeStarts));
+  }
+}
+
+/** Straight extrusion along +Z with optional bevel (Three's ExtrudeGeometry without a path). */
+export class ExtrudeGeometry extends MeshGeometry {
+  constructor(contour: ArrayLike<number>, holes: ReadonlyArray<ArrayLike<number>> = [], options: ExtrudeOptions = {}) {
+    const { points, holeStarts } = flattenPolygon(contour, holes);
+    super(backend.makeExtrude(points, holeStarts, options));
+  }
+}
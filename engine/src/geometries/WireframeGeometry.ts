@@ -0,0 +1,18 @@
+import { backend } from '../platform/backend.js';
+import type { MeshData } from '../platform/types.js';
+
+/**
+ * Every unique triangle edge of a mesh (Three's WireframeGeometry): edges are unique by
+ * vertex position, so split and non-indexed vertices share them. Shares the source
+ * `vertices`; `indices` holds two vertex indices per edge, drawn as a line list.
+ */
+export class WireframeGeometry {
+  public readonly vertices: Float32Array;
+  public readonly indices: Uint32Array;
+
+  constructor(mesh: Pick<MeshData, 'vertices' | 'indices'>) {
+    const indices = mesh.indices.length > 0 ? mesh.indices : null;
+    this.vertices = mesh.vertices;
+    this.indices = backend.wireframeIndices(mesh.vertices, indices);
+  }
+}
@@ -1 +1,7 @@
+export * from './MeshGeometry.js';
 export * from './BoxGeometry.js';
+export * from './PlaneGeometry.js';
+export * from './PolyhedronGeometry.js';
+export * from './ShapeGeometry.js';
+export * from './EdgesGeometry.js';
+export * from './WireframeGeometry.js';
@@ -1,4 +1,18 @@
-import type { GeometryBackend, MeshData } from './types.js';
+import type {
+  AffineKind,
+  BoxBvh,
+  BvhBuilder,
+  ExtrudeOptions,
+  GeometryBackend,
+  IcpRegistration,
+  MeshBvh,
+  MeshData,
+  PointGrid,
+  RotationFormat,
+  SweepAndPrune,
+  TransformHierarchy,
+  UmeyamaAccumulator,
+} from './types.js';
 
 /**
  * Expects a wasm loader at:
@@ -14,5 +28,194 @@ export async function createBrowserBackend(): Promise<GeometryBackend> {
     makeBox(w: number, h: number, d: number): MeshData {
       return wasm.makeBox(w, h, d);
     },
+    makePlane(width: number, height: number, widthSegments: number, heightSegments: number): MeshData {
+      return wasm.makePlane(width, height, widthSegments, heightSegments);
+    },
+    makeCircle(radius: number, segments: number, thetaStart: number, thetaLength: number): MeshData {
+      return wasm.makeCircle(radius, segments, thetaStart, thetaLength);
+    },
+    makeRing(
+      innerRadius: number,
+      outerRadius: number,
+      thetaSegments: number,
+      phiSegments: number,
+      thetaStart: number,
+      thetaLength: number,
+    ): MeshData {
+      return wasm.makeRing(innerRadius, outerRadius, thetaSegments, phiSegments, thetaStart, thetaLength);
+    },
+    makePolyhedron(vertices: Float32Array, indices: Uint32Array, radius: number, detail: number): MeshData {
+      return wasm.makePolyhedron(vertices, indices, radius, detail);
+    },
+    makeTetrahedron(radius: number, detail: number): MeshData {
+      return wasm.makeTetrahedron(radius, detail);
+    },
+    makeOctahedron(radius: number, detail: number): MeshData {
+      return wasm.makeOctahedron(radius, detail);
+    },
+    makeIcosahedron(radius: number, detail: number): MeshData {
+      return wasm.makeIcosahedron(radius, detail);
+    },
+    makeDodecahedron(radius: number, detail: number): MeshData {
+      return wasm.makeDodecahedron(radius, detail);
+    },
+    triangulate(points: Float32Array, holeStarts?: Uint32Array): Uint32Array {
+      return wasm.triangulate(points, holeStarts);
+    },
+    makeShape(points: Float32Array, holeStarts?: Uint32Array): MeshData {
+      return wasm.makeShape(points, holeStarts);
+    },
+    makeExtrude(points: Float32Array, holeStarts?: Uint32Array, options?: ExtrudeOptions): MeshData {
+      return wasm.makeExtrude(points, holeStarts, options);
+    },
+    edgesGeometry(positions: Float32Array, indices: Uint32Array | null, thresholdAngle: number): Float32Array {
+      return wasm.edgesGeometry(positions, indices, thresholdAngle);
+    },
+    wireframeIndices(positions: Float32Array, indices: Uint32Array | null): Uint32Array {
+      return wasm.wireframeIndices(positions, indices);
+    },
+    quatMultiplyBatch(a: Float32Array, b: Float32Array, out: Float32Array | null): Float32Array {
+      return wasm.quatMultiplyBatch(a, b, out);
+    },
+    quatSlerpBatch(a: Float32Array, b: Float32Array, t: number | Float32Array, out: Float32Array | null): Float32Array {
+      return wasm.quatSlerpBatch(a, b, t, out);
+    },
+    quatNlerpBatch(a: Float32Array, b: Float32Array, t: number | Float32Array, out: Float32Array | null): Float32Array {
+      return wasm.quatNlerpBatch(a, b, t, out);
+    },
+    quatToEulerBatch(quats: Float32Array, axes: ArrayLike<number>, out: Float32Array | null): Float32Array {
+      return wasm.quatToEulerBatch(quats, axes, out);
+    },
+    eulerToQuatBatch(angles: Float32Array, axes: ArrayLike<number>, out: Float32Array | null): Float32Array {
+      return wasm.eulerToQuatBatch(angles, axes, out);
+    },
+    convertRotationBatch(
+      input: Float32Array,
+      from: RotationFormat,
+      to: RotationFormat,
+      out: Float32Array | null,
+    ): Float32Array {
+      return wasm.convertRotationBatch(input, from, to, out);
+    },
+    invertAffineBatch(matrices: Float32Array, kind: AffineKind, out: Float32Array | null): Float32Array {
+      return wasm.invertAffineBatch(matrices, kind, out);
+    },
+    transformMesh(vertices: Float32Array, normals: Float32Array | null, matrix: ArrayLike<number>): void {
+      wasm.transformMesh(vertices, normals, matrix);
+    },
+    skinLbs(
+      positions: Float32Array,
+      normals: Float32Array | null,
+      skinIndex: Uint16Array,
+      skinWeight: Float32Array,
+      boneMatrices: Float32Array,
+      outPositions: Float32Array,
+      outNormals: Float32Array | null,
+    ): void {
+      wasm.skinLbs(positions, normals, skinIndex, skinWeight, boneMatrices, outPositions, outNormals);
+    },
+    skinDqs(
+      positions: Float32Array,
+      normals: Float32Array | null,
+      skinIndex: Uint16Array,
+      skinWeight: Float32Array,
+      boneMatrices: Float32Array,
+      outPositions: Float32Array,
+      outNormals: Float32Array | null,
+    ): void {
+      wasm.skinDqs(positions, normals, skinIndex, skinWeight, boneMatrices, outPositions, outNormals);
+    },
+    transformBoxes(boxes: Float32Array, matrices: Float32Array, out: Float32Array | null): Float32Array {
+      return wasm.transformBoxes(boxes, matrices, out);
+    },
+    frustumPlanes(projectionView: ArrayLike<number>): Float32Array {
+      return wasm.frustumPlanes(projectionView);
+    },
+    cullBoxes(planes: Float32Array, boxes: Float32Array, out: Uint32Array | null): Uint32Array {
+      return wasm.cullBoxes(planes, boxes, out);
+    },
+    createBoxBvh(boxes: Float32Array, builder: BvhBuilder = 'sah'): BoxBvh {
+      const bvh = new wasm.BoxBvh(boxes, builder);
+      return {
+        get size() {
+          return bvh.size;
+        },
+        refit: (b) => bvh.refit(b),
+        raycast: (origin, direction, maxDistance) => bvh.raycast(origin, direction, maxDistance),
+        overlap: (min, max) => bvh.overlap(min, max),
+        nearest: (point, maxDistance) => bvh.nearest(point, maxDistance),
+        dispose: () => bvh.delete(),
+      };
+    },
+    createMeshBvh(mesh: MeshData): MeshBvh {
+      const bvh = new wasm.MeshBvh(mesh);
+      return {
+        get triangleCount() {
+          return bvh.triangleCount;
+        },
+        raycast: (origin, direction, maxDistance) => bvh.raycast(origin, direction, maxDistance),
+        raycastBatch: (rays, maxDistance) => bvh.raycastBatch(rays, maxDistance),
+        dispose: () => bvh.delete(),
+      };
+    },
+    createSweepAndPrune(axis: 0 | 1 | 2 = 0): SweepAndPrune {
+      const sap = new wasm.SweepAndPrune(axis);
+      return {
+        get size() {
+          return sap.size;
+        },
+        update: (boxes) => sap.update(boxes),
+        pairs: () => sap.pairs(),
+        dispose: () => sap.delete(),
+      };
+    },
+    createPointGrid(points: Float32Array, cellSize: number): PointGrid {
+      const grid = new wasm.PointGrid(points, cellSize);
+      return {
+        get size() {
+          return grid.size;
+        },
+        radius: (center, radius) => grid.radius(center, radius),
+        nearest: (center, k, maxDistance = Infinity) => grid.nearest(center, k, maxDistance),
+        dispose: () => grid.delete(),
+      };
+    },
+    createUmeyamaAccumulator(): UmeyamaAccumulator {
+      const acc = new wasm.UmeyamaAccumulator();
+      return {
+        get count() {
+          return acc.count;
+        },
+        add: (src, dst) => acc.add(src, dst),
+        clear: () => acc.clear(),
+        solve: (withScaling = true) => acc.solve(withScaling),
+        dispose: () => acc.delete(),
+      };
+    },
+    createIcpRegistration(target: Float32Array): IcpRegistration {
+      const icp = new wasm.IcpRegistration(target);
+      return {
+        get size() {
+          return icp.size;
+        },
+        align: (source, options) => icp.align(source, options),
+        dispose: () => icp.delete(),
+      };
+    },
+    createTransformHierarchy(parents: Int32Array): TransformHierarchy {
+      const hierarchy = new wasm.TransformHierarchy(parents);
+      return {
+        get size() {
+          return hierarchy.size;
+        },
+        get world() {
+          return hierarchy.world;
+        },
+        setLocal: (index, trs) => hierarchy.setLocal(index, trs),
+        setLocals: (indices, trs) => hierarchy.setLocals(indices, trs),
+        update: (parallel = false) => hierarchy.update(parallel),
+        dispose: () => hierarchy.delete(),
+      };
+    },
   };
 }
@@ -1,17 +1,165 @@
 import { createRequire } from 'node:module';
-import type { GeometryBackend, MeshData } from './types.js';
+import type {
+  AffineKind,
+  BoxBvh,
+  BvhBuilder,
+  ExtrudeOptions,
+  GeometryBackend,
+  IcpRegistration,
+  MeshBvh,
+  MeshData,
+  PointGrid,
+  RotationFormat,
+  SweepAndPrune,
+  TransformHierarchy,
+  UmeyamaAccumulator,
+} from './types.js';
 
 const require = createRequire(import.meta.url);
 
 // Built by: `npm run native:build` (from engine/)
 // Output: engine/native/build/Release/geometry.node
 // eslint-disable-next-line @typescript-eslint/no-var-requires
-const native = require('../../native/build/Release/geometry.node') as {
-  makeBox(w: number, h: number, d: number): MeshData;
+// Native classes are exported next to the functions and wrapped by the create* factories.
+const native = require('../../native/build/Release/geometry.node') as GeometryBackend & {
+  BoxBvh: new (boxes: Float32Array, builder?: BvhBuilder) => BoxBvh;
+  MeshBvh: new (mesh: MeshData) => MeshBvh;
+  SweepAndPrune: new (axis?: number) => SweepAndPrune;
+  PointGrid: new (points: Float32Array, cellSize: number) => PointGrid;
+  UmeyamaAccumulator: new () => UmeyamaAccumulator;
+  IcpRegistration: new (target: Float32Array) => IcpRegistration;
+  TransformHierarchy: new (parents: Int32Array) => TransformHierarchy;
 };
 
 export const backendNode: GeometryBackend = {
   makeBox(w: number, h: number, d: number): MeshData {
     return native.makeBox(w, h, d);
   },
+  makePlane(width: number, height: number, widthSegments: number, heightSegments: number): MeshData {
+    return native.makePlane(width, height, widthSegments, heightSegments);
+  },
+  makeCircle(radius: number, segments: number, thetaStart: number, thetaLength: number): MeshData {
+    return native.makeCircle(radius, segments, thetaStart, thetaLength);
+  },
+  makeRing(
+    innerRadius: number,
+    outerRadius: number,
+    thetaSegments: number,
+    phiSegments: number,
+    thetaStart: number,
+    thetaLength: number,
+  ): MeshData {
+    return native.makeRing(innerRadius, outerRadius, thetaSegments, phiSegments, thetaStart, thetaLength);
+  },
+  makePolyhedron(vertices: Float32Array, indices: Uint32Array, radius: number, detail: number): MeshData {
+    return native.makePolyhedron(vertices, indices, radius, detail);
+  },
+  makeTetrahedron(radius: number, detail: number): MeshData {
+    return native.makeTetrahedron(radius, detail);
+  },
+  makeOctahedron(radius: number, detail: number): MeshData {
+    return native.makeOctahedron(radius, detail);
+  },
+  makeIcosahedron(radius: number, detail: number): MeshData {
+    return native.makeIcosahedron(radius, detail);
+  },
+  makeDodecahedron(radius: number, detail: number): MeshData {
+    return native.makeDodecahedron(radius, detail);
+  },
+  triangulate(points: Float32Array, holeStarts?: Uint32Array): Uint32Array {
+    return native.triangulate(points, holeStarts);
+  },
+  makeShape(points: Float32Array, holeStarts?: Uint32Array): MeshData {
+    return native.makeShape(points, holeStarts);
+  },
+  makeExtrude(points: Float32Array, holeStarts?: Uint32Array, options?: ExtrudeOptions): MeshData {
+    return native.makeExtrude(points, holeStarts, options);
+  },
+  edgesGeometry(positions: Float32Array, indices: Uint32Array | null, thresholdAngle: number): Float32Array {
+    return native.edgesGeometry(positions, indices, thresholdAngle);
+  },
+  wireframeIndices(positions: Float32Array, indices: Uint32Array | null): Uint32Array {
+    return native.wireframeIndices(positions, indices);
+  },
+  quatMultiplyBatch(a: Float32Array, b: Float32Array, out: Float32Array | null): Float32Array {
+    return native.quatMultiplyBatch(a, b, out);
+  },
+  quatSlerpBatch(a: Float32Array, b: Float32Array, t: number | Float32Array, out: Float32Array | null): Float32Array {
+    return native.quatSlerpBatch(a, b, t, out);
+  },
+  quatNlerpBatch(a: Float32Array, b: Float32Array, t: number | Float32Array, out: Float32Array | null): Float32Array {
+    return native.quatNlerpBatch(a, b, t, out);
+  },
+  quatToEulerBatch(quats: Float32Array, axes: ArrayLike<number>, out: Float32Array | null): Float32Array {
+    return native.quatToEulerBatch(quats, axes, out);
+  },
+  eulerToQuatBatch(angles: Float32Array, axes: ArrayLike<number>, out: Float32Array | null): Float32Array {
+    return native.eulerToQuatBatch(angles, axes, out);
+  },
+  convertRotationBatch(
+    input: Float32Array,
+    from: RotationFormat,
+    to: RotationFormat,
+    out: Float32Array | null,
+  ): Float32Array {
+    return native.convertRotationBatch(input, from, to, out);
+  },
+  invertAffineBatch(matrices: Float32Array, kind: AffineKind, out: Float32Array | null): Float32Array {
+    return native.invertAffineBatch(matrices, kind, out);
+  },
+  transformMesh(vertices: Float32Array, normals: Float32Array | null, matrix: ArrayLike<number>): void {
+    native.transformMesh(vertices, normals, matrix);
+  },
+  skinLbs(
+    positions: Float32Array,
+    normals: Float32Array | null,
+    skinIndex: Uint16Array,
+    skinWeight: Float32Array,
+    boneMatrices: Float32Array,
+    outPositions: Float32Array,
+    outNormals: Float32Array | null,
+  ): void {
+    native.skinLbs(positions, normals, skinIndex, skinWeight, boneMatrices, outPositions, outNormals);
+  },
+  skinDqs(
+    positions: Float32Array,
+    normals: Float32Array | null,
+    skinIndex: Uint16Array,
+    skinWeight: Float32Array,
+    boneMatrices: Float32Array,
+    outPositions: Float32Array,
+    outNormals: Float32Array | null,
+  ): void {
+    native.skinDqs(positions, normals, skinIndex, skinWeight, boneMatrices, outPositions, outNormals);
+  },
+  transformBoxes(boxes: Float32Array, matrices: Float32Array, out: Float32Array | null): Float32Array {
+    return native.transformBoxes(boxes, matrices, out);
+  },
+  frustumPlanes(projectionView: ArrayLike<number>): Float32Array {
+    return native.frustumPlanes(projectionView);
+  },
+  cullBoxes(planes: Float32Array, boxes: Float32Array, out: Uint32Array | null): Uint32Array {
+    return native.cullBoxes(planes, boxes, out);
+  },
+  createBoxBvh(boxes: Float32Array, builder: BvhBuilder = 'sah'): BoxBvh {
+    return new native.BoxBvh(boxes, builder);
+  },
+  createMeshBvh(mesh: MeshData): MeshBvh {
+    return new native.MeshBvh(mesh);
+  },
+  createSweepAndPrune(axis: 0 | 1 | 2 = 0): SweepAndPrune {
+    return new native.SweepAndPrune(axis);
+  },
+  createPointGrid(points: Float32Array, cellSize: number): PointGrid {
+    return new native.PointGrid(points, cellSize);
+  },
+  createUmeyamaAccumulator(): UmeyamaAccumulator {
+    return new native.UmeyamaAccumulator();
+  },
+  createIcpRegistration(target: Float32Array): IcpRegistration {
+    return new native.IcpRegistration(target);
+  },
+  createTransformHierarchy(parents: Int32Array): TransformHierarchy {
+    return new native.TransformHierarchy(parents);
+  },
 };
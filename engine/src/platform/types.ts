@@ -10,6 +10,256 @@ export type MeshData = {
   groups?: Array<{ start: number; count: number; materialIndex: number }>;
 };
 
+// Three's ExtrudeGeometry options minus extrudePath/curveSegments/UVGenerator.
+// `steps` (>= 1) and `bevelSegments` (>= 0) are at most 4096; larger values throw a RangeError.
+export type ExtrudeOptions = {
+  steps?: number;
+  depth?: number;
+  bevelEnabled?: boolean;
+  bevelThickness?: number;
+  bevelSize?: number;
+  bevelOffset?: number;
+  bevelSegments?: number;
+};
+
+export type RayHit = { index: number; distance: number };
+
+// 'sah': binned surface-area heuristic; the better tree for static or clustered scenes.
+// 'lbvh': Morton-code linear BVH built on worker threads, ~3x faster to build even on
+// one thread; meant for scenes rebuilt every frame.
+export type BvhBuilder = 'sah' | 'lbvh';
+
+// Planar rotation blocks for convertRotationBatch: 'quaternion' [x..., y..., z..., w...],
+// 'angleAxis' [x..., y..., z..., angle...] (unit axis), 'matrix3' [m00..., m10..., m20...,
+// m01..., ...] (column-major like Matrix3.elements).
+export type RotationFormat = 'quaternion' | 'angleAxis' | 'matrix3';
+
+// What invertAffineBatch may assume about every matrix: 'isometry' (rotation + translation,
+// the rotation is transposed), 'uniformScale' (rotation scaled equally on all axes) or
+// 'general' (any invertible affine matrix).
+export type AffineKind = 'isometry' | 'uniformScale' | 'general';
+
+// BVH over planar SoA boxes (same layout as transformBoxes/cullBoxes). Boxes that are
+// empty at build time are never reported. Owns native memory: call dispose() when done.
+export type BoxBvh = {
+  readonly size: number;
+  // Moved boxes, same count and order as at construction; keeps the tree topology.
+  refit(boxes: Float32Array): void;
+  // Nearest box entered by origin + t * direction, t in [0, maxDistance] (units of |direction|).
+  raycast(origin: ArrayLike<number>, direction: ArrayLike<number>, maxDistance: number): RayHit | null;
+  // Indices of all boxes intersecting [min, max].
+  overlap(min: ArrayLike<number>, max: ArrayLike<number>): Uint32Array;
+  // Closest box to `point` (distance 0 inside) within maxDistance.
+  nearest(point: ArrayLike<number>, maxDistance: number): RayHit | null;
+  dispose(): void;
+};
+
+// u, v: barycentric weights of the triangle's 2nd and 3rd vertex (the 1st gets 1 - u - v).
+export type MeshHit = { triangle: number; distance: number; u: number; v: number; materialIndex: number };
+
+export type MeshHitBatch = {
+  triangle: Uint32Array; // 0xffffffff where the ray missed
+  distance: Float32Array;
+  u: Float32Array;
+  v: Float32Array;
+  materialIndex: Uint32Array;
+};
+
+// Triangle BVH over one mesh (copied at construction; double-sided). `triangle` is the
+// triangle number (first index / 3); materialIndex comes from the group containing it.
+export type MeshBvh = {
+  readonly triangleCount: number;
+  raycast(origin: ArrayLike<number>, direction: ArrayLike<number>, maxDistance: number): MeshHit | null;
+  // Rays as planar [ox..., oy..., oz..., dx..., dy..., dz...], traced in SIMD packets.
+  raycastBatch(rays: Float32Array, maxDistance: number): MeshHitBatch;
+  dispose(): void;
+};
+
+// Incremental sweep-and-prune broadphase over planar SoA boxes (same layout as BoxBvh),
+// for many boxes that move a little per frame. Owns native memory: call dispose() when done.
+export type SweepAndPrune = {
+  readonly size: number;
+  // Pairs (a < b, sorted) that started / stopped overlapping since the last update, as
+  // [addedCount, removedCount, a0, b0, ...added..., ...removed...]. A changed box count
+  // keeps pairs keyed by index.
+  update(boxes: Float32Array): Uint32Array;
+  // Pairs overlapping as of the last update: [a0, b0, a1, b1, ...].
+  pairs(): Uint32Array;
+  dispose(): void;
+};
+
+// Uniform spatial hash grid over xyz points (e.g. MeshData.vertices) for neighbour queries.
+// The points are copied. Owns native memory: call dispose() when done.
+export type PointGrid = {
+  readonly size: number;
+  // Indices of the points within `radius` of `center` (inclusive), unordered.
+  radius(center: ArrayLike<number>, radius: number): Uint32Array;
+  // Up to k nearest points within maxDistance (default Infinity), nearest first.
+  nearest(
+    center: ArrayLike<number>,
+    k: number,
+    maxDistance?: number,
+  ): { index: Uint32Array; distance: Float32Array };
+  dispose(): void;
+};
+
+// Streaming Umeyama alignment: feed src/dst correspondences (xyz Float32Arrays of equal
+// length) in chunks of any size, then solve for the similarity transform src -> dst.
+// Only running means and covariances are kept. Owns native memory: call dispose() when done.
+export type UmeyamaAccumulator = {
+  readonly count: number;
+  add(src: Float32Array, dst: Float32Array): void;
+  clear(): void;
+  // Column-major 4x4 [c*R t; 0 1] (Matrix4.elements layout); scale c = 1 unless withScaling
+  // (default true). Identity before any pairs were added.
+  solve(withScaling?: boolean): Float32Array;
+  dispose(): void;
+};
+
+export type IcpOptions = {
+  maxIterations?: number; // default 30
+  maxDistance?: number; // correspondences farther apart are dropped; default Infinity
+  inlierFraction?: number; // keep this closest fraction of the pairs, in (0, 1]; default 0.9
+  tolerance?: number; // stop when the RMS error improves by less than this fraction; default 1e-5
+  withScaling?: boolean; // default false (rigid)
+  initial?: ArrayLike<number>; // column-major 4x4 starting guess; default identity
+};
+
+export type IcpIteration = {
+  pairs: number; // correspondences used in this iteration's solve
+  rmsError: number; // their RMS distance, before this iteration's update
+  correspondenceMs: number;
+  solveMs: number;
+};
+
+export type IcpResult = {
+  matrix: Float32Array; // column-major 4x4 mapping source onto target
+  converged: boolean;
+  iterations: IcpIteration[];
+};
+
+// Point-to-point ICP against a fixed target point cloud (k-d tree built once, reused
+// by every align()). Owns native memory: call dispose() when done.
+export type IcpRegistration = {
+  readonly size: number;
+  align(source: Float32Array, options?: IcpOptions): IcpResult;
+  dispose(): void;
+};
+
+// World transforms of a scene graph whose nodes are topologically sorted (parents[i] < i,
+// -1 for roots). Local transforms are translation, rotation (unit quaternion) and scale
+// composed as T * R * S; only nodes set since the last update() and their descendants are
+// recomputed. `world` holds a column-major 4x4 per node (16 floats at index * 16) and is
+// written in place by update(); on the browser backend it is re-fetched on every access,
+// so don't keep it across frames. Owns native memory: call dispose() when done.
+export type TransformHierarchy = {
+  readonly size: number;
+  readonly world: Float32Array;
+  // trs: [tx, ty, tz, qx, qy, qz, qw, sx, sy, sz]
+  setLocal(index: number, trs: ArrayLike<number>): void;
+  // 10 floats of trs per entry of `indices`.
+  setLocals(indices: Uint32Array, trs: Float32Array): void;
+  // Returns the number of world matrices recomputed. `parallel` splits each depth level of
+  // the hierarchy over the worker pool; it pays off for large, wide hierarchies only.
+  update(parallel?: boolean): number;
+  dispose(): void;
+};
+
 export type GeometryBackend = {
   makeBox(w: number, h: number, d: number): MeshData;
+  // Flat XY primitives facing +Z, indexed, no groups (Three's Plane/Circle/RingGeometry).
+  makePlane(width: number, height: number, widthSegments: number, heightSegments: number): MeshData;
+  makeCircle(radius: number, segments: number, thetaStart: number, thetaLength: number): MeshData;
+  makeRing(
+    innerRadius: number,
+    outerRadius: number,
+    thetaSegments: number,
+    phiSegments: number,
+    thetaStart: number,
+    thetaLength: number,
+  ): MeshData;
+  // Polyhedra are non-indexed (empty `indices`, no groups), matching Three.
+  makePolyhedron(vertices: Float32Array, indices: Uint32Array, radius: number, detail: number): MeshData;
+  makeTetrahedron(radius: number, detail: number): MeshData;
+  makeOctahedron(radius: number, detail: number): MeshData;
+  makeIcosahedron(radius: number, detail: number): MeshData;
+  makeDodecahedron(radius: number, detail: number): MeshData;
+  // Polygons: flat xy points (outer contour, then holes) + the point index where each hole starts.
+  triangulate(points: Float32Array, holeStarts?: Uint32Array): Uint32Array;
+  makeShape(points: Float32Array, holeStarts?: Uint32Array): MeshData;
+  makeExtrude(points: Float32Array, holeStarts?: Uint32Array, options?: ExtrudeOptions): MeshData;
+  // Line-segment positions (xyz xyz per edge) of the sharp + boundary edges; null indices = triangle soup.
+  edgesGeometry(positions: Float32Array, indices: Uint32Array | null, thresholdAngle: number): Float32Array;
+  // Unique triangle edges as vertex index pairs (line list); null indices = triangle soup.
+  wireframeIndices(positions: Float32Array, indices: Uint32Array | null): Uint32Array;
+  // Batched quaternions are planar SoA blocks: [x0..xn-1, y0..yn-1, z0..zn-1, w0..wn-1].
+  // `out` (same length, may be an input) is filled in place; null allocates a new array.
+  quatMultiplyBatch(a: Float32Array, b: Float32Array, out: Float32Array | null): Float32Array;
+  // `t`: one weight for the whole batch, or a Float32Array with one weight per quaternion.
+  quatSlerpBatch(a: Float32Array, b: Float32Array, t: number | Float32Array, out: Float32Array | null): Float32Array;
+  quatNlerpBatch(a: Float32Array, b: Float32Array, t: number | Float32Array, out: Float32Array | null): Float32Array;
+  // Euler angles are planar [e0..., e1..., e2...] for the axis convention `axes` = [a0, a1, a2]
+  // (0 = x, 1 = y, 2 = z; a1 differs from a0 and a2), as in Eigen's eulerAngles(a0, a1, a2):
+  // q == AngleAxis(e0, a0) * AngleAxis(e1, a1) * AngleAxis(e2, a2). e0 is in [0, pi].
+  quatToEulerBatch(quats: Float32Array, axes: ArrayLike<number>, out: Float32Array | null): Float32Array;
+  eulerToQuatBatch(angles: Float32Array, axes: ArrayLike<number>, out: Float32Array | null): Float32Array;
+  // Converts every rotation of a planar block with Eigen's conventions (AngleAxis angles in
+  // [0, pi]). `out` may be `input` between 'quaternion' and 'angleAxis' (both 4 floats).
+  convertRotationBatch(
+    input: Float32Array,
+    from: RotationFormat,
+    to: RotationFormat,
+    out: Float32Array | null,
+  ): Float32Array;
+  // Inverses of column-major 4x4 affine matrices (16 floats each, bottom row ignored);
+  // `out` may be `matrices` itself.
+  invertAffineBatch(matrices: Float32Array, kind: AffineKind, out: Float32Array | null): Float32Array;
+  // In place: positions by the affine part of `matrix` (16 numbers, column-major like
+  // Matrix4.elements), normals by its normal matrix, renormalized.
+  transformMesh(vertices: Float32Array, normals: Float32Array | null, matrix: ArrayLike<number>): void;
+  // Linear blend skinning into caller-owned outputs (same length as the inputs, which they may
+  // be). skinIndex / skinWeight hold 4 entries per vertex like Three's attributes; weights
+  // are used as given. boneMatrices holds one column-major 4x4 per bone (e.g.
+  // Skeleton.boneMatrices premultiplied as needed). Normals are renormalized. On the browser
+  // backend, arrays that are views into the wasm heap are read and written without copies.
+  skinLbs(
+    positions: Float32Array,
+    normals: Float32Array | null,
+    skinIndex: Uint16Array,
+    skinWeight: Float32Array,
+    boneMatrices: Float32Array,
+    outPositions: Float32Array,
+    outNormals: Float32Array | null,
+  ): void;
+  // Dual-quaternion skinning with skinLbs's arguments: no candy-wrapper collapse at twisting
+  // joints. Bone matrices must be rigid (rotation + translation); normals are rotated only.
+  skinDqs(
+    positions: Float32Array,
+    normals: Float32Array | null,
+    skinIndex: Uint16Array,
+    skinWeight: Float32Array,
+    boneMatrices: Float32Array,
+    outPositions: Float32Array,
+    outNormals: Float32Array | null,
+  ): void;
+  // Boxes are planar SoA blocks [minX..., minY..., minZ..., maxX..., maxY..., maxZ...];
+  // `matrices` holds one column-major 4x4 per box (InstancedMesh.instanceMatrix layout).
+  // Returns the world AABBs; empty boxes (min > max) pass through unchanged.
+  transformBoxes(boxes: Float32Array, matrices: Float32Array, out: Float32Array | null): Float32Array;
+  // Six normalized inward planes (nx, ny, nz, d each) from projection * view, ordered
+  // like Three's Frustum: right, left, bottom, top, far, near.
+  frustumPlanes(projectionView: ArrayLike<number>): Float32Array;
+  // Visibility bitmask: bit (i % 32) of word (i / 32) is set when box i is (partly) inside.
+  // `out`, if given, must hold ceil(boxCount / 32) words.
+  cullBoxes(planes: Float32Array, boxes: Float32Array, out: Uint32Array | null): Uint32Array;
+  // BVH for picking / proximity queries over scene object bounds (builder defaults to 'sah').
+  createBoxBvh(boxes: Float32Array, builder?: BvhBuilder): BoxBvh;
+  createMeshBvh(mesh: MeshData): MeshBvh;
+  // `axis` (default 0 = x): the primary sweep axis, best along the widest spread of boxes.
+  createSweepAndPrune(axis?: 0 | 1 | 2): SweepAndPrune;
+  // cellSize (> 0) should be close to the usual query radius.
+  createPointGrid(points: Float32Array, cellSize: number): PointGrid;
+  createUmeyamaAccumulator(): UmeyamaAccumulator;
+  createIcpRegistration(target: Float32Array): IcpRegistration;
+  createTransformHierarchy(parents: Int32Array): TransformHierarchy;
 };
@@ -1,25 +1,84 @@
 #include <emscripten/bind.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../native/affine_batch.h"
+#include "../native/bounds.h"
+#include "../native/broadphase.h"
+#include "../native/bvh.h"
+#include "../native/dual_quat.h"
+#include "../native/edges.h"
+#include "../native/euler_batch.h"
 #include "../native/geometry_lib.h"
+#include "../native/icp.h"
+#include "../native/lbvh.h"
+#include "../native/mesh_bvh.h"
+#include "../native/mesh_transform.h"
+#include "../native/point_grid.h"
+#include "../native/polyhedron.h"
+#include "../native/quat_batch.h"
+#include "../native/rotation_batch.h"
+#include "../native/skinning.h"
+#include "../native/transform_hierarchy.h"
+#include "../native/triangulate.h"
+#include "../native/umeyama.h"
+#include "../native/wireframe.h"
 
 using namespace emscripten;
 
-val makeBox(float w, float h, float d) {
-  MeshDataCpp mesh = make_box(w, h, d);
+// Copies a JS typed array (or plain array) into a native vector.
+template <typename T>
+static std::vector<T> fromTypedArray(const val& array) {
+  return convertJSArrayToNumberVector<T>(array);
+}
+
+// `new Float32Array(view)` copies out of the wasm heap, so the result stays
+// valid after `v` is destroyed or the heap grows.
+static val toFloat32Array(const std::vector<float>& v) {
+  return val::global("Float32Array").new_(typed_memory_view(v.size(), v.data()));
+}
+
+static val toUint32Array(const std::vector<uint32_t>& v) {
+  return val::global("Uint32Array").new_(typed_memory_view(v.size(), v.data()));
+}
+
+// Missing/null/undefined optional typed arrays read as empty.
+template <typename T>
+static std::vector<T> fromOptionalTypedArray(const val& array) {
+  if (array.isUndefined() || array.isNull()) {
+    return {};
+  }
+  return fromTypedArray<T>(array);
+}
+
+template <typename T>
+static T optionalNumber(const val& obj, const char* name, T fallback) {
+  const val v = obj[name];
+  return v.isUndefined() ? fallback : v.as<T>();
+}
+
+[[noreturn]] static void throwTypeError(const char* message) {
+  val::global("TypeError").new_(std::string(message)).throw_();
+}
 
-  val vertices = val::global("Float32Array").new_(
-      typed_memory_view(mesh.vertices.size(), mesh.vertices.data()));
-  val normals = val::global("Float32Array").new_(
-      typed_memory_view(mesh.normals.size(), mesh.normals.data()));
-  val uvs = val::global("Float32Array").new_(
-      typed_memory_view(mesh.uvs.size(), mesh.uvs.data()));
-  val indices = val::global("Uint32Array").new_(
-      typed_memory_view(mesh.indices.size(), mesh.indices.data()));
+// Batch kernels either fill a caller-provided Float32Array (`out`, same length
+// as the input) or return a new one when `out` is null/undefined.
+static val toOutputFloat32Array(const std::vector<float>& v, const val& out) {
+  if (out.isUndefined() || out.isNull()) {
+    return toFloat32Array(v);
+  }
+  out.call<void>("set", typed_memory_view(v.size(), v.data()));
+  return out;
+}
 
+static val meshToVal(const MeshDataCpp& mesh) {
   val out = val::object();
-  out.set("vertices", vertices);
-  out.set("normals", normals);
-  out.set("uvs", uvs);
-  out.set("indices", indices);
+  out.set("vertices", toFloat32Array(mesh.vertices));
+  out.set("normals", toFloat32Array(mesh.normals));
+  out.set("uvs", toFloat32Array(mesh.uvs));
+  out.set("indices", toUint32Array(mesh.indices));
 
   val groups = val::array();
   for (size_t i = 0; i < mesh.groups.size(); i++) {
@@ -34,6 +93,880 @@ val makeBox(float w, float h, float d) {
   return out;
 }
 
+val makeBox(float w, float h, float d) {
+  return meshToVal(make_box(w, h, d));
+}
+
+val makePlane(float width, float height, uint32_t widthSegments, uint32_t heightSegments) {
+  return meshToVal(make_plane(width, height, widthSegments, heightSegments));
+}
+
+val makeCircle(float radius, uint32_t segments, float thetaStart, float thetaLength) {
+  return meshToVal(make_circle(radius, segments, thetaStart, thetaLength));
+}
+
+val makeRing(
+    float innerRadius,
+    float outerRadius,
+    uint32_t thetaSegments,
+    uint32_t phiSegments,
+    float thetaStart,
+    float thetaLength) {
+  return meshToVal(make_ring(innerRadius, outerRadius, thetaSegments, phiSegments, thetaStart, thetaLength));
+}
+
+// Same check and message as the N-API CheckPolyhedronSize. Negative JS
+// details arrive wrapped to large uint32 values and are rejected too.
+static void checkPolyhedronSize(const char* name, size_t faceCount, uint32_t detail) {
+  uint64_t count;
+  if (!polyhedron_vertex_count(faceCount, detail, &count)) {
+    val::global("RangeError")
+        .new_(std::string(name) + ": detail " + std::to_string(detail) + " exceeds the vertex budget")
+        .throw_();
+  }
+}
+
+val makePolyhedron(val vertices, val indices, float radius, uint32_t detail) {
+  const std::vector<float> v = fromTypedArray<float>(vertices);
+  const std::vector<uint32_t> i = fromTypedArray<uint32_t>(indices);
+  checkPolyhedronSize("makePolyhedron", i.size() / 3, detail);
+  return meshToVal(make_polyhedron(v.data(), v.size() / 3, i.data(), i.size(), radius, detail));
+}
+
+val makeTetrahedron(float radius, uint32_t detail) {
+  checkPolyhedronSize("makeTetrahedron", kTetrahedronFaces, detail);
+  return meshToVal(make_tetrahedron(radius, detail));
+}
+
+val makeOctahedron(float radius, uint32_t detail) {
+  checkPolyhedronSize("makeOctahedron", kOctahedronFaces, detail);
+  return meshToVal(make_octahedron(radius, detail));
+}
+
+val makeIcosahedron(float radius, uint32_t detail) {
+  checkPolyhedronSize("makeIcosahedron", kIcosahedronFaces, detail);
+  return meshToVal(make_icosahedron(radius, detail));
+}
+
+val makeDodecahedron(float radius, uint32_t detail) {
+  checkPolyhedronSize("makeDodecahedron", kDodecahedronFaces, detail);
+  return meshToVal(make_dodecahedron(radius, detail));
+}
+
+val triangulate(val points, val holeStarts) {
+  const std::vector<float> p = fromTypedArray<float>(points);
+  const std::vector<uint32_t> h = fromOptionalTypedArray<uint32_t>(holeStarts);
+  return toUint32Array(triangulate_polygon(p.data(), p.size() / 2, h.data(), h.size()));
+}
+
+val makeShape(val points, val holeStarts) {
+  const std::vector<float> p = fromTypedArray<float>(points);
+  const std::vector<uint32_t> h = fromOptionalTypedArray<uint32_t>(holeStarts);
+  return meshToVal(make_shape(p.data(), p.size() / 2, h.data(), h.size()));
+}
+
+val makeExtrude(val points, val holeStarts, val options) {
+  const std::vector<float> p = fromTypedArray<float>(points);
+  const std::vector<uint32_t> h = fromOptionalTypedArray<uint32_t>(holeStarts);
+
+  ExtrudeOptions o;
+  if (!options.isUndefined() && !options.isNull()) {
+    // Read as doubles so out-of-range values are rejected, as in the N-API
+    // binding, instead of wrapping in the uint32 conversion.
+    const double steps = optionalNumber<double>(options, "steps", o.steps);
+    const double bevelSegments = optionalNumber<double>(options, "bevelSegments", o.bevelSegments);
+    if (!(steps >= 1.0) || !(bevelSegments >= 0.0)) {
+      throwTypeError("makeExtrude(points: Float32Array, holeStarts?: Uint32Array, options?: ExtrudeOptions)");
+    }
+    if (steps > kMaxExtrudeSegments || bevelSegments > kMaxExtrudeSegments) {
+      val::global("RangeError")
+          .new_("makeExtrude: steps and bevelSegments must be at most " + std::to_string(kMaxExtrudeSegments))
+          .throw_();
+    }
+    o.steps = (uint32_t)steps;
+    o.depth = optionalNumber<float>(options, "depth", o.depth);
+    o.bevelEnabled = optionalNumber<bool>(options, "bevelEnabled", o.bevelEnabled);
+    o.bevelThickness = optionalNumber<float>(options, "bevelThickness", o.bevelThickness);
+    // Three defaults bevelSize to bevelThickness - 0.1.
+    o.bevelSize = optionalNumber<float>(options, "bevelSize", o.bevelThickness - 0.1f);
+    o.bevelOffset = optionalNumber<float>(options, "bevelOffset", o.bevelOffset);
+    o.bevelSegments = (uint32_t)bevelSegments;
+  }
+
+  return meshToVal(make_extrude(p.data(), p.size() / 2, h.data(), h.size(), o));
+}
+
+val edgesGeometry(val positions, val indices, float thresholdAngle) {
+  const std::vector<float> p = fromTypedArray<float>(positions);
+  const std::vector<uint32_t> i = fromOptionalTypedArray<uint32_t>(indices);
+  return toFloat32Array(edges_geometry(p.data(), p.size() / 3, i.data(), i.size(), thresholdAngle));
+}
+
+val wireframeIndices(val positions, val indices) {
+  const std::vector<float> p = fromTypedArray<float>(positions);
+  const std::vector<uint32_t> i = fromOptionalTypedArray<uint32_t>(indices);
+  return toUint32Array(wireframe_indices(p.data(), p.size() / 3, i.data(), i.size()));
+}
+
+val quatMultiplyBatch(val a, val b, val out) {
+  std::vector<float> qa = fromTypedArray<float>(a);
+  std::vector<float> qb = fromTypedArray<float>(b);
+  if (qa.size() != qb.size() || qa.size() % 4 != 0) {
+    throwTypeError("quatMultiplyBatch(a, b, out?) expects equal-length planar xyzw Float32Arrays");
+  }
+
+  const size_t count = qa.size() / 4;
+  const QuatSoA result = quat_soa_planar(qa.data(), count);
+  quat_multiply_batch(result, quat_soa_planar(qb.data(), count), result, count);
+  return toOutputFloat32Array(qa, out);
+}
+
+static void eulerAxes(val axes, const char* usage, int* out) {
+  const std::vector<float> a = fromTypedArray<float>(axes);
+  if (a.size() != 3) {
+    throwTypeError(usage);
+  }
+  for (int k = 0; k < 3; k++) {
+    if (a[k] != 0.0f && a[k] != 1.0f && a[k] != 2.0f) {
+      throwTypeError(usage);
+    }
+    out[k] = (int)a[k];
+  }
+  if (out[1] == out[0] || out[1] == out[2]) {
+    throwTypeError(usage);
+  }
+}
+
+val quatToEulerBatch(val quats, val axes, val out) {
+  const char* usage = "quatToEulerBatch(quats, axes, out?) expects planar xyzw Float32Array and axes like [2, 0, 2]";
+  const std::vector<float> q = fromTypedArray<float>(quats);
+  int a[3];
+  eulerAxes(axes, usage, a);
+  if (q.size() % 4 != 0) {
+    throwTypeError(usage);
+  }
+
+  const size_t count = q.size() / 4;
+  std::vector<float> e(count * 3);
+  quat_to_euler_batch(a[0], a[1], a[2], quat_soa_planar(q.data(), count), euler_soa_planar(e.data(), count), count);
+  return toOutputFloat32Array(e, out);
+}
+
+val eulerToQuatBatch(val angles, val axes, val out) {
+  const char* usage = "eulerToQuatBatch(angles, axes, out?) expects planar Float32Array angles and axes like [2, 0, 2]";
+  const std::vector<float> e = fromTypedArray<float>(angles);
+  int a[3];
+  eulerAxes(axes, usage, a);
+  if (e.size() % 3 != 0) {
+    throwTypeError(usage);
+  }
+
+  const size_t count = e.size() / 3;
+  std::vector<float> q(count * 4);
+  euler_to_quat_batch(a[0], a[1], a[2], euler_soa_planar(e.data(), count), quat_soa_planar(q.data(), count), count);
+  return toOutputFloat32Array(q, out);
+}
+
+static RotationFormat rotationFormat(const std::string& name, const char* usage) {
+  if (name == "quaternion") {
+    return RotationFormat::Quaternion;
+  }
+  if (name == "angleAxis") {
+    return RotationFormat::AngleAxis;
+  }
+  if (name != "matrix3") {
+    throwTypeError(usage);
+  }
+  return RotationFormat::Matrix3;
+}
+
+val convertRotationBatch(val input, std::string from, std::string to, val out) {
+  const char* usage =
+      "convertRotationBatch(input, from, to, out?) expects a planar Float32Array and formats "
+      "'quaternion' | 'angleAxis' | 'matrix3'";
+  const std::vector<float> in = fromTypedArray<float>(input);
+  const RotationFormat f = rotationFormat(from, usage);
+  const RotationFormat t = rotationFormat(to, usage);
+  if (in.size() % rotation_format_floats(f) != 0) {
+    throwTypeError(usage);
+  }
+
+  const size_t count = in.size() / rotation_format_floats(f);
+  std::vector<float> result(count * rotation_format_floats(t));
+  convert_rotation_batch(f, t, in.data(), result.data(), count);
+  return toOutputFloat32Array(result, out);
+}
+
+val invertAffineBatch(val matrices, std::string kind, val out) {
+  const char* usage =
+      "invertAffineBatch(matrices, kind, out?) expects 16-float column-major matrices and kind "
+      "'isometry' | 'uniformScale' | 'general'";
+  std::vector<float> m = fromTypedArray<float>(matrices);
+  AffineKind k = AffineKind::General;
+  if (kind == "isometry") {
+    k = AffineKind::Isometry;
+  } else if (kind == "uniformScale") {
+    k = AffineKind::UniformScale;
+  } else if (kind != "general") {
+    throwTypeError(usage);
+  }
+  if (m.size() % 16 != 0) {
+    throwTypeError(usage);
+  }
+
+  invert_affine_batch(k, m.data(), m.data(), m.size() / 16);
+  return toOutputFloat32Array(m, out);
+}
+
+template <typename UniformFn, typename PerElementFn>
+static val quatInterpolateBatch(
+    const char* usage,
+    val a,
+    val b,
+    val t,
+    val out,
+    UniformFn uniform,
+    PerElementFn perElement) {
+  std::vector<float> qa = fromTypedArray<float>(a);
+  const std::vector<float> qb = fromTypedArray<float>(b);
+  if (qa.size() != qb.size() || qa.size() % 4 != 0) {
+    throwTypeError(usage);
+  }
+
+  const size_t count = qa.size() / 4;
+  const QuatSoA result = quat_soa_planar(qa.data(), count);
+  const ConstQuatSoA other = quat_soa_planar(qb.data(), count);
+  if (t.isNumber()) {
+    uniform(result, other, t.as<float>(), result, count);
+  } else {
+    const std::vector<float> weights = fromTypedArray<float>(t);
+    if (weights.size() != count) {
+      throwTypeError(usage);
+    }
+    perElement(result, other, weights.data(), result, count);
+  }
+  return toOutputFloat32Array(qa, out);
+}
+
+val quatSlerpBatch(val a, val b, val t, val out) {
+  return quatInterpolateBatch(
+      "quatSlerpBatch(a, b, t: number | Float32Array, out?) expects equal-length planar xyzw Float32Arrays",
+      a,
+      b,
+      t,
+      out,
+      [](ConstQuatSoA a, ConstQuatSoA b, float t, QuatSoA out, size_t n) { quat_slerp_batch(a, b, t, out, n); },
+      [](ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t n) { quat_slerp_batch(a, b, t, out, n); });
+}
+
+val quatNlerpBatch(val a, val b, val t, val out) {
+  return quatInterpolateBatch(
+      "quatNlerpBatch(a, b, t: number | Float32Array, out?) expects equal-length planar xyzw Float32Arrays",
+      a,
+      b,
+      t,
+      out,
+      [](ConstQuatSoA a, ConstQuatSoA b, float t, QuatSoA out, size_t n) { quat_nlerp_batch(a, b, t, out, n); },
+      [](ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t n) { quat_nlerp_batch(a, b, t, out, n); });
+}
+
+// Runs `fn(data, length)` on a Float32Array in place. Arrays that are views into
+// the module's own heap (allocated via _malloc and HEAPF32) are used directly;
+// anything else is copied in and the result written back.
+template <typename Fn>
+static void withFloat32ArrayInPlace(const val& array, Fn fn) {
+  const val heap = val::module_property("HEAPF32");
+  if (array["buffer"].strictlyEquals(heap["buffer"])) {
+    float* data = reinterpret_cast<float*>(array["byteOffset"].as<uintptr_t>());
+    fn(data, array["length"].as<size_t>());
+    return;
+  }
+  std::vector<float> copy = fromTypedArray<float>(array);
+  fn(copy.data(), copy.size());
+  array.call<void>("set", typed_memory_view(copy.size(), copy.data()));
+}
+
+void transformMesh(val vertices, val normals, val matrix) {
+  const std::vector<float> m = fromTypedArray<float>(matrix);
+  if (m.size() != 16) {
+    throwTypeError("transformMesh(vertices: Float32Array, normals: Float32Array | null, matrix: 16 numbers)");
+  }
+
+  withFloat32ArrayInPlace(vertices, [&](float* data, size_t length) { transform_points(data, length / 3, m.data()); });
+  if (!normals.isUndefined() && !normals.isNull()) {
+    float normalMatrix[9];
+    normal_matrix(m.data(), normalMatrix);
+    withFloat32ArrayInPlace(normals, [&](float* data, size_t length) {
+      transform_normals(data, length / 3, normalMatrix);
+    });
+  }
+}
+
+// A typed array's elements as a native pointer, following withFloat32ArrayInPlace:
+// views into the module heap are used directly, anything else is copied in and,
+// for outputs, written back by writeBack().
+template <typename T>
+struct HeapArray {
+  std::vector<T> copy;
+  T* data = nullptr;
+  size_t length = 0;
+
+  explicit HeapArray(const val& array) {
+    if (array["buffer"].strictlyEquals(val::module_property("HEAPF32")["buffer"])) {
+      data = reinterpret_cast<T*>(array["byteOffset"].as<uintptr_t>());
+      length = array["length"].as<size_t>();
+    } else {
+      copy = fromTypedArray<T>(array);
+      data = copy.data();
+      length = copy.size();
+    }
+  }
+
+  void writeBack(const val& array) const {
+    if (!copy.empty()) {
+      array.call<void>("set", typed_memory_view(copy.size(), copy.data()));
+    }
+  }
+};
+
+// Shared argument handling for skinLbs/skinDqs; skin(in, boneMatrices, boneCount,
+// outPositions, outNormals) runs the kernel.
+template <typename Skin>
+void skinVertices(const char* name, Skin skin, val positions, val normals, val skinIndex, val skinWeight,
+                  val boneMatrices, val outPositions, val outNormals) {
+  const std::string usage =
+      std::string(name) +
+      "(positions, normals, skinIndex, skinWeight, boneMatrices, outPositions, outNormals) expects xyz "
+      "Float32Arrays (normals may be null), 4 Uint16 indices and 4 Float32 weights per vertex, 16 floats per bone "
+      "and outputs the size of the inputs";
+  const bool withNormals = !normals.isUndefined() && !normals.isNull();
+  const HeapArray<float> p(positions);
+  const HeapArray<uint16_t> indices(skinIndex);
+  const HeapArray<float> weights(skinWeight);
+  const HeapArray<float> bones(boneMatrices);
+  HeapArray<float> outP(outPositions);
+  const size_t vertexCount = p.length / 3;
+  if (p.length % 3 != 0 || indices.length != vertexCount * 4 || weights.length != vertexCount * 4 ||
+      bones.length % 16 != 0 || outP.length != p.length) {
+    throwTypeError(usage.c_str());
+  }
+  if (!skin_indices_valid(indices.data, vertexCount, bones.length / 16)) {
+    val::global("RangeError").new_(std::string(name) + ": bone index out of range").throw_();
+  }
+
+  if (!withNormals) {
+    skin(SkinningInput{p.data, nullptr, indices.data, weights.data, vertexCount}, bones.data, bones.length / 16,
+         outP.data, nullptr);
+    outP.writeBack(outPositions);
+    return;
+  }
+  const HeapArray<float> n(normals);
+  HeapArray<float> outN(outNormals);
+  if (n.length != p.length || outN.length != p.length) {
+    throwTypeError(usage.c_str());
+  }
+  skin(SkinningInput{p.data, n.data, indices.data, weights.data, vertexCount}, bones.data, bones.length / 16,
+       outP.data, outN.data);
+  outP.writeBack(outPositions);
+  outN.writeBack(outNormals);
+}
+
+void skinLbs(val positions, val normals, val skinIndex, val skinWeight, val boneMatrices, val outPositions,
+             val outNormals) {
+  skinVertices(
+      "skinLbs",
+      [](const SkinningInput& in, const float* bones, size_t, float* outP, float* outN) {
+        skin_lbs(in, bones, outP, outN);
+      },
+      positions, normals, skinIndex, skinWeight, boneMatrices, outPositions, outNormals);
+}
+
+void skinDqs(val positions, val normals, val skinIndex, val skinWeight, val boneMatrices, val outPositions,
+             val outNormals) {
+  skinVertices(
+      "skinDqs",
+      [](const SkinningInput& in, const float* bones, size_t boneCount, float* outP, float* outN) {
+        std::vector<float> dualQuats(boneCount * kDualQuatFloats);
+        dual_quats_from_transforms(bones, boneCount, dualQuats.data());
+        skin_dqs(in, dualQuats.data(), outP, outN);
+      },
+      positions, normals, skinIndex, skinWeight, boneMatrices, outPositions, outNormals);
+}
+
+val transformBoxes(val boxes, val matrices, val out) {
+  std::vector<float> b = fromTypedArray<float>(boxes);
+  const std::vector<float> m = fromTypedArray<float>(matrices);
+  if (b.size() % 6 != 0 || m.size() != b.size() / 6 * 16) {
+    throwTypeError("transformBoxes(boxes, matrices, out?) expects planar min/max boxes and one 16-float matrix per box");
+  }
+
+  const size_t count = b.size() / 6;
+  const BoxSoA result = box_soa_planar(b.data(), count);
+  transform_boxes(result, m.data(), result, count);
+  return toOutputFloat32Array(b, out);
+}
+
+val frustumPlanes(val matrix) {
+  const std::vector<float> m = fromTypedArray<float>(matrix);
+  if (m.size() != 16) {
+    throwTypeError("frustumPlanes(projectionView: 16 numbers)");
+  }
+
+  const Frustum frustum = frustum_from_matrix(m.data());
+  std::vector<float> planes(24);
+  for (size_t p = 0; p < 6; p++) {
+    Eigen::Map<Eigen::Vector4f>(planes.data() + p * 4) = frustum.planes[p].coeffs();
+  }
+  return toFloat32Array(planes);
+}
+
+val cullBoxes(val planes, val boxes, val out) {
+  const std::vector<float> p = fromTypedArray<float>(planes);
+  const std::vector<float> b = fromTypedArray<float>(boxes);
+  if (p.size() != 24 || b.size() % 6 != 0) {
+    throwTypeError("cullBoxes(planes: Float32Array(24), boxes, out?) expects planar min/max boxes");
+  }
+
+  Frustum frustum;
+  for (size_t i = 0; i < 6; i++) {
+    frustum.planes[i].coeffs() = Eigen::Map<const Eigen::Vector4f>(p.data() + i * 4);
+  }
+  const size_t count = b.size() / 6;
+  std::vector<uint32_t> visible(cull_mask_words(count));
+  cull_boxes(frustum, box_soa_planar(b.data(), count), count, visible.data());
+
+  if (out.isUndefined() || out.isNull()) {
+    return toUint32Array(visible);
+  }
+  out.call<void>("set", typed_memory_view(visible.size(), visible.data()));
+  return out;
+}
+
+static Eigen::Vector3f toVector3(const val& v, const char* usage) {
+  const std::vector<float> f = fromTypedArray<float>(v);
+  if (f.size() != 3) {
+    throwTypeError(usage);
+  }
+  return Eigen::Vector3f(f[0], f[1], f[2]);
+}
+
+static val hitToVal(uint32_t index, float distance, bool found) {
+  if (!found) {
+    return val::null();
+  }
+  val out = val::object();
+  out.set("index", index);
+  out.set("distance", distance);
+  return out;
+}
+
+static std::vector<float> planarBoxes(const val& boxes) {
+  std::vector<float> b = fromTypedArray<float>(boxes);
+  if (b.size() % 6 != 0) {
+    throwTypeError("expected planar min/max boxes: Float32Array of 6 * count floats");
+  }
+  return b;
+}
+
+// JS-facing BoxBvh: same methods as the N-API class. Embind objects must be
+// released with delete(); the TS backend maps dispose() onto it.
+class WasmBoxBvh {
+ public:
+  WasmBoxBvh(val boxes, std::string builder) {
+    const std::vector<float> b = planarBoxes(boxes);
+    if (builder == "lbvh") {
+      bvh_ = build_lbvh(box_soa_planar(b.data(), b.size() / 6), b.size() / 6);
+    } else if (builder == "sah") {
+      bvh_.build(box_soa_planar(b.data(), b.size() / 6), b.size() / 6);
+    } else {
+      throwTypeError("BoxBvh builder must be 'sah' or 'lbvh'");
+    }
+  }
+
+  uint32_t size() const { return (uint32_t)bvh_.size(); }
+
+  void refit(val boxes) {
+    const std::vector<float> b = planarBoxes(boxes);
+    if (b.size() / 6 != bvh_.size()) {
+      throwTypeError("refit(boxes) expects as many planar min/max boxes as the BVH was built with");
+    }
+    bvh_.refit(box_soa_planar(b.data(), b.size() / 6));
+  }
+
+  val raycast(val origin, val direction, float maxDistance) const {
+    const char* usage = "raycast(origin: 3 numbers, direction: 3 numbers, maxDistance: number)";
+    const BoxBvh::Hit hit = bvh_.raycast(
+        Eigen::ParametrizedLine<float, 3>(toVector3(origin, usage), toVector3(direction, usage)), maxDistance);
+    return hitToVal(hit.index, hit.distance, (bool)hit);
+  }
+
+  val overlap(val min, val max) const {
+    const char* usage = "overlap(min: 3 numbers, max: 3 numbers)";
+    std::vector<uint32_t> hits;
+    bvh_.overlap(Eigen::AlignedBox3f(toVector3(min, usage), toVector3(max, usage)), hits);
+    return toUint32Array(hits);
+  }
+
+  val nearest(val point, float maxDistance) const {
+    const BoxBvh::Hit hit = bvh_.nearest(toVector3(point, "nearest(point: 3 numbers, maxDistance: number)"), maxDistance);
+    return hitToVal(hit.index, hit.distance, (bool)hit);
+  }
+
+ private:
+  BoxBvh bvh_;
+};
+
+static val meshHitToVal(const MeshBvh::Hit& hit) {
+  if (!hit) {
+    return val::null();
+  }
+  val out = val::object();
+  out.set("triangle", hit.triangle);
+  out.set("distance", hit.distance);
+  out.set("u", hit.u);
+  out.set("v", hit.v);
+  out.set("materialIndex", hit.materialIndex);
+  return out;
+}
+
+class WasmMeshBvh {
+ public:
+  explicit WasmMeshBvh(val mesh) {
+    const std::vector<float> vertices = fromTypedArray<float>(mesh["vertices"]);
+    const std::vector<uint32_t> indices = fromOptionalTypedArray<uint32_t>(mesh["indices"]);
+    std::vector<MeshDataCpp::Group> groups;
+    const val g = mesh["groups"];
+    if (!g.isUndefined() && !g.isNull()) {
+      const uint32_t groupCount = g["length"].as<uint32_t>();
+      for (uint32_t i = 0; i < groupCount; i++) {
+        const val group = g[i];
+        groups.push_back(MeshDataCpp::Group{
+            group["start"].as<uint32_t>(), group["count"].as<uint32_t>(), optionalNumber<uint32_t>(group, "materialIndex", 0)});
+      }
+    }
+    bvh_ = MeshBvh(vertices.data(), vertices.size() / 3, indices.data(), indices.size(), groups.data(), groups.size());
+  }
+
+  uint32_t triangleCount() const { return (uint32_t)bvh_.triangle_count(); }
+
+  val raycast(val origin, val direction, float maxDistance) const {
+    const char* usage = "raycast(origin: 3 numbers, direction: 3 numbers, maxDistance: number)";
+    return meshHitToVal(bvh_.raycast(
+        Eigen::ParametrizedLine<float, 3>(toVector3(origin, usage), toVector3(direction, usage)), maxDistance));
+  }
+
+  val raycastBatch(val rays, float maxDistance) const {
+    const std::vector<float> r = fromTypedArray<float>(rays);
+    if (r.size() % 6 != 0) {
+      throwTypeError("raycastBatch(rays: planar [ox, oy, oz, dx, dy, dz] Float32Array, maxDistance: number)");
+    }
+    const size_t count = r.size() / 6;
+    std::vector<MeshBvh::Hit> hits(count);
+    bvh_.raycast_batch(ray_soa_planar(r.data(), count), count, maxDistance, hits.data());
+
+    std::vector<uint32_t> triangle(count), material(count);
+    std::vector<float> distance(count), u(count), v(count);
+    for (size_t i = 0; i < count; i++) {
+      triangle[i] = hits[i].triangle;
+      distance[i] = hits[i].distance;
+      u[i] = hits[i].u;
+      v[i] = hits[i].v;
+      material[i] = hits[i].materialIndex;
+    }
+    val out = val::object();
+    out.set("triangle", toUint32Array(triangle));
+    out.set("distance", toFloat32Array(distance));
+    out.set("u", toFloat32Array(u));
+    out.set("v", toFloat32Array(v));
+    out.set("materialIndex", toUint32Array(material));
+    return out;
+  }
+
+ private:
+  MeshBvh bvh_;
+};
+
+class WasmSweepAndPrune {
+ public:
+  explicit WasmSweepAndPrune(int axis) : sap_(axis) {
+    if (axis < 0 || axis > 2) {
+      throwTypeError("SweepAndPrune(axis: 0 | 1 | 2)");
+    }
+  }
+
+  uint32_t size() const { return (uint32_t)sap_.size(); }
+
+  val update(val boxes) {
+    const std::vector<float> b = planarBoxes(boxes);
+    std::vector<SweepAndPrune::Pair> added, removed;
+    sap_.update(box_soa_planar(b.data(), b.size() / 6), b.size() / 6, added, removed);
+
+    std::vector<uint32_t> out{(uint32_t)added.size(), (uint32_t)removed.size()};
+    for (const std::vector<SweepAndPrune::Pair>* list : {&added, &removed}) {
+      for (const SweepAndPrune::Pair& p : *list) {
+        out.push_back(p.a);
+        out.push_back(p.b);
+      }
+    }
+    return toUint32Array(out);
+  }
+
+  val pairs() const {
+    std::vector<uint32_t> out;
+    out.reserve(sap_.pairs().size() * 2);
+    for (const SweepAndPrune::Pair& p : sap_.pairs()) {
+      out.push_back(p.a);
+      out.push_back(p.b);
+    }
+    return toUint32Array(out);
+  }
+
+ private:
+  SweepAndPrune sap_;
+};
+
+class WasmPointGrid {
+ public:
+  WasmPointGrid(val points, float cellSize) {
+    const std::vector<float> p = fromTypedArray<float>(points);
+    if (p.size() % 3 != 0 || !(cellSize > 0.0f)) {
+      throwTypeError("PointGrid(points: Float32Array of xyz, cellSize: number > 0)");
+    }
+    grid_ = PointGrid(p.data(), p.size() / 3, cellSize);
+  }
+
+  uint32_t size() const { return (uint32_t)grid_.size(); }
+
+  val radius(val center, float radius) const {
+    std::vector<uint32_t> hits;
+    grid_.radius(toVector3(center, "radius(center: 3 numbers, radius: number)"), radius, hits);
+    return toUint32Array(hits);
+  }
+
+  val nearest(val center, uint32_t k, float maxDistance) const {
+    std::vector<PointGrid::Neighbor> neighbors;
+    grid_.nearest(
+        toVector3(center, "nearest(center: 3 numbers, k: number, maxDistance: number)"),
+        std::min<size_t>(k, grid_.size()),
+        maxDistance,
+        neighbors);
+    std::vector<uint32_t> index(neighbors.size());
+    std::vector<float> distance(neighbors.size());
+    for (size_t i = 0; i < neighbors.size(); i++) {
+      index[i] = neighbors[i].index;
+      distance[i] = neighbors[i].distance;
+    }
+    val out = val::object();
+    out.set("index", toUint32Array(index));
+    out.set("distance", toFloat32Array(distance));
+    return out;
+  }
+
+ private:
+  PointGrid grid_;
+};
+
+class WasmUmeyamaAccumulator {
+ public:
+  double count() const { return (double)acc_.count(); }
+
+  void add(val src, val dst) {
+    const std::vector<float> s = fromTypedArray<float>(src);
+    const std::vector<float> d = fromTypedArray<float>(dst);
+    if (s.size() != d.size() || s.size() % 3 != 0) {
+      throwTypeError("add(src: Float32Array, dst: Float32Array) with equal xyz lengths");
+    }
+    acc_.add(s.data(), d.data(), s.size() / 3);
+  }
+
+  void clear() { acc_.clear(); }
+
+  val solve(bool withScaling) const {
+    const Eigen::Matrix4f m = acc_.solve(withScaling).cast<float>();
+    return toFloat32Array(std::vector<float>(m.data(), m.data() + 16));
+  }
+
+ private:
+  UmeyamaAccumulator acc_;
+};
+
+class WasmIcpRegistration {
+ public:
+  explicit WasmIcpRegistration(val target) {
+    const std::vector<float> p = fromTypedArray<float>(target);
+    if (p.size() % 3 != 0) {
+      throwTypeError("IcpRegistration(target: Float32Array of xyz)");
+    }
+    tree_ = KdTree(p.data(), p.size() / 3);
+  }
+
+  uint32_t size() const { return (uint32_t)tree_.size(); }
+
+  val align(val source, val options) const {
+    const std::vector<float> s = fromTypedArray<float>(source);
+    if (s.size() % 3 != 0) {
+      throwTypeError("align(source: Float32Array of xyz, options?: IcpOptions)");
+    }
+
+    IcpOptions o;
+    if (!options.isUndefined() && !options.isNull()) {
+      o.maxIterations = optionalNumber<uint32_t>(options, "maxIterations", o.maxIterations);
+      o.maxDistance = optionalNumber<float>(options, "maxDistance", o.maxDistance);
+      o.inlierFraction = optionalNumber<float>(options, "inlierFraction", o.inlierFraction);
+      o.tolerance = optionalNumber<double>(options, "tolerance", o.tolerance);
+      o.withScaling = optionalNumber<bool>(options, "withScaling", o.withScaling);
+      const val initial = options["initial"];
+      if (!initial.isUndefined()) {
+        const std::vector<float> m = fromTypedArray<float>(initial);
+        if (m.size() != 16) {
+          throwTypeError("IcpOptions.initial must be 16 numbers");
+        }
+        o.initial = Eigen::Map<const Eigen::Matrix4f>(m.data()).cast<double>();
+      }
+      if (!(o.inlierFraction > 0.0f && o.inlierFraction <= 1.0f)) {
+        throwTypeError("IcpOptions.inlierFraction must be in (0, 1]");
+      }
+    }
+
+    const IcpResult fit = icp_align(tree_, s.data(), s.size() / 3, o);
+    const Eigen::Matrix4f m = fit.transform.cast<float>();
+    val iterations = val::array();
+    for (size_t i = 0; i < fit.iterations.size(); i++) {
+      const IcpIteration& it = fit.iterations[i];
+      val entry = val::object();
+      entry.set("pairs", it.pairs);
+      entry.set("rmsError", it.rmsError);
+      entry.set("correspondenceMs", it.correspondenceMs);
+      entry.set("solveMs", it.solveMs);
+      iterations.set(i, entry);
+    }
+    val out = val::object();
+    out.set("matrix", toFloat32Array(std::vector<float>(m.data(), m.data() + 16)));
+    out.set("converged", fit.converged);
+    out.set("iterations", iterations);
+    return out;
+  }
+
+ private:
+  KdTree tree_;
+};
+
+class WasmTransformHierarchy {
+ public:
+  explicit WasmTransformHierarchy(val parents) {
+    const std::vector<int32_t> p = fromTypedArray<int32_t>(parents);
+    if (!TransformHierarchy::is_topological(p.data(), p.size())) {
+      throwTypeError("TransformHierarchy(parents: Int32Array with parents[i] in [0, i) or -1 for roots)");
+    }
+    hierarchy_ = TransformHierarchy(p.data(), p.size());
+    world_.assign(p.size() * 16, 0.0f);
+  }
+
+  uint32_t size() const { return (uint32_t)hierarchy_.size(); }
+
+  // A view into the wasm heap, not a copy: re-read it after the heap grows.
+  val world() const { return val(typed_memory_view(world_.size(), world_.data())); }
+
+  void setLocal(uint32_t index, val trs) {
+    const std::vector<float> t = fromTypedArray<float>(trs);
+    if (index >= hierarchy_.size() || t.size() != TransformHierarchy::kLocalFloats) {
+      throwTypeError("setLocal(index: node index, trs: [tx, ty, tz, qx, qy, qz, qw, sx, sy, sz])");
+    }
+    hierarchy_.set_locals(&index, t.data(), 1);
+  }
+
+  void setLocals(val indices, val trs) {
+    const std::vector<uint32_t> i = fromTypedArray<uint32_t>(indices);
+    const std::vector<float> t = fromTypedArray<float>(trs);
+    bool valid = t.size() == i.size() * TransformHierarchy::kLocalFloats;
+    for (size_t k = 0; valid && k < i.size(); k++) {
+      valid = i[k] < hierarchy_.size();
+    }
+    if (!valid) {
+      throwTypeError("setLocals(indices: Uint32Array of node indices, trs: Float32Array with 10 floats per index)");
+    }
+    hierarchy_.set_locals(i.data(), t.data(), i.size());
+  }
+
+  uint32_t update(bool parallel) { return (uint32_t)hierarchy_.update(world_.data(), parallel); }
+
+ private:
+  TransformHierarchy hierarchy_;
+  std::vector<float> world_;
+};
+
 EMSCRIPTEN_BINDINGS(geometry_wasm) {
   function("makeBox", &makeBox);
+  function("makePlane", &makePlane);
+  function("makeCircle", &makeCircle);
+  function("makeRing", &makeRing);
+  function("makePolyhedron", &makePolyhedron);
+  function("makeTetrahedron", &makeTetrahedron);
+  function("makeOctahedron", &makeOctahedron);
+  function("makeIcosahedron", &makeIcosahedron);
+  function("makeDodecahedron", &makeDodecahedron);
+  function("triangulate", &triangulate);
+  function("makeShape", &makeShape);
+  function("makeExtrude", &makeExtrude);
+  function("edgesGeometry", &edgesGeometry);
+  function("wireframeIndices", &wireframeIndices);
+  function("quatMultiplyBatch", &quatMultiplyBatch);
+  function("quatSlerpBatch", &quatSlerpBatch);
+  function("quatNlerpBatch", &quatNlerpBatch);
+  function("quatToEulerBatch", &quatToEulerBatch);
+  function("eulerToQuatBatch", &eulerToQuatBatch);
+  function("convertRotationBatch", &convertRotationBatch);
+  function("invertAffineBatch", &invertAffineBatch);
+  function("transformMesh", &transformMesh);
+  function("skinLbs", &skinLbs);
+  function("skinDqs", &skinDqs);
+  function("transformBoxes", &transformBoxes);
+  function("frustumPlanes", &frustumPlanes);
+  function("cullBoxes", &cullBoxes);
+
+  class_<WasmBoxBvh>("BoxBvh")
+      .constructor<val, std::string>()
+      .property("size", &WasmBoxBvh::size)
+      .function("refit", &WasmBoxBvh::refit)
+      .function("raycast", &WasmBoxBvh::raycast)
+      .function("overlap", &WasmBoxBvh::overlap)
+      .function("nearest", &WasmBoxBvh::nearest);
+
+  class_<WasmMeshBvh>("MeshBvh")
+      .constructor<val>()
+      .property("triangleCount", &WasmMeshBvh::triangleCount)
+      .function("raycast", &WasmMeshBvh::raycast)
+      .function("raycastBatch", &WasmMeshBvh::raycastBatch);
+
+  class_<WasmSweepAndPrune>("SweepAndPrune")
+      .constructor<int>()
+      .property("size", &WasmSweepAndPrune::size)
+      .function("update", &WasmSweepAndPrune::update)
+      .function("pairs", &WasmSweepAndPrune::pairs);
+
+  class_<WasmPointGrid>("PointGrid")
+      .constructor<val, float>()
+      .property("size", &WasmPointGrid::size)
+      .function("radius", &WasmPointGrid::radius)
+      .function("nearest", &WasmPointGrid::nearest);
+
+  class_<WasmUmeyamaAccumulator>("UmeyamaAccumulator")
+      .constructor<>()
+      .property("count", &WasmUmeyamaAccumulator::count)
+      .function("add", &WasmUmeyamaAccumulator::add)
+      .function("clear", &WasmUmeyamaAccumulator::clear)
+      .function("solve", &WasmUmeyamaAccumulator::solve);
+
+  class_<WasmIcpRegistration>("IcpRegistration")
+      .constructor<val>()
+      .property("size", &WasmIcpRegistration::size)
+      .function("align", &WasmIcpRegistration::align);
+
+  class_<WasmTransformHierarchy>("TransformHierarchy")
+      .constructor<val>()
+      .property("size", &WasmTransformHierarchy::size)
+      .property("world", &WasmTransformHierarchy::world)
+      .function("setLocal", &WasmTransformHierarchy::setLocal)
+      .function("setLocals", &WasmTransformHierarchy::setLocals)
+      .function("update", &WasmTransformHierarchy::update);
 }
@@ -1,15 +1,175 @@
+export type WasmMeshData = {
+  vertices: Float32Array;
+  normals: Float32Array;
+  uvs: Float32Array;
+  indices: Uint32Array;
+  groups: Array<{ start: number; count: number; materialIndex: number }>;
+};
+
+export type WasmExtrudeOptions = {
+  steps?: number;
+  depth?: number;
+  bevelEnabled?: boolean;
+  bevelThickness?: number;
+  bevelSize?: number;
+  bevelOffset?: number;
+  bevelSegments?: number;
+};
+
 export type WasmGeometryModule = {
-  makeBox(
-    w: number,
-    h: number,
-    d: number,
-  ): {
-    vertices: Float32Array;
-    normals: Float32Array;
-    uvs: Float32Array;
-    indices: Uint32Array;
-    groups: Array<{ start: number; count: number; materialIndex: number }>;
-  };
+  makeBox(w: number, h: number, d: number): WasmMeshData;
+  makePlane(width: number, height: number, widthSegments: number, heightSegments: number): WasmMeshData;
+  makeCircle(radius: number, segments: number, thetaStart: number, thetaLength: number): WasmMeshData;
+  makeRing(
+    innerRadius: number,
+    outerRadius: number,
+    thetaSegments: number,
+    phiSegments: number,
+    thetaStart: number,
+    thetaLength: number,
+  ): WasmMeshData;
+  makePolyhedron(vertices: Float32Array, indices: Uint32Array, radius: number, detail: number): WasmMeshData;
+  makeTetrahedron(radius: number, detail: number): WasmMeshData;
+  makeOctahedron(radius: number, detail: number): WasmMeshData;
+  makeIcosahedron(radius: number, detail: number): WasmMeshData;
+  makeDodecahedron(radius: number, detail: number): WasmMeshData;
+  triangulate(points: Float32Array, holeStarts?: Uint32Array): Uint32Array;
+  makeShape(points: Float32Array, holeStarts?: Uint32Array): WasmMeshData;
+  makeExtrude(points: Float32Array, holeStarts?: Uint32Array, options?: WasmExtrudeOptions): WasmMeshData;
+  edgesGeometry(positions: Float32Array, indices: Uint32Array | null, thresholdAngle: number): Float32Array;
+  wireframeIndices(positions: Float32Array, indices: Uint32Array | null): Uint32Array;
+  quatMultiplyBatch(a: Float32Array, b: Float32Array, out: Float32Array | null): Float32Array;
+  quatSlerpBatch(a: Float32Array, b: Float32Array, t: number | Float32Array, out: Float32Array | null): Float32Array;
+  quatNlerpBatch(a: Float32Array, b: Float32Array, t: number | Float32Array, out: Float32Array | null): Float32Array;
+  quatToEulerBatch(quats: Float32Array, axes: ArrayLike<number>, out: Float32Array | null): Float32Array;
+  eulerToQuatBatch(angles: Float32Array, axes: ArrayLike<number>, out: Float32Array | null): Float32Array;
+  convertRotationBatch(
+    input: Float32Array,
+    from: 'quaternion' | 'angleAxis' | 'matrix3',
+    to: 'quaternion' | 'angleAxis' | 'matrix3',
+    out: Float32Array | null,
+  ): Float32Array;
+  invertAffineBatch(
+    matrices: Float32Array,
+    kind: 'isometry' | 'uniformScale' | 'general',
+    out: Float32Array | null,
+  ): Float32Array;
+  // In place; views into HEAPF32 are transformed without copying.
+  transformMesh(vertices: Float32Array, normals: Float32Array | null, matrix: ArrayLike<number>): void;
+  // Writes into the outputs; views into HEAPF32's buffer are used without copying.
+  skinLbs(
+    positions: Float32Array,
+    normals: Float32Array | null,
+    skinIndex: Uint16Array,
+    skinWeight: Float32Array,
+    boneMatrices: Float32Array,
+    outPositions: Float32Array,
+    outNormals: Float32Array | null,
+  ): void;
+  skinDqs(
+    positions: Float32Array,
+    normals: Float32Array | null,
+    skinIndex: Uint16Array,
+    skinWeight: Float32Array,
+    boneMatrices: Float32Array,
+    outPositions: Float32Array,
+    outNormals: Float32Array | null,
+  ): void;
+  transformBoxes(boxes: Float32Array, matrices: Float32Array, out: Float32Array | null): Float32Array;
+  frustumPlanes(projectionView: ArrayLike<number>): Float32Array;
+  cullBoxes(planes: Float32Array, boxes: Float32Array, out: Uint32Array | null): Uint32Array;
+  BoxBvh: new (boxes: Float32Array, builder: 'sah' | 'lbvh') => WasmBoxBvh;
+  MeshBvh: new (mesh: WasmMeshData) => WasmMeshBvh;
+  SweepAndPrune: new (axis: number) => WasmSweepAndPrune;
+  PointGrid: new (points: Float32Array, cellSize: number) => WasmPointGrid;
+  UmeyamaAccumulator: new () => WasmUmeyamaAccumulator;
+  IcpRegistration: new (target: Float32Array) => WasmIcpRegistration;
+  TransformHierarchy: new (parents: Int32Array) => WasmTransformHierarchy;
+};
+
+// Embind handle: free with delete().
+export type WasmBoxBvh = {
+  readonly size: number;
+  refit(boxes: Float32Array): void;
+  raycast(
+    origin: ArrayLike<number>,
+    direction: ArrayLike<number>,
+    maxDistance: number,
+  ): { index: number; distance: number } | null;
+  overlap(min: ArrayLike<number>, max: ArrayLike<number>): Uint32Array;
+  nearest(point: ArrayLike<number>, maxDistance: number): { index: number; distance: number } | null;
+  delete(): void;
 };
 
 export function initWasm(): Promise<WasmGeometryModule>;
+
+export type WasmMeshHit = { triangle: number; distance: number; u: number; v: number; materialIndex: number };
+
+// Embind handle: free with delete().
+export type WasmMeshBvh = {
+  readonly triangleCount: number;
+  raycast(origin: ArrayLike<number>, direction: ArrayLike<number>, maxDistance: number): WasmMeshHit | null;
+  raycastBatch(
+    rays: Float32Array,
+    maxDistance: number,
+  ): { triangle: Uint32Array; distance: Float32Array; u: Float32Array; v: Float32Array; materialIndex: Uint32Array };
+  delete(): void;
+};
+
+// Embind handle: free with delete().
+export type WasmSweepAndPrune = {
+  readonly size: number;
+  update(boxes: Float32Array): Uint32Array;
+  pairs(): Uint32Array;
+  delete(): void;
+};
+
+// Embind handle: free with delete().
+export type WasmPointGrid = {
+  readonly size: number;
+  radius(center: ArrayLike<number>, radius: number): Uint32Array;
+  nearest(center: ArrayLike<number>, k: number, maxDistance: number): { index: Uint32Array; distance: Float32Array };
+  delete(): void;
+};
+
+// Embind handle: free with delete().
+export type WasmUmeyamaAccumulator = {
+  readonly count: number;
+  add(src: Float32Array, dst: Float32Array): void;
+  clear(): void;
+  solve(withScaling: boolean): Float32Array;
+  delete(): void;
+};
+
+export type WasmIcpOptions = {
+  maxIterations?: number;
+  maxDistance?: number;
+  inlierFraction?: number;
+  tolerance?: number;
+  withScaling?: boolean;
+  initial?: ArrayLike<number>;
+};
+
+export type WasmIcpResult = {
+  matrix: Float32Array;
+  converged: boolean;
+  iterations: Array<{ pairs: number; rmsError: number; correspondenceMs: number; solveMs: number }>;
+};
+
+// Embind handle: free with delete().
+export type WasmIcpRegistration = {
+  readonly size: number;
+  align(source: Float32Array, options: WasmIcpOptions | undefined): WasmIcpResult;
+  delete(): void;
+};
+
+// Embind handle: free with delete(). `world` is a view into the wasm heap; re-read
+// it after anything that may grow the heap.
+export type WasmTransformHierarchy = {
+  readonly size: number;
+  readonly world: Float32Array;
+  setLocal(index: number, trs: ArrayLike<number>): void;
+  setLocals(indices: Uint32Array, trs: Float32Array): void;
+  update(parallel: boolean): number;
+  delete(): void;
+};